@@ -113,7 +113,7 @@ static constexpr u32 VersionFromRevision(u32_le rev) {
     return ((rev >> 24) & 0xff) - 0x30;
 }
 
-std::vector<u8> AudioRenderer::UpdateAudioRenderer(const std::vector<u8>& input_params) {
+std::vector<u8> AudioRenderer::UpdateAudioRenderer(Common::Span<const u8> input_params) {
     // Copy UpdateDataHeader struct
     UpdateDataHeader config{};
     std::memcpy(&config, input_params.data(), sizeof(UpdateDataHeader));
@@ -11,6 +11,7 @@
 #include "audio_core/stream.h"
 #include "common/common_funcs.h"
 #include "common/common_types.h"
+#include "common/span.h"
 #include "common/swap.h"
 #include "core/hle/kernel/object.h"
 
@@ -226,7 +227,7 @@ public:
                   std::shared_ptr<Kernel::WritableEvent> buffer_event, std::size_t instance_number);
     ~AudioRenderer();
 
-    std::vector<u8> UpdateAudioRenderer(const std::vector<u8>& input_params);
+    std::vector<u8> UpdateAudioRenderer(Common::Span<const u8> input_params);
     void QueueMixedBuffer(Buffer::Tag tag);
     void ReleaseAndQueueBuffers();
     u32 GetSampleRate() const;
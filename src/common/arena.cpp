@@ -0,0 +1,69 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstdint>
+
+#include "common/arena.h"
+#include "common/assert.h"
+
+namespace Common {
+
+Arena::Arena(std::size_t initial_size) {
+    AddBlock(std::max<std::size_t>(initial_size, 1));
+}
+
+Arena::~Arena() {
+    ASSERT_MSG(live_allocations == 0, "Arena destroyed with {} live allocations",
+               live_allocations);
+}
+
+void* Arena::Allocate(std::size_t size, std::size_t alignment) {
+    DEBUG_ASSERT((alignment & (alignment - 1)) == 0);
+
+    while (true) {
+        Block& block = blocks[current_block];
+        const auto base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+        const std::uintptr_t start = (base + offset + alignment - 1) & ~(alignment - 1);
+        const std::size_t end = static_cast<std::size_t>(start - base) + size;
+        if (end <= block.size) {
+            offset = end;
+            ++live_allocations;
+            return reinterpret_cast<void*>(start);
+        }
+        if (current_block + 1 == blocks.size()) {
+            AddBlock(std::max(block.size * 2, size + alignment));
+        }
+        ++current_block;
+        offset = 0;
+    }
+}
+
+void Arena::Deallocate([[maybe_unused]] void* pointer, [[maybe_unused]] std::size_t size) {
+    ASSERT(live_allocations != 0);
+    --live_allocations;
+}
+
+bool Arena::Reset() {
+    if (live_allocations != 0) {
+        return false;
+    }
+    if (blocks.size() > 1) {
+        // The last round needed more than the first block, keep a single block fitting it all.
+        blocks.clear();
+        const std::size_t total = capacity;
+        capacity = 0;
+        AddBlock(total);
+    }
+    current_block = 0;
+    offset = 0;
+    return true;
+}
+
+void Arena::AddBlock(std::size_t size) {
+    blocks.push_back({std::make_unique<std::byte[]>(size), size});
+    capacity += size;
+}
+
+} // namespace Common
@@ -0,0 +1,133 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Common {
+
+/**
+ * Bump-pointer allocator for short-lived objects that die together. Deallocation only counts the
+ * live allocations, memory is reclaimed all at once by Reset when none is left.
+ *
+ * The arena keeps its memory across resets. When a round did not fit in the first block, the
+ * blocks are merged into a single one large enough for it on the next reset, so that steady-state
+ * rounds do not allocate from the heap at all.
+ *
+ * Not thread-safe, callers have to serialize access.
+ */
+class Arena {
+public:
+    explicit Arena(std::size_t initial_size = 0x1000);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    Arena(Arena&&) = delete;
+    Arena& operator=(Arena&&) = delete;
+
+    /// Allocates size bytes aligned to alignment, which must be a power of two.
+    void* Allocate(std::size_t size, std::size_t alignment);
+
+    /// Releases an allocation. Its memory is only reused once the arena is reset.
+    void Deallocate(void* pointer, std::size_t size);
+
+    /// Rewinds the arena, returns false and does nothing if some allocation is still alive.
+    bool Reset();
+
+    /// Returns the number of allocations that have not been released yet.
+    std::size_t LiveAllocations() const {
+        return live_allocations;
+    }
+
+    /// Returns the number of bytes reserved from the heap.
+    std::size_t Capacity() const {
+        return capacity;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t size;
+    };
+
+    void AddBlock(std::size_t size);
+
+    std::vector<Block> blocks;
+    std::size_t current_block = 0;
+    std::size_t offset = 0;
+    std::size_t capacity = 0;
+    std::size_t live_allocations = 0;
+};
+
+/**
+ * Standard allocator drawing from an Arena, or from the heap when it has none.
+ *
+ * Copies of containers using it are heap backed, so that copying request-scoped data to keep it
+ * for later does not tie the copy to the lifetime of the arena. Containers keep their allocator
+ * on assignment and swaps, swapping containers with different arenas is not supported.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(Arena* arena) noexcept : arena{arena} {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena{other.GetArena()} {}
+
+    T* allocate(std::size_t n) {
+        if (arena == nullptr) {
+            return std::allocator<T>{}.allocate(n);
+        }
+        return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t n) noexcept {
+        if (arena == nullptr) {
+            std::allocator<T>{}.deallocate(pointer, n);
+            return;
+        }
+        arena->Deallocate(pointer, n * sizeof(T));
+    }
+
+    ArenaAllocator select_on_container_copy_construction() const noexcept {
+        return ArenaAllocator{};
+    }
+
+    Arena* GetArena() const noexcept {
+        return arena;
+    }
+
+    template <typename U>
+    friend bool operator==(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) noexcept {
+        return lhs.arena == rhs.GetArena();
+    }
+
+    template <typename U>
+    friend bool operator!=(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+private:
+    Arena* arena = nullptr;
+};
+
+/// Vector whose storage is drawn from an Arena.
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace Common
@@ -0,0 +1,487 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/alignment.h"
+#include "common/host_memory.h"
+#include "common/logging/log.h"
+#include "common/string_util.h"
+
+namespace Common {
+
+namespace {
+
+constexpr std::size_t HOST_PAGE_SIZE = 0x1000;
+constexpr std::size_t MAX_FAULT_HANDLERS = 8;
+
+struct FaultHandlerSlot {
+    std::atomic<bool> in_use{false};
+    /// Number of faults being dispatched to the slot, unregistering waits for them to finish.
+    std::atomic<u32> active_dispatches{0};
+    FaultCallback callback;
+};
+
+std::array<FaultHandlerSlot, MAX_FAULT_HANDLERS> fault_handlers;
+std::mutex fault_handlers_mutex;
+std::once_flag fault_handler_install_flag;
+
+bool DispatchFault(u8* address, bool is_write) {
+    for (auto& slot : fault_handlers) {
+        // Announce the dispatch before looking at the slot, so that it is either seen as released
+        // or waited for by UnregisterFaultHandler.
+        slot.active_dispatches.fetch_add(1);
+        const bool handled = slot.in_use.load() && slot.callback(address, is_write);
+        slot.active_dispatches.fetch_sub(1);
+        if (handled) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef _WIN32
+
+LONG NTAPI VectoredFaultHandler(PEXCEPTION_POINTERS info) {
+    const auto& record = *info->ExceptionRecord;
+    if (record.ExceptionCode != EXCEPTION_ACCESS_VIOLATION) {
+        return EXCEPTION_CONTINUE_SEARCH;
+    }
+    const bool is_write = record.ExceptionInformation[0] == 1;
+    u8* const address = reinterpret_cast<u8*>(record.ExceptionInformation[1]);
+    return DispatchFault(address, is_write) ? EXCEPTION_CONTINUE_EXECUTION
+                                            : EXCEPTION_CONTINUE_SEARCH;
+}
+
+bool InstallFaultHandler() {
+    std::call_once(fault_handler_install_flag,
+                   [] { AddVectoredExceptionHandler(1, VectoredFaultHandler); });
+    return true;
+}
+
+#else
+
+struct sigaction previous_segv_action;
+#ifdef __APPLE__
+struct sigaction previous_bus_action;
+#endif
+
+bool IsWriteFault([[maybe_unused]] void* raw_context) {
+#if defined(__linux__) && defined(__x86_64__)
+    // Bit 1 of the page fault error code is set for write accesses.
+    const auto* context = static_cast<const ucontext_t*>(raw_context);
+    return (context->uc_mcontext.gregs[REG_ERR] & 0x2) != 0;
+#else
+    // Without a way to tell, treat every fault as a write. Handlers then err on the side of
+    // invalidating state rather than missing a modification.
+    return true;
+#endif
+}
+
+void SignalFaultHandler(int sig, siginfo_t* info, void* raw_context) {
+    u8* const address = static_cast<u8*>(info->si_addr);
+    if (DispatchFault(address, IsWriteFault(raw_context))) {
+        return;
+    }
+
+#ifdef __APPLE__
+    const struct sigaction& previous = sig == SIGBUS ? previous_bus_action : previous_segv_action;
+#else
+    const struct sigaction& previous = previous_segv_action;
+#endif
+    if (previous.sa_flags & SA_SIGINFO) {
+        previous.sa_sigaction(sig, info, raw_context);
+        return;
+    }
+    if (previous.sa_handler == SIG_DFL || previous.sa_handler == SIG_IGN) {
+        // Restore the previous disposition, so the faulting access is retried and handled by it.
+        sigaction(sig, &previous, nullptr);
+        return;
+    }
+    previous.sa_handler(sig);
+}
+
+bool InstallFaultHandler() {
+    std::call_once(fault_handler_install_flag, [] {
+        struct sigaction action {};
+        action.sa_flags = SA_SIGINFO | SA_ONSTACK | SA_RESTART;
+        action.sa_sigaction = SignalFaultHandler;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGSEGV, &action, &previous_segv_action);
+#ifdef __APPLE__
+        sigaction(SIGBUS, &action, &previous_bus_action);
+#endif
+    });
+    return true;
+}
+
+#endif
+
+#ifdef __linux__
+
+enum class PageBacking { Regular, Transparent, Reserved };
+
+struct LargeAllocation {
+    std::size_t size;
+    PageBacking backing;
+};
+
+std::atomic<bool> huge_pages_enabled{false};
+std::atomic<bool> reserved_huge_pages_unavailable{false};
+std::map<const u8*, LargeAllocation> large_allocations;
+std::mutex large_allocations_mutex;
+
+/// Returns whether the host promotes memory advised with MADV_HUGEPAGE to transparent huge pages.
+bool IsHugePageAdviceHonored() {
+    static const bool honored = [] {
+        std::ifstream file{"/sys/kernel/mm/transparent_hugepage/enabled"};
+        std::string modes;
+        std::getline(file, modes);
+        // The active mode is the bracketed one, e.g. "always [madvise] never".
+        const bool is_enabled = modes.find("[always]") != std::string::npos ||
+                                modes.find("[madvise]") != std::string::npos;
+        if (!is_enabled) {
+            LOG_INFO(Common_Memory, "Transparent huge pages are disabled on this host");
+        }
+        return is_enabled;
+    }();
+    return honored;
+}
+
+/**
+ * Sums the AnonHugePages of the host mappings overlapping the given sorted ranges, which is how
+ * much of them the host actually backs with transparent huge pages.
+ */
+u64 GetTransparentHugePageBytes(
+    const std::vector<std::pair<std::uintptr_t, std::uintptr_t>>& ranges) {
+    std::ifstream file{"/proc/self/smaps"};
+    std::string line;
+    bool in_range = false;
+    u64 bytes = 0;
+    while (std::getline(file, line)) {
+        unsigned long begin;
+        unsigned long end;
+        if (std::sscanf(line.c_str(), "%lx-%lx ", &begin, &end) == 2) {
+            in_range = std::any_of(ranges.begin(), ranges.end(), [begin, end](const auto& range) {
+                return range.first < end && begin < range.second;
+            });
+            continue;
+        }
+        unsigned long kib;
+        if (in_range && std::sscanf(line.c_str(), "AnonHugePages: %lu kB", &kib) == 1) {
+            bytes += u64{kib} * 1024;
+        }
+    }
+    return bytes;
+}
+
+/// Reserves an inaccessible host range of the given size, aligned to HUGE_PAGE_SIZE.
+u8* ReserveHugePageAligned(std::size_t size) {
+    const std::size_t reservation_size = size + HUGE_PAGE_SIZE;
+    void* const reservation = mmap(nullptr, reservation_size, PROT_NONE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (reservation == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // Give back the parts of the reservation around the aligned range.
+    u8* const begin = static_cast<u8*>(reservation);
+    u8* const aligned_begin = reinterpret_cast<u8*>(
+        AlignUp(reinterpret_cast<std::uintptr_t>(begin), HUGE_PAGE_SIZE));
+    u8* const aligned_end = aligned_begin + size;
+    if (aligned_begin != begin) {
+        munmap(begin, aligned_begin - begin);
+    }
+    munmap(aligned_end, begin + reservation_size - aligned_end);
+    return aligned_begin;
+}
+
+/// Maps private anonymous memory, preferring huge pages if requested.
+void* MapPrivateMemory(std::size_t size, bool use_huge_pages, PageBacking& backing) {
+    backing = PageBacking::Regular;
+    if (use_huge_pages && !reserved_huge_pages_unavailable.load(std::memory_order_relaxed)) {
+        void* const pointer = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (pointer != MAP_FAILED) {
+            backing = PageBacking::Reserved;
+            return pointer;
+        }
+        // Most hosts reserve no huge pages (vm.nr_hugepages), don't retry on every allocation.
+        reserved_huge_pages_unavailable.store(true, std::memory_order_relaxed);
+        LOG_INFO(Common_Memory, "No reserved huge pages available, using transparent huge pages");
+    }
+
+    if (use_huge_pages && IsHugePageAdviceHonored()) {
+        if (u8* const reservation = ReserveHugePageAligned(size)) {
+            void* const pointer = mmap(reservation, size, PROT_READ | PROT_WRITE,
+                                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+            if (pointer != MAP_FAILED) {
+                if (madvise(pointer, size, MADV_HUGEPAGE) == 0) {
+                    backing = PageBacking::Transparent;
+                }
+                return pointer;
+            }
+            munmap(reservation, size);
+        }
+    }
+
+    void* const pointer =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pointer == MAP_FAILED) {
+        throw std::bad_alloc{};
+    }
+    return pointer;
+}
+
+#endif
+
+} // Anonymous namespace
+
+int RegisterFaultHandler(FaultCallback callback) {
+    if (!InstallFaultHandler()) {
+        return -1;
+    }
+
+    std::lock_guard lock{fault_handlers_mutex};
+    for (std::size_t i = 0; i < fault_handlers.size(); ++i) {
+        auto& slot = fault_handlers[i];
+        if (slot.in_use.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        slot.callback = std::move(callback);
+        slot.in_use.store(true, std::memory_order_release);
+        return static_cast<int>(i);
+    }
+
+    LOG_ERROR(Common_Memory, "Out of host fault handler slots");
+    return -1;
+}
+
+std::size_t GetHostPageSize() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<std::size_t>(info.dwPageSize);
+#else
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+bool ProtectHostMemory(void* pointer, std::size_t size, bool readable, bool writable) {
+#ifdef _WIN32
+    DWORD protection = PAGE_NOACCESS;
+    if (writable) {
+        protection = PAGE_READWRITE;
+    } else if (readable) {
+        protection = PAGE_READONLY;
+    }
+    DWORD old_protection;
+    return VirtualProtect(pointer, size, protection, &old_protection) != 0;
+#else
+    int protection = PROT_NONE;
+    if (readable) {
+        protection |= PROT_READ;
+    }
+    if (writable) {
+        protection |= PROT_WRITE;
+    }
+    return mprotect(pointer, size, protection) == 0;
+#endif
+}
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef _WIN32
+    const HANDLE file =
+        CreateFileW(Common::UTF8ToUTF16W(path).c_str(), GENERIC_READ,
+                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    LARGE_INTEGER file_size;
+    if (GetFileSizeEx(file, &file_size) == 0 || file_size.QuadPart <= 0 ||
+        static_cast<u64>(file_size.QuadPart) > std::numeric_limits<std::size_t>::max()) {
+        CloseHandle(file);
+        return;
+    }
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return;
+    }
+    // The view keeps the mapping object alive.
+    void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        return;
+    }
+    data = static_cast<const u8*>(view);
+    size = static_cast<std::size_t>(file_size.QuadPart);
+#else
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0 ||
+        static_cast<u64>(file_stat.st_size) > std::numeric_limits<std::size_t>::max()) {
+        close(fd);
+        return;
+    }
+    const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+    void* const view = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        return;
+    }
+    data = static_cast<const u8*>(view);
+    size = file_size;
+#endif
+}
+
+MappedFile::~MappedFile() {
+    if (data == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<u8*>(data), size);
+#endif
+}
+
+void UnregisterFaultHandler(int id) {
+    if (id < 0) {
+        return;
+    }
+
+    std::lock_guard lock{fault_handlers_mutex};
+    auto& slot = fault_handlers[static_cast<std::size_t>(id)];
+    slot.in_use.store(false);
+    // Threads that faulted before the slot was released may still be running the callback.
+    while (slot.active_dispatches.load() != 0) {
+        std::this_thread::yield();
+    }
+    slot.callback = nullptr;
+}
+
+#ifdef __linux__
+
+void* AllocateHostMemory(std::size_t size) {
+    const bool is_large = size >= HUGE_PAGE_SIZE;
+    const bool use_huge_pages = is_large && huge_pages_enabled.load(std::memory_order_relaxed);
+    const std::size_t aligned_size = AlignUp(std::max<std::size_t>(size, 1),
+                                             use_huge_pages ? HUGE_PAGE_SIZE : HOST_PAGE_SIZE);
+
+    PageBacking backing;
+    void* const pointer = MapPrivateMemory(aligned_size, use_huge_pages, backing);
+
+    if (is_large) {
+        std::lock_guard lock{large_allocations_mutex};
+        large_allocations.emplace(static_cast<const u8*>(pointer),
+                                  LargeAllocation{aligned_size, backing});
+    }
+    return pointer;
+}
+
+void FreeHostMemory(void* pointer, std::size_t size) {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    std::size_t aligned_size = AlignUp(std::max<std::size_t>(size, 1), HOST_PAGE_SIZE);
+    if (size >= HUGE_PAGE_SIZE) {
+        std::lock_guard lock{large_allocations_mutex};
+        const auto it = large_allocations.find(static_cast<const u8*>(pointer));
+        if (it != large_allocations.end()) {
+            aligned_size = it->second.size;
+            large_allocations.erase(it);
+        }
+    }
+    munmap(pointer, aligned_size);
+}
+
+void SetHugePagesEnabled(bool enabled) {
+    huge_pages_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+HugePageStats GetHugePageStats() {
+    HugePageStats stats;
+    u64 advised_bytes = 0;
+    std::vector<std::pair<std::uintptr_t, std::uintptr_t>> advised_ranges;
+    {
+        std::lock_guard lock{large_allocations_mutex};
+        for (const auto& [pointer, allocation] : large_allocations) {
+            switch (allocation.backing) {
+            case PageBacking::Regular:
+                stats.regular_bytes += allocation.size;
+                break;
+            case PageBacking::Transparent: {
+                const auto begin = reinterpret_cast<std::uintptr_t>(pointer);
+                advised_ranges.emplace_back(begin, begin + allocation.size);
+                advised_bytes += allocation.size;
+                break;
+            }
+            case PageBacking::Reserved:
+                stats.reserved_bytes += allocation.size;
+                break;
+            }
+        }
+    }
+
+    // Advice is only a hint, the host decides which of the advised memory it promotes. Mappings
+    // advised next to each other may be merged by the host, hence the clamping.
+    if (!advised_ranges.empty()) {
+        stats.transparent_bytes =
+            std::min(GetTransparentHugePageBytes(advised_ranges), advised_bytes);
+    }
+    stats.advised_bytes = advised_bytes - stats.transparent_bytes;
+    return stats;
+}
+
+#else
+
+void* AllocateHostMemory(std::size_t size) {
+    void* const pointer = ::operator new(size, std::align_val_t{HOST_PAGE_SIZE});
+    std::memset(pointer, 0, size);
+    return pointer;
+}
+
+void FreeHostMemory(void* pointer, std::size_t) {
+    ::operator delete(pointer, std::align_val_t{HOST_PAGE_SIZE});
+}
+
+void SetHugePagesEnabled(bool) {}
+
+HugePageStats GetHugePageStats() {
+    return {};
+}
+
+#endif
+
+} // namespace Common
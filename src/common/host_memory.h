@@ -0,0 +1,170 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Callback invoked when a host thread faults on an address. The callback receives the faulting
+ * host address and whether the access was a write, and must return true if it resolved the fault
+ * (the faulting access is then retried), or false to pass the fault on to the next handler.
+ *
+ * @note Callbacks run inside the host signal handler of the faulting thread, so they must be
+ *       async-signal-safe: no locks, no allocations, only lock-free atomics and page protection
+ *       changes. Anything else has to be deferred to a regular thread.
+ */
+using FaultCallback = std::function<bool(u8* address, bool is_write)>;
+
+/**
+ * Registers a callback for host access violations.
+ *
+ * @returns An identifier which can be used to unregister the callback, or -1 if host fault
+ *          handling is unsupported or every handler slot is in use.
+ */
+int RegisterFaultHandler(FaultCallback callback);
+
+/// Unregisters a callback previously registered with RegisterFaultHandler.
+void UnregisterFaultHandler(int id);
+
+/// Returns the page size of the host, which is the granularity of ProtectHostMemory.
+std::size_t GetHostPageSize();
+
+/**
+ * Changes the access permissions of a range of host memory.
+ *
+ * @param pointer   Start of the range. Must be aligned to the host page size.
+ * @param size      Size of the range in bytes.
+ * @param readable  Whether reads are allowed.
+ * @param writable  Whether writes are allowed.
+ *
+ * @returns true on success.
+ */
+bool ProtectHostMemory(void* pointer, std::size_t size, bool readable, bool writable);
+
+/**
+ * Read-only view of a whole host file mapped into memory. Reading through the view leaves
+ * caching to the host and copies nothing until the data is used.
+ *
+ * @note The file must not be truncated while mapped, accessing the truncated part of the view
+ *       raises an access violation.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    /// Whether the file could be mapped. Empty files are never mapped.
+    bool IsValid() const {
+        return data != nullptr;
+    }
+
+    const u8* Data() const {
+        return data;
+    }
+
+    /// Size of the file when it was mapped.
+    std::size_t Size() const {
+        return size;
+    }
+
+private:
+    const u8* data = nullptr;
+    std::size_t size = 0;
+};
+
+/**
+ * Allocates page-aligned, zero-filled host memory. Large allocations may be backed by host huge
+ * pages, see SetHugePagesEnabled.
+ */
+void* AllocateHostMemory(std::size_t size);
+
+/// Frees memory obtained from AllocateHostMemory.
+void FreeHostMemory(void* pointer, std::size_t size);
+
+/// Size of the host huge pages used to back large allocations.
+constexpr std::size_t HUGE_PAGE_SIZE = 0x200000;
+
+/**
+ * Enables or disables huge pages for allocations of at least HUGE_PAGE_SIZE bytes made by
+ * AllocateHostMemory, which cuts the TLB misses of code walking large guest heaps. Reserved
+ * huge pages (MAP_HUGETLB) are used when the host has any, otherwise the allocation is aligned to
+ * HUGE_PAGE_SIZE and advised for transparent huge pages, provided the host has them enabled.
+ * Allocations fall back to regular pages when neither is possible.
+ */
+void SetHugePagesEnabled(bool enabled);
+
+/// Bytes of live allocations of at least HUGE_PAGE_SIZE, by how they are backed.
+struct HugePageStats {
+    u64 reserved_bytes = 0;    ///< Backed by reserved huge pages.
+    u64 transparent_bytes = 0; ///< Backed by transparent huge pages, as reported by the host.
+    u64 advised_bytes = 0;     ///< Advised for transparent huge pages, not promoted by the host.
+    u64 regular_bytes = 0;     ///< Backed by regular pages.
+
+    /// Number of TLB entries needed to cover the huge page backed bytes.
+    u64 HugePageCount() const {
+        return (reserved_bytes + transparent_bytes) / HUGE_PAGE_SIZE;
+    }
+
+    /// Number of TLB entries the same bytes would need with 4 KiB pages.
+    u64 RegularPageCount() const {
+        return (reserved_bytes + transparent_bytes) / 0x1000;
+    }
+};
+
+HugePageStats GetHugePageStats();
+
+/// Standard allocator handing out memory from AllocateHostMemory.
+template <typename T>
+class HostMemoryAllocator {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::true_type;
+
+    constexpr HostMemoryAllocator() noexcept = default;
+
+    template <typename T2>
+    constexpr HostMemoryAllocator(const HostMemoryAllocator<T2>&) noexcept {}
+
+    T* allocate(size_type n) {
+        return static_cast<T*>(AllocateHostMemory(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_type n) {
+        FreeHostMemory(p, n * sizeof(T));
+    }
+
+    template <typename T2>
+    struct rebind {
+        using other = HostMemoryAllocator<T2>;
+    };
+
+    bool operator==(const HostMemoryAllocator&) const noexcept {
+        return true;
+    }
+
+    bool operator!=(const HostMemoryAllocator&) const noexcept {
+        return false;
+    }
+};
+
+} // namespace Common
@@ -0,0 +1,324 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+#include "common/assert.h"
+#include "common/bit_util.h"
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Position of an element within an IntrusiveMultiLevelQueue.
+template <typename T>
+struct MultiLevelQueueLink {
+    T* prev = nullptr;
+    T* next = nullptr;
+    u32 priority = 0;
+    bool linked = false;
+};
+
+/**
+ * A MultiLevelQueue whose elements embed the links used to chain them, so that adding, removing
+ * and moving elements never allocates and removal does not have to search for the element.
+ *
+ * Elements may be part of several queues at the same time, as long as they have one link per
+ * queue. The queue stores pointers to elements and finds their links through LinkAccessor, which
+ * is called as LinkAccessor{}(element, queue_index) and must return a MultiLevelQueueLink<T>&.
+ * The queue index is fixed at construction and lets an element hold an array of links, one per
+ * queue of an array of queues.
+ *
+ * Elements must stay alive while linked, or until the queue is destroyed. An element can only be
+ * in a queue once, adding an element that is already in the queue moves it to its new position.
+ */
+template <typename T, std::size_t Depth, typename LinkAccessor>
+class IntrusiveMultiLevelQueue {
+    static_assert(Depth <= 64, "Priorities are tracked in a 64-bit mask");
+
+public:
+    using value_type = T*;
+    using size_type = std::size_t;
+
+    template <bool is_constant>
+    class iterator_impl {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T* const*;
+        using reference = T* const&;
+
+        iterator_impl() = default;
+
+        // allow implicit const->non-const
+        iterator_impl(const iterator_impl<false>& other)
+            : mlq(other.mlq), element(other.element) {}
+
+        friend bool operator==(const iterator_impl& lhs, const iterator_impl& rhs) {
+            return lhs.element == rhs.element;
+        }
+
+        friend bool operator!=(const iterator_impl& lhs, const iterator_impl& rhs) {
+            return !operator==(lhs, rhs);
+        }
+
+        reference operator*() const {
+            return element;
+        }
+
+        iterator_impl& operator++() {
+            const auto& link = GetLink(element, mlq->queue_index);
+            if (link.next != nullptr) {
+                element = link.next;
+                return *this;
+            }
+            u64 prios = mlq->used_priorities;
+            prios &= ~((2ULL << link.priority) - 1);
+            element = prios == 0 ? nullptr : mlq->levels[CountTrailingZeroes64(prios)].head;
+            return *this;
+        }
+
+        iterator_impl operator++(int) {
+            const iterator_impl v{*this};
+            ++(*this);
+            return v;
+        }
+
+    private:
+        friend class IntrusiveMultiLevelQueue;
+        friend class iterator_impl<true>;
+        using container_ptr =
+            std::conditional_t<is_constant, const IntrusiveMultiLevelQueue*,
+                               IntrusiveMultiLevelQueue*>;
+
+        iterator_impl(container_ptr mlq, T* element) : mlq(mlq), element(element) {}
+
+        container_ptr mlq = nullptr;
+        T* element = nullptr;
+    };
+
+    using iterator = iterator_impl<false>;
+    using const_iterator = iterator_impl<true>;
+
+    explicit IntrusiveMultiLevelQueue(std::size_t queue_index = 0) : queue_index{queue_index} {}
+
+    IntrusiveMultiLevelQueue(const IntrusiveMultiLevelQueue&) = delete;
+    IntrusiveMultiLevelQueue& operator=(const IntrusiveMultiLevelQueue&) = delete;
+
+    // The elements keep pointing at each other, so the queue can be moved as long as the queue
+    // index is moved along.
+    IntrusiveMultiLevelQueue(IntrusiveMultiLevelQueue&& other) noexcept
+        : levels{other.levels}, used_priorities{other.used_priorities},
+          queue_index{other.queue_index} {
+        other.levels = {};
+        other.used_priorities = 0;
+    }
+
+    IntrusiveMultiLevelQueue& operator=(IntrusiveMultiLevelQueue&& other) noexcept {
+        if (this != &other) {
+            clear();
+            levels = other.levels;
+            used_priorities = other.used_priorities;
+            queue_index = other.queue_index;
+            other.levels = {};
+            other.used_priorities = 0;
+        }
+        return *this;
+    }
+
+    void add(T* element, u32 priority, bool send_back = true) {
+        auto& link = GetLink(element, queue_index);
+        if (link.linked) {
+            // MultiLevelQueue would hold the element twice, here it is only moved.
+            Unlink(element, link);
+        }
+        Level& level = levels[priority];
+        link.priority = priority;
+        link.linked = true;
+        if (send_back) {
+            link.prev = level.tail;
+            link.next = nullptr;
+            if (level.tail != nullptr) {
+                GetLink(level.tail, queue_index).next = element;
+            } else {
+                level.head = element;
+            }
+            level.tail = element;
+        } else {
+            link.prev = nullptr;
+            link.next = level.head;
+            if (level.head != nullptr) {
+                GetLink(level.head, queue_index).prev = element;
+            } else {
+                level.tail = element;
+            }
+            level.head = element;
+        }
+        ++level.size;
+        used_priorities |= 1ULL << priority;
+    }
+
+    /// Removes an element. Elements that are not in the queue are ignored. The priority is only
+    /// checked, the element is removed from the level it was added at.
+    void remove(T* element, [[maybe_unused]] u32 priority) {
+        auto& link = GetLink(element, queue_index);
+        if (!link.linked) {
+            return;
+        }
+        DEBUG_ASSERT(link.priority == priority);
+        Unlink(element, link);
+    }
+
+    void adjust(T* element, u32 old_priority, u32 new_priority, bool adjust_front = false) {
+        remove(element, old_priority);
+        add(element, new_priority, !adjust_front);
+    }
+
+    /// Moves the first n elements of a priority level to its back.
+    void yield(u32 priority, std::size_t n = 1) {
+        Level& level = levels[priority];
+        if (n >= level.size) {
+            return;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            T* const element = level.head;
+            auto& link = GetLink(element, queue_index);
+            level.head = link.next;
+            GetLink(level.head, queue_index).prev = nullptr;
+            link.prev = level.tail;
+            link.next = nullptr;
+            GetLink(level.tail, queue_index).next = element;
+            level.tail = element;
+        }
+    }
+
+    bool contains(const T* element) const {
+        return GetLink(const_cast<T*>(element), queue_index).linked;
+    }
+
+    std::size_t depth() const {
+        return Depth;
+    }
+
+    std::size_t size(u32 priority) const {
+        return levels[priority].size;
+    }
+
+    std::size_t size() const {
+        u64 priorities = used_priorities;
+        std::size_t size = 0;
+        while (priorities != 0) {
+            const u64 current_priority = CountTrailingZeroes64(priorities);
+            size += levels[current_priority].size;
+            priorities &= ~(1ULL << current_priority);
+        }
+        return size;
+    }
+
+    bool empty() const {
+        return used_priorities == 0;
+    }
+
+    bool empty(u32 priority) const {
+        return (used_priorities & (1ULL << priority)) == 0;
+    }
+
+    u32 highest_priority_set(u32 max_priority = 0) const {
+        const u64 priorities =
+            max_priority == 0 ? used_priorities : (used_priorities & ~((1ULL << max_priority) - 1));
+        return priorities == 0 ? Depth : static_cast<u32>(CountTrailingZeroes64(priorities));
+    }
+
+    u32 lowest_priority_set(u32 min_priority = Depth - 1) const {
+        const u64 priorities = min_priority >= Depth - 1
+                                   ? used_priorities
+                                   : (used_priorities & ((1ULL << (min_priority + 1)) - 1));
+        return priorities == 0 ? Depth : 63 - CountLeadingZeroes64(priorities);
+    }
+
+    const_iterator cbegin(u32 max_prio = 0) const {
+        return const_iterator{this, front(max_prio)};
+    }
+    const_iterator begin(u32 max_prio = 0) const {
+        return cbegin(max_prio);
+    }
+    iterator begin(u32 max_prio = 0) {
+        return iterator{this, front(max_prio)};
+    }
+
+    const_iterator cend(u32 min_prio = Depth - 1) const {
+        return min_prio == Depth - 1 ? const_iterator{this, nullptr} : cbegin(min_prio + 1);
+    }
+    const_iterator end(u32 min_prio = Depth - 1) const {
+        return cend(min_prio);
+    }
+    iterator end(u32 min_prio = Depth - 1) {
+        return min_prio == Depth - 1 ? iterator{this, nullptr} : begin(min_prio + 1);
+    }
+
+    /// Returns the first element at or below the given priority, or nullptr if there is none.
+    T* front(u32 max_priority = 0) const {
+        const u32 priority = highest_priority_set(max_priority);
+        return priority == Depth ? nullptr : levels[priority].head;
+    }
+
+    /// Returns the last element at or above the given priority, or nullptr if there is none.
+    T* back(u32 min_priority = Depth - 1) const {
+        const u32 priority = lowest_priority_set(min_priority);
+        return priority == Depth ? nullptr : levels[priority].tail;
+    }
+
+    void clear() {
+        while (used_priorities != 0) {
+            const u32 priority = static_cast<u32>(CountTrailingZeroes64(used_priorities));
+            Level& level = levels[priority];
+            for (T* element = level.head; element != nullptr;) {
+                auto& link = GetLink(element, queue_index);
+                element = link.next;
+                link = {};
+            }
+            level = {};
+            used_priorities &= ~(1ULL << priority);
+        }
+    }
+
+private:
+    struct Level {
+        T* head = nullptr;
+        T* tail = nullptr;
+        std::size_t size = 0;
+    };
+
+    static MultiLevelQueueLink<T>& GetLink(T* element, std::size_t queue_index) {
+        return LinkAccessor{}(*element, queue_index);
+    }
+
+    void Unlink(T* element, MultiLevelQueueLink<T>& link) {
+        Level& level = levels[link.priority];
+        if (link.prev != nullptr) {
+            GetLink(link.prev, queue_index).next = link.next;
+        } else {
+            level.head = link.next;
+        }
+        if (link.next != nullptr) {
+            GetLink(link.next, queue_index).prev = link.prev;
+        } else {
+            level.tail = link.prev;
+        }
+        if (--level.size == 0) {
+            used_priorities &= ~(1ULL << link.priority);
+        }
+        link = {};
+    }
+
+    std::array<Level, Depth> levels{};
+    u64 used_priorities = 0;
+    std::size_t queue_index;
+};
+
+} // namespace Common
@@ -0,0 +1,192 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "common/assert.h"
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Position of an element within an IntrusiveWaitTable.
+template <typename T>
+struct WaitTableLink {
+    T* prev = nullptr;
+    T* next = nullptr;
+    bool linked = false;
+};
+
+/// Order of the elements waiting on the same key with the same priority.
+enum class WaitTableTieBreak {
+    /// Elements are queued ahead of the elements of the same priority already waiting.
+    LastInFirstOut,
+    /// Elements are queued behind the elements of the same priority already waiting.
+    FirstInFirstOut,
+};
+
+/**
+ * Elements waiting on keys, such as threads waiting on a guest address. The elements embed the
+ * links used to chain them, so that waiting and waking never allocate and removal does not have to
+ * search for the element.
+ *
+ * Elements are hashed into NumBuckets buckets by key. The elements waiting on a key are kept in
+ * priority order, lower values first. Traits::TIE_BREAK decides whether an element is queued ahead
+ * of or behind the elements of the same priority already waiting.
+ *
+ * Traits must provide:
+ *  - static WaitTableLink<T>& GetLink(T& element);
+ *  - static u64 GetKey(const T& element);
+ *  - static u32 GetPriority(const T& element);
+ *  - static constexpr WaitTableTieBreak TIE_BREAK;
+ * The key of an element must not change while it is in the table. Elements are ordered by their
+ * priority when inserted, later priority changes do not move them.
+ *
+ * Elements must stay alive while linked. An element can only be in a table once.
+ */
+template <typename T, std::size_t NumBuckets, typename Traits>
+class IntrusiveWaitTable {
+    static_assert(NumBuckets != 0 && (NumBuckets & (NumBuckets - 1)) == 0,
+                  "The number of buckets must be a power of two");
+
+public:
+    IntrusiveWaitTable() = default;
+
+    IntrusiveWaitTable(const IntrusiveWaitTable&) = delete;
+    IntrusiveWaitTable& operator=(const IntrusiveWaitTable&) = delete;
+
+    // Elements only point at each other, so the table can be moved.
+    IntrusiveWaitTable(IntrusiveWaitTable&& other) noexcept : buckets{other.buckets} {
+        other.buckets = {};
+    }
+    IntrusiveWaitTable& operator=(IntrusiveWaitTable&&) = delete;
+
+    void insert(T* element) {
+        auto& link = Traits::GetLink(*element);
+        ASSERT_MSG(!link.linked, "Element is already in the table");
+        const u64 key = Traits::GetKey(*element);
+        const u32 priority = Traits::GetPriority(*element);
+        Bucket& bucket = GetBucket(key);
+
+        // Other keys may share the bucket, only the order among elements of this key matters.
+        T* next = bucket.head;
+        while (next != nullptr && (Traits::GetKey(*next) != key || QueuesBehind(*next, priority))) {
+            next = Traits::GetLink(*next).next;
+        }
+
+        link.next = next;
+        link.prev = next != nullptr ? Traits::GetLink(*next).prev : bucket.tail;
+        link.linked = true;
+        if (link.prev != nullptr) {
+            Traits::GetLink(*link.prev).next = element;
+        } else {
+            bucket.head = element;
+        }
+        if (next != nullptr) {
+            Traits::GetLink(*next).prev = element;
+        } else {
+            bucket.tail = element;
+        }
+    }
+
+    /// Removes an element. Elements that are not in the table are ignored.
+    void remove(T* element) {
+        auto& link = Traits::GetLink(*element);
+        if (!link.linked) {
+            return;
+        }
+        Bucket& bucket = GetBucket(Traits::GetKey(*element));
+        if (link.prev != nullptr) {
+            Traits::GetLink(*link.prev).next = link.next;
+        } else {
+            bucket.head = link.next;
+        }
+        if (link.next != nullptr) {
+            Traits::GetLink(*link.next).prev = link.prev;
+        } else {
+            bucket.tail = link.prev;
+        }
+        link = {};
+    }
+
+    bool contains(const T* element) const {
+        return Traits::GetLink(*const_cast<T*>(element)).linked;
+    }
+
+    /// Returns the first element waiting on a key, or nullptr if there is none.
+    T* front(u64 key) const {
+        return Next(GetBucket(key).head, key);
+    }
+
+    /// Counts the elements waiting on a key, stopping once max_count of them were found.
+    std::size_t count(u64 key, std::size_t max_count) const {
+        std::size_t num_elements = 0;
+        for (T* element = front(key); element != nullptr && num_elements < max_count;
+             element = Next(Traits::GetLink(*element).next, key)) {
+            ++num_elements;
+        }
+        return num_elements;
+    }
+
+    /**
+     * Removes up to max_count elements waiting on a key, in order, and calls func on each of them
+     * once it is removed.
+     * @return The number of removed elements.
+     */
+    template <typename Func>
+    std::size_t wake(u64 key, std::size_t max_count, Func&& func) {
+        std::size_t num_woken = 0;
+        T* element = front(key);
+        while (element != nullptr && num_woken < max_count) {
+            T* const next = Next(Traits::GetLink(*element).next, key);
+            remove(element);
+            func(element);
+            ++num_woken;
+            element = next;
+        }
+        return num_woken;
+    }
+
+private:
+    struct Bucket {
+        T* head = nullptr;
+        T* tail = nullptr;
+    };
+
+    static std::size_t GetBucketIndex(u64 key) {
+        // Keys are often aligned addresses, mix the bits so that neighbours spread out.
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & (NumBuckets - 1);
+    }
+
+    Bucket& GetBucket(u64 key) {
+        return buckets[GetBucketIndex(key)];
+    }
+
+    const Bucket& GetBucket(u64 key) const {
+        return buckets[GetBucketIndex(key)];
+    }
+
+    /// Returns whether an element of the given priority is queued behind a waiting element.
+    static bool QueuesBehind(const T& waiting, u32 priority) {
+        if constexpr (Traits::TIE_BREAK == WaitTableTieBreak::FirstInFirstOut) {
+            return Traits::GetPriority(waiting) <= priority;
+        } else {
+            return Traits::GetPriority(waiting) < priority;
+        }
+    }
+
+    /// Returns the first element at or after the given one waiting on a key.
+    static T* Next(T* element, u64 key) {
+        while (element != nullptr && Traits::GetKey(*element) != key) {
+            element = Traits::GetLink(*element).next;
+        }
+        return element;
+    }
+
+    std::array<Bucket, NumBuckets> buckets{};
+};
+
+} // namespace Common
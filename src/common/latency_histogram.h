@@ -0,0 +1,148 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <fmt/format.h>
+#include "common/bit_util.h"
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Counts samples of a latency, along with their total, in buckets growing by powers of two.
+ * Bucket i counts the samples that took less than 2^(i + 1) Units, the last bucket counts every
+ * slower sample. Recording is lock-free, so it can be fed from any thread.
+ */
+template <typename Unit, std::size_t NumBuckets>
+class LatencyHistogram {
+public:
+    /// Copy of the counters of a histogram.
+    struct Snapshot {
+        u64 calls = 0;
+        std::chrono::nanoseconds total_time{};
+        std::array<u64, NumBuckets> buckets{};
+
+        /// Returns the upper bound of the bucket containing the median sample.
+        Unit Median() const {
+            u64 seen = 0;
+            std::size_t bucket = 0;
+            while (bucket + 1 < NumBuckets && (seen += buckets[bucket]) * 2 < calls) {
+                ++bucket;
+            }
+            return BucketBound(bucket);
+        }
+    };
+
+    /// Returns the upper bound of a bucket, the last one also counts every slower sample.
+    static constexpr Unit BucketBound(std::size_t bucket) {
+        return Unit{static_cast<typename Unit::rep>(u64{2} << bucket)};
+    }
+
+    void Record(std::chrono::nanoseconds latency) {
+        const auto ns = static_cast<u64>(std::max<s64>(latency.count(), 0));
+        const auto units = static_cast<u64>(
+            std::max<s64>(std::chrono::duration_cast<Unit>(latency).count(), 0));
+        const std::size_t bucket =
+            units < 2 ? 0
+                      : std::min<std::size_t>(63 - CountLeadingZeroes64(units), NumBuckets - 1);
+
+        calls.fetch_add(1, std::memory_order_relaxed);
+        total_time_ns.fetch_add(ns, std::memory_order_relaxed);
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Snapshot GetSnapshot() const {
+        Snapshot snapshot;
+        snapshot.calls = calls.load(std::memory_order_relaxed);
+        snapshot.total_time =
+            std::chrono::nanoseconds{total_time_ns.load(std::memory_order_relaxed)};
+        for (std::size_t i = 0; i < NumBuckets; ++i) {
+            snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+    /// Zeroes every counter.
+    void Reset() {
+        calls.store(0, std::memory_order_relaxed);
+        total_time_ns.store(0, std::memory_order_relaxed);
+        for (auto& bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<u64> calls{};
+    std::atomic<u64> total_time_ns{};
+    std::array<std::atomic<u64>, NumBuckets> buckets{};
+};
+
+/**
+ * Drops the entries without any recorded sample and sorts the others by total time, most
+ * expensive first. Entries hold the snapshot of a histogram in a `latency` member.
+ */
+template <typename Entry>
+void SortLatencySnapshots(std::vector<Entry>& entries) {
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const Entry& entry) { return entry.latency.calls == 0; }),
+                  entries.end());
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+        return lhs.latency.total_time > rhs.latency.total_time;
+    });
+}
+
+/**
+ * Summarizes the entries that took the most time, up to max_entries of them, as lines to log.
+ *
+ * @param entries     Entries sorted by SortLatencySnapshots.
+ * @param max_entries Maximum number of entries to summarize.
+ * @param what        Description of the entries, e.g. "called SVCs".
+ * @param describe    Function returning the name of an entry.
+ */
+template <typename Entry, typename Describe>
+std::vector<std::string> SummarizeLatencySnapshots(const std::vector<Entry>& entries,
+                                                   std::size_t max_entries, std::string_view what,
+                                                   Describe&& describe) {
+    std::vector<std::string> lines;
+    if (entries.empty()) {
+        return lines;
+    }
+
+    const std::size_t count = std::min(max_entries, entries.size());
+    lines.push_back(fmt::format("Top {} of {} {} by total time:", count, entries.size(), what));
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& latency = entries[i].latency;
+        const auto median = latency.Median();
+        const auto total_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(latency.total_time).count();
+        const char* unit = "s";
+        using Period = typename decltype(median)::period;
+        if constexpr (std::is_same_v<Period, std::nano>) {
+            unit = "ns";
+        } else if constexpr (std::is_same_v<Period, std::micro>) {
+            unit = "us";
+        } else if constexpr (std::is_same_v<Period, std::milli>) {
+            unit = "ms";
+        }
+
+        // Report the bucket containing the median call as its upper bound.
+        lines.push_back(fmt::format("  {}: {} calls, {} us total, median < {} {}",
+                                    describe(entries[i]), latency.calls, total_us,
+                                    median.count(), unit));
+    }
+    return lines;
+}
+
+} // namespace Common
@@ -54,4 +54,17 @@ std::vector<u8> CompressDataLZ4HCMax(const u8* source, std::size_t source_size);
  */
 std::vector<u8> DecompressDataLZ4(const std::vector<u8>& compressed, std::size_t uncompressed_size);
 
+/**
+ * Decompresses a source memory region with LZ4 into a destination memory region.
+ *
+ * @param source the compressed source memory region.
+ * @param source_size the size in bytes of the compressed source memory region.
+ * @param destination the destination memory region, of at least uncompressed_size bytes.
+ * @param uncompressed_size the size in bytes of the uncompressed data.
+ *
+ * @return whether exactly uncompressed_size bytes were decompressed.
+ */
+bool DecompressDataLZ4(const u8* source, std::size_t source_size, u8* destination,
+                       std::size_t uncompressed_size);
+
 } // namespace Common::Compression
\ No newline at end of file
@@ -14,18 +14,20 @@ void PageTable::Resize(std::size_t address_space_width_in_bits) {
     const std::size_t num_page_table_entries = 1ULL
                                                << (address_space_width_in_bits - page_size_in_bits);
 
+    // The default is a 39-bit address space, which takes up to 2GB of tables. These are only
+    // reserved, host memory is committed for the parts of the tables that get written to.
     pointers.resize(num_page_table_entries);
     attributes.resize(num_page_table_entries);
     backing_addr.resize(num_page_table_entries);
+}
 
-    // The default is a 39-bit address space, which causes an initial 1GB allocation size. If the
-    // vector size is subsequently decreased (via resize), the vector might not automatically
-    // actually reallocate/resize its underlying allocation, which wastes up to ~800 MB for
-    // 36-bit titles. Call shrink_to_fit to reduce capacity to what's actually in use.
+void PageTable::ClearPages(std::size_t first_page, std::size_t num_pages) {
+    static_assert(PageType::Unmapped == PageType{}, "Unmapped pages must be zero-initialized");
 
-    pointers.shrink_to_fit();
-    attributes.shrink_to_fit();
-    backing_addr.shrink_to_fit();
+    const std::size_t last_page = first_page + num_pages;
+    pointers.Zero(first_page, last_page);
+    attributes.Zero(first_page, last_page);
+    backing_addr.Zero(first_page, last_page);
 }
 
 } // namespace Common
@@ -4,10 +4,10 @@
 
 #pragma once
 
-#include <vector>
 #include <boost/icl/interval_map.hpp>
 #include "common/common_types.h"
 #include "common/memory_hook.h"
+#include "common/virtual_buffer.h"
 
 namespace Common {
 
@@ -45,6 +45,9 @@ struct SpecialRegion {
 /**
  * A (reasonably) fast way of allowing switchable and remappable process address spaces. It loosely
  * mimics the way a real CPU page table works.
+ *
+ * The tables are flat, so looking a page up is a single load, but they are backed by reserved
+ * host memory which is only committed once written. Ranges that are never mapped cost nothing.
  */
 struct PageTable {
     explicit PageTable(std::size_t page_size_in_bits);
@@ -52,17 +55,26 @@ struct PageTable {
 
     /**
      * Resizes the page table to be able to accomodate enough pages within
-     * a given address space.
+     * a given address space. All pages are unmapped afterwards.
      *
      * @param address_space_width_in_bits The address size width in bits.
      */
     void Resize(std::size_t address_space_width_in_bits);
 
     /**
-     * Vector of memory pointers backing each page. An entry can only be non-null if the
+     * Resets a range of pages to unmapped, handing the table memory covering them back to the
+     * host where possible. Special regions are left untouched.
+     *
+     * @param first_page The index of the first page to clear.
+     * @param num_pages  The number of pages to clear.
+     */
+    void ClearPages(std::size_t first_page, std::size_t num_pages);
+
+    /**
+     * Table of memory pointers backing each page. An entry can only be non-null if the
      * corresponding entry in the `attributes` vector is of type `Memory`.
      */
-    std::vector<u8*> pointers;
+    VirtualBuffer<u8*> pointers;
 
     /**
      * Contains MMIO handlers that back memory regions whose entries in the `attribute` vector is
@@ -71,12 +83,18 @@ struct PageTable {
     boost::icl::interval_map<u64, std::set<SpecialRegion>> special_regions;
 
     /**
-     * Vector of fine grained page attributes. If it is set to any value other than `Memory`, then
+     * Table of fine grained page attributes. If it is set to any value other than `Memory`, then
      * the corresponding entry in `pointers` MUST be set to null.
      */
-    std::vector<PageType> attributes;
+    VirtualBuffer<PageType> attributes;
 
-    std::vector<u64> backing_addr;
+    /**
+     * Table of addresses of the memory backing each page. For GPU page tables these are CPU
+     * virtual addresses. For CPU page tables these are host pointers, offset by the page's virtual
+     * address like the entries in `pointers`. Unlike `pointers`, they stay valid while the page is
+     * of type `RasterizerCachedMemory`.
+     */
+    VirtualBuffer<u64> backing_addr;
 
     const std::size_t page_size_in_bits{};
 };
@@ -0,0 +1,87 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "common/assert.h"
+
+namespace Common {
+
+/**
+ * Non-owning view of a contiguous sequence of objects, a subset of C++20's std::span with a
+ * dynamic extent. The viewed memory must outlive the span.
+ */
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, std::size_t size) noexcept : data_ptr{data}, num_elements{size} {}
+
+    /// Views a contiguous container, such as std::vector or std::array.
+    template <typename Container,
+              typename = std::enable_if_t<std::is_convertible_v<
+                  decltype(std::data(std::declval<Container&>())), T*>>>
+    constexpr Span(Container& container) noexcept
+        : data_ptr{std::data(container)}, num_elements{std::size(container)} {}
+
+    /// Allows converting a span of T to a span of const T.
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept
+        : data_ptr{other.data()}, num_elements{other.size()} {}
+
+    constexpr T* data() const noexcept {
+        return data_ptr;
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return num_elements;
+    }
+
+    constexpr std::size_t size_bytes() const noexcept {
+        return num_elements * sizeof(T);
+    }
+
+    constexpr bool empty() const noexcept {
+        return num_elements == 0;
+    }
+
+    constexpr iterator begin() const noexcept {
+        return data_ptr;
+    }
+
+    constexpr iterator end() const noexcept {
+        return data_ptr + num_elements;
+    }
+
+    constexpr T& operator[](std::size_t index) const {
+        return data_ptr[index];
+    }
+
+    /// Returns a view of `count` elements starting at `offset`, or of every element after it.
+    Span subspan(std::size_t offset, std::size_t count = static_cast<std::size_t>(-1)) const {
+        ASSERT(offset <= num_elements);
+        if (count == static_cast<std::size_t>(-1)) {
+            count = num_elements - offset;
+        }
+        ASSERT(count <= num_elements - offset);
+        return {data_ptr + offset, count};
+    }
+
+private:
+    T* data_ptr = nullptr;
+    std::size_t num_elements = 0;
+};
+
+} // namespace Common
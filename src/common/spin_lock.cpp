@@ -0,0 +1,58 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <thread>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "common/spin_lock.h"
+
+namespace Common {
+
+namespace {
+// Longest run of pause instructions between two polls of the lock.
+constexpr u32 MAX_BACKOFF = 64;
+
+void ThreadPause() {
+#if defined(_M_X64) || defined(__x86_64__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+} // Anonymous namespace
+
+void SpinLock::lock() {
+    const u32 ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+    u32 backoff = 1;
+    while (now_serving.load(std::memory_order_acquire) != ticket) {
+        if (backoff == MAX_BACKOFF) {
+            // The owner is likely descheduled, let the host run it.
+            std::this_thread::yield();
+            continue;
+        }
+        for (u32 i = 0; i < backoff; ++i) {
+            ThreadPause();
+        }
+        backoff = std::min(backoff * 2, MAX_BACKOFF);
+    }
+}
+
+void SpinLock::unlock() {
+    // Only the owner advances the counter, so a plain store is enough.
+    now_serving.store(now_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool SpinLock::try_lock() {
+    u32 ticket = now_serving.load(std::memory_order_relaxed);
+    return next_ticket.compare_exchange_strong(ticket, ticket + 1, std::memory_order_acquire,
+                                               std::memory_order_relaxed);
+}
+
+} // namespace Common
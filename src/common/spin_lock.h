@@ -0,0 +1,31 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Ticket spin lock for short critical sections. Waiters are served in arrival order, so a thread
+ * releasing and immediately retaking the lock cannot starve the others. Waiters back off
+ * exponentially while spinning and eventually yield, so that an oversubscribed host can still run
+ * the owner.
+ *
+ * Meets the Lockable requirements, so it can be used with std::lock_guard and std::unique_lock.
+ */
+class SpinLock {
+public:
+    void lock();
+    void unlock();
+    bool try_lock();
+
+private:
+    std::atomic<u32> next_ticket{0};
+    std::atomic<u32> now_serving{0};
+};
+
+} // namespace Common
@@ -0,0 +1,156 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <array>
+#include <atomic>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/virtual_buffer.h"
+
+#ifdef _WIN32
+#include "common/host_memory.h"
+#endif
+
+namespace Common {
+
+namespace {
+constexpr std::size_t HOST_PAGE_SIZE = 0x1000;
+
+#ifdef _WIN32
+/**
+ * Windows charges committed memory against the commit limit whether it is touched or not, so
+ * ranges are only reserved, and their pages are committed by a fault handler on first access.
+ * The ranges are kept in a fixed table of lock-free slots, which the handler can walk.
+ */
+struct Reservation {
+    std::atomic<u8*> base{nullptr};
+    std::atomic<std::size_t> size{0};
+};
+
+constexpr std::size_t MAX_RESERVATIONS = 64;
+
+std::array<Reservation, MAX_RESERVATIONS> reservations;
+
+/// Returns the slot of the reservation containing the given address, or nullptr.
+Reservation* FindReservation(const u8* address) {
+    for (Reservation& reservation : reservations) {
+        const u8* const base = reservation.base.load();
+        if (base != nullptr && address >= base && address < base + reservation.size.load()) {
+            return &reservation;
+        }
+    }
+    return nullptr;
+}
+
+bool CommitOnFault(u8* address) {
+    if (FindReservation(address) == nullptr) {
+        return false;
+    }
+    void* const page = reinterpret_cast<void*>(
+        AlignDown(reinterpret_cast<std::uintptr_t>(address), HOST_PAGE_SIZE));
+    return VirtualAlloc(page, HOST_PAGE_SIZE, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+/// Tracks a reserved range for the fault handler. Returns false if it cannot be tracked.
+bool TrackReservation(u8* base, std::size_t size) {
+    static const int fault_handler_id =
+        RegisterFaultHandler([](u8* address, bool) { return CommitOnFault(address); });
+    if (fault_handler_id < 0) {
+        return false;
+    }
+    for (Reservation& reservation : reservations) {
+        u8* expected = nullptr;
+        if (reservation.base.compare_exchange_strong(expected, base)) {
+            // The range is only accessed once the allocation returns, after the size is set.
+            reservation.size.store(size);
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+} // Anonymous namespace
+
+void* AllocateMemoryPages(std::size_t size) {
+#ifdef _WIN32
+    void* const base = VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_READWRITE);
+    if (base == nullptr) {
+        throw std::bad_alloc{};
+    }
+    if (!TrackReservation(static_cast<u8*>(base), size) &&
+        VirtualAlloc(base, size, MEM_COMMIT, PAGE_READWRITE) == nullptr) {
+        VirtualFree(base, 0, MEM_RELEASE);
+        throw std::bad_alloc{};
+    }
+#else
+    void* const base =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+             -1, 0);
+    if (base == MAP_FAILED) {
+        throw std::bad_alloc{};
+    }
+#endif
+    return base;
+}
+
+void FreeMemoryPages(void* base, [[maybe_unused]] std::size_t size) {
+    if (base == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    if (Reservation* const reservation = FindReservation(static_cast<u8*>(base))) {
+        reservation->size.store(0);
+        reservation->base.store(nullptr);
+    }
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, size);
+#endif
+}
+
+void ZeroMemoryPages(void* base, std::size_t size) {
+    u8* const begin = static_cast<u8*>(base);
+    u8* const end = begin + size;
+    u8* const inner_begin = reinterpret_cast<u8*>(
+        AlignUp(reinterpret_cast<std::uintptr_t>(begin), HOST_PAGE_SIZE));
+    u8* const inner_end = reinterpret_cast<u8*>(
+        AlignDown(reinterpret_cast<std::uintptr_t>(end), HOST_PAGE_SIZE));
+
+    if (inner_begin >= inner_end) {
+        std::memset(begin, 0, size);
+        return;
+    }
+
+    std::memset(begin, 0, inner_begin - begin);
+    std::memset(inner_end, 0, end - inner_end);
+
+    const std::size_t inner_size = inner_end - inner_begin;
+#ifdef _WIN32
+    // Decommitted pages of tracked reservations are committed again, zero-filled, when accessed.
+    VirtualFree(inner_begin, inner_size, MEM_DECOMMIT);
+    if (FindReservation(inner_begin) == nullptr) {
+        VirtualAlloc(inner_begin, inner_size, MEM_COMMIT, PAGE_READWRITE);
+    }
+#elif defined(__linux__)
+    // Private anonymous pages read back as zero after being discarded.
+    madvise(inner_begin, inner_size, MADV_DONTNEED);
+#else
+    mmap(inner_begin, inner_size, PROT_READ | PROT_WRITE,
+         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+#endif
+}
+
+} // namespace Common
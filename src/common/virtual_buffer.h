@@ -0,0 +1,126 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Common {
+
+/**
+ * Reserves a zero-filled range of host pages. Pages are only backed by host memory once they are
+ * written to, so reserving large ranges which are mostly left untouched is cheap.
+ *
+ * @note On Windows, pages are committed by a fault handler on their first access, reads included.
+ */
+void* AllocateMemoryPages(std::size_t size);
+
+/// Releases a range reserved with AllocateMemoryPages.
+void FreeMemoryPages(void* base, std::size_t size);
+
+/**
+ * Resets a range of memory reserved with AllocateMemoryPages to zero. Pages entirely covered by
+ * the range are handed back to the host, as if they had never been written to.
+ */
+void ZeroMemoryPages(void* base, std::size_t size);
+
+/**
+ * Fixed-size, zero-initialized array of trivial elements, backed by AllocateMemoryPages. Pages that
+ * are never accessed take no host memory, so it suits huge tables of which only a small part is
+ * ever used.
+ */
+template <typename T>
+class VirtualBuffer final {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "T must be trivially copyable and destructible");
+
+public:
+    constexpr VirtualBuffer() = default;
+
+    explicit VirtualBuffer(std::size_t count) : alloc_size{count * sizeof(T)} {
+        if (count != 0) {
+            base_ptr = static_cast<T*>(AllocateMemoryPages(alloc_size));
+        }
+    }
+
+    ~VirtualBuffer() {
+        if (base_ptr != nullptr) {
+            FreeMemoryPages(base_ptr, alloc_size);
+        }
+    }
+
+    VirtualBuffer(const VirtualBuffer&) = delete;
+    VirtualBuffer& operator=(const VirtualBuffer&) = delete;
+
+    VirtualBuffer(VirtualBuffer&& other) noexcept
+        : alloc_size{std::exchange(other.alloc_size, 0)}, base_ptr{std::exchange(other.base_ptr,
+                                                                                 nullptr)} {}
+
+    VirtualBuffer& operator=(VirtualBuffer&& other) noexcept {
+        if (this != &other) {
+            if (base_ptr != nullptr) {
+                FreeMemoryPages(base_ptr, alloc_size);
+            }
+            alloc_size = std::exchange(other.alloc_size, 0);
+            base_ptr = std::exchange(other.base_ptr, nullptr);
+        }
+        return *this;
+    }
+
+    /// Reallocates the buffer to hold the given number of elements. Previous contents are lost.
+    void resize(std::size_t count) {
+        *this = VirtualBuffer{count};
+    }
+
+    /// Resets the elements in [first, last) to zero, releasing the host memory backing them.
+    void Zero(std::size_t first, std::size_t last) {
+        if (first < last) {
+            ZeroMemoryPages(base_ptr + first, (last - first) * sizeof(T));
+        }
+    }
+
+    T& operator[](std::size_t index) {
+        return base_ptr[index];
+    }
+
+    const T& operator[](std::size_t index) const {
+        return base_ptr[index];
+    }
+
+    T* data() {
+        return base_ptr;
+    }
+
+    const T* data() const {
+        return base_ptr;
+    }
+
+    T* begin() {
+        return base_ptr;
+    }
+
+    const T* begin() const {
+        return base_ptr;
+    }
+
+    T* end() {
+        return base_ptr + size();
+    }
+
+    const T* end() const {
+        return base_ptr + size();
+    }
+
+    std::size_t size() const {
+        return alloc_size / sizeof(T);
+    }
+
+private:
+    std::size_t alloc_size{};
+    T* base_ptr{};
+};
+
+} // namespace Common
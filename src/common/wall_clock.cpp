@@ -0,0 +1,52 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/uint128.h"
+#include "common/wall_clock.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include "common/x64/cpu_detect.h"
+#include "common/x64/native_clock.h"
+#endif
+
+namespace Common {
+
+namespace {
+
+class StandardWallClock final : public WallClock {
+public:
+    explicit StandardWallClock(u64 emulated_clock_frequency)
+        : WallClock(emulated_clock_frequency, false), start_time{Clock::now()} {}
+
+    std::chrono::nanoseconds GetTimeNS() const override {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_time);
+    }
+
+    std::chrono::microseconds GetTimeUS() const override {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start_time);
+    }
+
+    u64 GetClockCycles() const override {
+        const u128 temp = Multiply64Into128(GetTimeNS().count(), emulated_clock_frequency);
+        return Divide128On32(temp, 1000000000).first;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point start_time;
+};
+
+} // Anonymous namespace
+
+std::unique_ptr<WallClock> CreateBestMatchingClock(u64 emulated_clock_frequency) {
+#ifdef ARCHITECTURE_x86_64
+    if (GetCPUCaps().invariant_tsc) {
+        return std::make_unique<X64::NativeClock>(emulated_clock_frequency);
+    }
+#endif
+    return std::make_unique<StandardWallClock>(emulated_clock_frequency);
+}
+
+} // namespace Common
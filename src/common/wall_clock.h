@@ -0,0 +1,51 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Monotonic host clock, measuring the time elapsed since its creation.
+class WallClock {
+public:
+    virtual ~WallClock() = default;
+
+    /// Returns the elapsed time in nanoseconds.
+    virtual std::chrono::nanoseconds GetTimeNS() const = 0;
+
+    /// Returns the elapsed time in microseconds.
+    virtual std::chrono::microseconds GetTimeUS() const = 0;
+
+    /// Returns the elapsed time in emulated clock cycles.
+    virtual u64 GetClockCycles() const = 0;
+
+    /// Whether the clock reads a hardware counter of the host CPU directly.
+    bool IsNative() const {
+        return is_native;
+    }
+
+protected:
+    WallClock(u64 emulated_clock_frequency, bool is_native)
+        : emulated_clock_frequency{emulated_clock_frequency}, is_native{is_native} {}
+
+    u64 emulated_clock_frequency;
+
+private:
+    bool is_native;
+};
+
+/**
+ * Creates the most precise wall clock available on the host, which is a calibrated invariant TSC
+ * on x86-64 and the standard steady clock otherwise.
+ *
+ * @param emulated_clock_frequency Frequency of the clock GetClockCycles counts in, in Hz.
+ */
+std::unique_ptr<WallClock> CreateBestMatchingClock(u64 emulated_clock_frequency);
+
+} // namespace Common
@@ -24,6 +24,7 @@ struct CPUCaps {
     bool fma;
     bool fma4;
     bool aes;
+    bool invariant_tsc;
 };
 
 /**
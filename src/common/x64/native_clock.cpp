@@ -0,0 +1,75 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <thread>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#include "common/uint128.h"
+#include "common/x64/native_clock.h"
+
+namespace Common::X64 {
+
+namespace {
+
+u64 ReadTSC() {
+    // Keep earlier loads from being reordered past the read.
+    _mm_lfence();
+    return __rdtsc();
+}
+
+/// Measures the TSC against the steady clock for a short while.
+u64 EstimateTSCFrequency() {
+    constexpr std::chrono::milliseconds calibration_time{50};
+
+    const auto start_time = std::chrono::steady_clock::now();
+    const u64 start_ticks = ReadTSC();
+    std::this_thread::sleep_for(calibration_time);
+    const auto end_time = std::chrono::steady_clock::now();
+    const u64 end_ticks = ReadTSC();
+
+    const u64 elapsed_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+    const u128 temp = Multiply64Into128(end_ticks - start_ticks, 1000000000);
+    return Divide128On32(temp, static_cast<u32>(elapsed_ns)).first;
+}
+
+/// Applies a 32.32 fixed point factor.
+u64 MultiplyFixed(u64 value, u64 factor) {
+    const u128 product = Multiply64Into128(value, factor);
+    return (product[1] << 32) | (product[0] >> 32);
+}
+
+} // Anonymous namespace
+
+NativeClock::NativeClock(u64 emulated_clock_frequency)
+    : WallClock(emulated_clock_frequency, true) {
+    const u64 tsc_frequency = EstimateTSCFrequency();
+    ns_factor = (u64{1000000000} << 32) / tsc_frequency;
+    cycles_factor = (emulated_clock_frequency << 32) / tsc_frequency;
+    start_ticks = ReadTSC();
+}
+
+std::chrono::nanoseconds NativeClock::GetTimeNS() const {
+    return std::chrono::nanoseconds{MultiplyFixed(GetElapsedTicks(), ns_factor)};
+}
+
+std::chrono::microseconds NativeClock::GetTimeUS() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(GetTimeNS());
+}
+
+u64 NativeClock::GetClockCycles() const {
+    return MultiplyFixed(GetElapsedTicks(), cycles_factor);
+}
+
+u64 NativeClock::GetElapsedTicks() const {
+    return ReadTSC() - start_ticks;
+}
+
+} // namespace Common::X64
@@ -0,0 +1,31 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/wall_clock.h"
+
+namespace Common::X64 {
+
+/// Wall clock reading the invariant TSC, whose frequency is calibrated on construction.
+class NativeClock final : public WallClock {
+public:
+    explicit NativeClock(u64 emulated_clock_frequency);
+
+    std::chrono::nanoseconds GetTimeNS() const override;
+
+    std::chrono::microseconds GetTimeUS() const override;
+
+    u64 GetClockCycles() const override;
+
+private:
+    u64 GetElapsedTicks() const;
+
+    u64 start_ticks;
+    // 32.32 fixed point factors converting TSC ticks to nanoseconds and to emulated cycles.
+    u64 ns_factor;
+    u64 cycles_factor;
+};
+
+} // namespace Common::X64
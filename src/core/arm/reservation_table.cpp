@@ -0,0 +1,20 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "core/arm/reservation_table.h"
+
+namespace Core {
+
+ReservationTable::ReservationTable(std::size_t num_cores)
+    : reservations{std::make_unique<Reservation[]>(num_cores)}, num_cores{num_cores} {}
+
+ReservationTable::~ReservationTable() = default;
+
+void ReservationTable::ClearAll() {
+    for (std::size_t core = 0; core < num_cores; ++core) {
+        Clear(core);
+    }
+}
+
+} // namespace Core
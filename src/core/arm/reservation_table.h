@@ -0,0 +1,118 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "common/common_types.h"
+
+namespace Core {
+
+/**
+ * Lock-free tracking of exclusive reservations, as set up by LDXR and consumed by STXR.
+ *
+ * Reservations are tracked per cache line. Every line hashes to a version counter that is bumped
+ * by each successful exclusive store to it; a core's reservation remembers the version it saw
+ * when marking the line, and an exclusive store only succeeds if the version is unchanged. While
+ * a store is in flight the version is odd, which makes concurrent stores to the same line fail
+ * without taking a lock. Distinct lines may share a counter, which only causes spurious failures,
+ * and those are permitted by the architecture.
+ */
+class ReservationTable {
+public:
+    explicit ReservationTable(std::size_t num_cores);
+    ~ReservationTable();
+
+    ReservationTable(const ReservationTable&) = delete;
+    ReservationTable& operator=(const ReservationTable&) = delete;
+
+    ReservationTable(ReservationTable&&) = delete;
+    ReservationTable& operator=(ReservationTable&&) = delete;
+
+    /**
+     * Marks the cache line containing an address as reserved by a core, replacing any reservation
+     * the core previously held.
+     *
+     * @param core_index The core taking the reservation.
+     * @param addr       The guest address being reserved.
+     */
+    void Mark(std::size_t core_index, VAddr addr) {
+        const VAddr line = addr >> CACHE_LINE_BITS;
+        Reservation& reservation = reservations[core_index];
+
+        // An odd version means a store to the line is in flight; reserving the version preceding
+        // it guarantees that the reservation is lost, since that store is ordered after the read.
+        reservation.version = GetLineVersion(line).load(std::memory_order_acquire) & ~u64{1};
+        reservation.line.store(line, std::memory_order_release);
+    }
+
+    /**
+     * Performs an exclusive store if the core still holds a reservation on the cache line of the
+     * given address. The reservation is consumed either way.
+     *
+     * @param core_index The core performing the store.
+     * @param addr       The guest address being stored to.
+     * @param op         Function performing the actual store.
+     *
+     * @returns true if the reservation was held and op was called.
+     */
+    template <typename Function>
+    bool DoExclusiveOperation(std::size_t core_index, VAddr addr, Function&& op) {
+        const VAddr line = addr >> CACHE_LINE_BITS;
+        Reservation& reservation = reservations[core_index];
+
+        if (reservation.line.exchange(INVALID_LINE, std::memory_order_acquire) != line) {
+            return false;
+        }
+
+        std::atomic<u64>& version = GetLineVersion(line);
+        u64 expected = reservation.version;
+        if (!version.compare_exchange_strong(expected, expected | 1, std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+            return false;
+        }
+        op();
+        version.store(expected + 2, std::memory_order_release);
+        return true;
+    }
+
+    /// Drops the reservation held by a core.
+    void Clear(std::size_t core_index) {
+        reservations[core_index].line.store(INVALID_LINE, std::memory_order_release);
+    }
+
+    /// Drops the reservations held by every core.
+    void ClearAll();
+
+private:
+    static constexpr std::size_t CACHE_LINE_BITS = 6;
+    static constexpr std::size_t NUM_LINE_VERSIONS = 1024;
+    static constexpr VAddr INVALID_LINE = ~VAddr{0};
+
+    /// Per-core reservation. Only touched by its core, except for ClearAll.
+    struct alignas(64) Reservation {
+        std::atomic<VAddr> line{INVALID_LINE};
+        u64 version = 0;
+    };
+
+    /// Padded so that cores spinning on different lines do not share host cache lines.
+    struct alignas(64) LineVersion {
+        std::atomic<u64> value{0};
+    };
+
+    std::atomic<u64>& GetLineVersion(VAddr line) {
+        // Fold the upper bits in, so that lines a power of two apart do not always collide.
+        const VAddr hash = line ^ (line >> 10) ^ (line >> 20);
+        return line_versions[hash % NUM_LINE_VERSIONS].value;
+    }
+
+    std::unique_ptr<Reservation[]> reservations;
+    std::size_t num_cores;
+    std::array<LineVersion, NUM_LINE_VERSIONS> line_versions{};
+};
+
+} // namespace Core
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "common/file_util.h"
+#include "common/host_memory.h"
 #include "common/logging/log.h"
 #include "common/string_util.h"
 #include "core/arm/exclusive_monitor.h"
@@ -22,7 +23,9 @@
 #include "core/file_sys/romfs_factory.h"
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/sdmc_factory.h"
+#include "core/file_sys/vfs_cached.h"
 #include "core/file_sys/vfs_concat.h"
+#include "core/file_sys/vfs_readahead.h"
 #include "core/file_sys/vfs_real.h"
 #include "core/frontend/scope_acquire_context.h"
 #include "core/gdbstub/gdbstub.h"
@@ -32,9 +35,11 @@
 #include "core/hle/kernel/physical_core.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/scheduler.h"
+#include "core/hle/kernel/svc_stats.h"
 #include "core/hle/kernel/thread.h"
 #include "core/hle/service/am/applets/applets.h"
 #include "core/hle/service/apm/controller.h"
+#include "core/hle/service/command_stats.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/hle/service/glue/manager.h"
 #include "core/hle/service/lm/manager.h"
@@ -141,8 +146,14 @@ struct System::Impl {
     ResultStatus Init(System& system, Frontend::EmuWindow& emu_window) {
         LOG_DEBUG(HW_Memory, "initialized OK");
 
+        // Huge pages only apply to process memory allocated after this point.
+        Common::SetHugePagesEnabled(Settings::values.use_huge_pages);
+
+        core_timing.SetHostTiming(Settings::values.use_host_timing);
+        core_timing.SetMulticore(Settings::values.use_multi_core);
         core_timing.Initialize();
         kernel.Initialize();
+        kernel.SVCStats().SetEnabled(Settings::values.record_svc_stats);
         cpu_manager.Initialize();
 
         const auto current_time = std::chrono::duration_cast<std::chrono::seconds>(
@@ -268,6 +279,42 @@ struct System::Impl {
 
         lm_manager.Flush();
 
+        if (Settings::values.record_service_stats) {
+            service_command_stats.LogSummary(20);
+            service_command_stats.Reset();
+        }
+
+        if (kernel.SVCStats().IsEnabled()) {
+            kernel.SVCStats().LogSummary(20);
+            kernel.SVCStats().Reset();
+        }
+
+        if (Settings::values.use_huge_pages) {
+            const auto huge_page_stats = Common::GetHugePageStats();
+            LOG_INFO(Core,
+                     "Huge pages: {} MiB reserved, {} MiB transparent, {} MiB advised but not "
+                     "promoted, {} MiB regular, {} TLB entries cover what would take {} with "
+                     "regular pages",
+                     huge_page_stats.reserved_bytes >> 20, huge_page_stats.transparent_bytes >> 20,
+                     huge_page_stats.advised_bytes >> 20, huge_page_stats.regular_bytes >> 20,
+                     huge_page_stats.HugePageCount(), huge_page_stats.RegularPageCount());
+        }
+
+        const auto cache_stats = FileSys::CachedVfsFile::GetTotalStats();
+        if (cache_stats.hits + cache_stats.misses + cache_stats.bypassed_reads != 0) {
+            LOG_INFO(Core, "Decrypted block cache: {} hits, {} misses, {} bypassed reads",
+                     cache_stats.hits, cache_stats.misses, cache_stats.bypassed_reads);
+            FileSys::CachedVfsFile::ResetTotalStats();
+        }
+
+        const auto readahead_stats = FileSys::ReadaheadVfsFile::GetTotalStats();
+        if (readahead_stats.hits + readahead_stats.misses != 0) {
+            LOG_INFO(Core, "Readahead: {} hits, {} misses, {} MiB prefetched",
+                     readahead_stats.hits, readahead_stats.misses,
+                     readahead_stats.prefetched_bytes >> 20);
+            FileSys::ReadaheadVfsFile::ResetTotalStats();
+        }
+
         is_powered_on = false;
         exit_lock = false;
 
@@ -374,6 +421,7 @@ struct System::Impl {
     /// Service State
     Service::Glue::ARPManager arp_manager;
     Service::LM::Manager lm_manager{reporter};
+    Service::CommandStatsRegistry service_command_stats;
 
     /// Service manager
     std::shared_ptr<Service::SM::ServiceManager> service_manager;
@@ -678,6 +726,14 @@ const Service::LM::Manager& System::GetLogManager() const {
     return impl->lm_manager;
 }
 
+Service::CommandStatsRegistry& System::GetServiceCommandStats() {
+    return impl->service_command_stats;
+}
+
+const Service::CommandStatsRegistry& System::GetServiceCommandStats() const {
+    return impl->service_command_stats;
+}
+
 void System::SetExitLock(bool locked) {
     impl->exit_lock = locked;
 }
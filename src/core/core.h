@@ -67,6 +67,8 @@ namespace SM {
 class ServiceManager;
 } // namespace SM
 
+class CommandStatsRegistry;
+
 } // namespace Service
 
 namespace Tegra {
@@ -352,6 +354,13 @@ public:
 
     const Service::LM::Manager& GetLogManager() const;
 
+    /// Provides a reference to the statistics of the service commands, recorded when
+    /// Settings::values.record_service_stats is enabled.
+    Service::CommandStatsRegistry& GetServiceCommandStats();
+
+    /// Provides a constant reference to the statistics of the service commands.
+    const Service::CommandStatsRegistry& GetServiceCommandStats() const;
+
     void SetExitLock(bool locked);
 
     bool GetExitLock() const;
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 
@@ -20,6 +21,11 @@
 
 namespace Core {
 
+namespace {
+// How long an idle core sleeps in multicore mode before checking for work on its own.
+constexpr std::chrono::microseconds MULTICORE_IDLE_TIMEOUT{1000};
+} // Anonymous namespace
+
 CoreManager::CoreManager(System& system, std::size_t core_index)
     : global_scheduler{system.GlobalScheduler()}, physical_core{system.Kernel().PhysicalCore(
                                                       core_index)},
@@ -34,7 +40,12 @@ void CoreManager::RunLoop(bool tight_loop) {
     // instead advance to the next event and try to yield to the next thread
     if (Kernel::GetCurrentThread() == nullptr) {
         LOG_TRACE(Core, "Core-{} idling", core_index);
-        core_timing.Idle();
+        if (core_timing.IsMulticore()) {
+            // Time does not depend on this core, wait for the scheduler or an event to kick it.
+            physical_core.WaitForInterrupt(MULTICORE_IDLE_TIMEOUT);
+        } else {
+            core_timing.Idle();
+        }
     } else {
         if (tight_loop) {
             physical_core.Run();
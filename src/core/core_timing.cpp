@@ -5,12 +5,16 @@
 #include "core/core_timing.h"
 
 #include <algorithm>
-#include <mutex>
+#include <array>
+#include <limits>
 #include <string>
 #include <tuple>
+#include <unordered_map>
+#include <utility>
 
 #include "common/assert.h"
 #include "common/thread.h"
+#include "common/wall_clock.h"
 #include "core/core_timing_util.h"
 #include "core/hardware_properties.h"
 
@@ -18,6 +22,19 @@ namespace Core::Timing {
 
 constexpr int MAX_SLICE_LENGTH = 10000;
 
+// With host timing, slices are measured in host time, which runs much faster than the emulated
+// CPU executes, so they have to be longer for the timer thread not to interrupt constantly.
+constexpr s64 HOST_SLICE_LENGTH = Hardware::BASE_CLOCK_RATE / 2000; // 500us
+
+// With host timing, the CPU is only interrupted by the timer thread, so it is given a downcount
+// that does not run out in practice.
+constexpr s64 HOST_TIMING_DOWNCOUNT = std::numeric_limits<s32>::max();
+
+constexpr s64 NO_DEADLINE = std::numeric_limits<s64>::max();
+
+// Longest single wait of the timer thread, to keep cycle to time conversions from overflowing.
+constexpr s64 MAX_HOST_WAIT = Hardware::BASE_CLOCK_RATE;
+
 std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callback) {
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
@@ -27,6 +44,8 @@ struct CoreTiming::Event {
     u64 fifo_order;
     u64 userdata;
     std::weak_ptr<EventType> type;
+    // Identifies the event type for cancellation, even after the type itself has expired.
+    const EventType* type_key;
 
     // Sort by time, unless the times are the same, in which case sort by
     // the order added to the queue
@@ -39,8 +58,464 @@ struct CoreTiming::Event {
     }
 };
 
-CoreTiming::CoreTiming() = default;
-CoreTiming::~CoreTiming() = default;
+/// A request posted to the inbox. For unscheduling requests, only the type, userdata and fifo
+/// order of the event are meaningful, the latter being the cancellation point.
+struct CoreTiming::Command {
+    enum class Type {
+        Schedule,
+        Unschedule,
+        Remove,
+    };
+
+    Type type{};
+    Event event{};
+};
+
+/**
+ * Lock-free multiple producer, single consumer queue of commands, using Dmitry Vyukov's intrusive
+ * MPSC queue algorithm. Pushing is wait-free; popping may transiently see the queue as empty while
+ * a producer is midway through a push, in which case its command is picked up on the next drain.
+ *
+ * Nodes are allocated in chunks owned by the inbox and recycled. Drained nodes go to a free list,
+ * which a producer running out of nodes takes as a whole into a cache of its own thread, so that
+ * nodes are only ever popped by a single thread and the free list is safe from ABA.
+ */
+class CoreTiming::Inbox {
+public:
+    Inbox() = default;
+
+    ~Inbox() {
+        Chunk* chunk = chunks.load();
+        while (chunk != nullptr) {
+            delete std::exchange(chunk, chunk->next);
+        }
+    }
+
+    Inbox(const Inbox&) = delete;
+    Inbox& operator=(const Inbox&) = delete;
+
+    void Push(Command&& command) {
+        Node* const node = AllocateNode();
+        node->command = std::move(command);
+        Link(node);
+    }
+
+    /// Whether every command pushed so far has been drained. Consumer only.
+    bool IsEmpty() const {
+        return tail == &stub && head.load() == &stub;
+    }
+
+    /// Calls func with every command currently in the inbox, in push order. Consumer only.
+    template <typename Func>
+    void Drain(Func&& func) {
+        while (Node* const node = Pop()) {
+            func(std::move(node->command));
+            FreeNode(node);
+        }
+    }
+
+private:
+    struct Node {
+        Command command;
+        // Next node in the queue, or in the free list once drained.
+        std::atomic<Node*> next{nullptr};
+    };
+
+    static constexpr std::size_t CHUNK_NODES = 64;
+
+    struct Chunk {
+        std::array<Node, CHUNK_NODES> nodes;
+        Chunk* next = nullptr;
+    };
+
+    /// Nodes cached by a producer thread, along with the inbox they were taken from.
+    struct NodeCache {
+        u64 inbox_id = 0;
+        Node* nodes = nullptr;
+    };
+
+    Node* AllocateNode() {
+        // Nodes cached for another inbox stay owned by it, they are simply forgotten.
+        thread_local NodeCache cache;
+        if (cache.inbox_id != id) {
+            cache = {id, nullptr};
+        }
+        if (cache.nodes == nullptr) {
+            cache.nodes = free_nodes.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (cache.nodes == nullptr) {
+            cache.nodes = AllocateChunk();
+        }
+        Node* const node = cache.nodes;
+        cache.nodes = node->next.load(std::memory_order_relaxed);
+        return node;
+    }
+
+    /// Allocates a chunk of nodes and returns them linked together.
+    Node* AllocateChunk() {
+        auto* const chunk = new Chunk;
+        for (std::size_t i = 0; i + 1 < CHUNK_NODES; ++i) {
+            chunk->nodes[i].next.store(&chunk->nodes[i + 1], std::memory_order_relaxed);
+        }
+        chunk->next = chunks.load(std::memory_order_relaxed);
+        while (!chunks.compare_exchange_weak(chunk->next, chunk, std::memory_order_relaxed)) {
+        }
+        return &chunk->nodes[0];
+    }
+
+    void FreeNode(Node* node) {
+        Node* first = free_nodes.load(std::memory_order_relaxed);
+        do {
+            node->next.store(first, std::memory_order_relaxed);
+        } while (!free_nodes.compare_exchange_weak(first, node, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+    }
+
+    void Link(Node* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* const previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    Node* Pop() {
+        Node* current = tail;
+        Node* next = current->next.load(std::memory_order_acquire);
+        if (current == &stub) {
+            if (next == nullptr) {
+                return nullptr;
+            }
+            tail = next;
+            current = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next != nullptr) {
+            tail = next;
+            return current;
+        }
+        if (current != head.load(std::memory_order_acquire)) {
+            // A producer has swapped the head but not linked its node yet.
+            return nullptr;
+        }
+        // current is the last node, put the stub back behind it so it can be detached.
+        Link(&stub);
+        next = current->next.load(std::memory_order_acquire);
+        if (next != nullptr) {
+            tail = next;
+            return current;
+        }
+        return nullptr;
+    }
+
+    Node stub;
+    std::atomic<Node*> head{&stub};
+    Node* tail = &stub;
+
+    /// Identifies the inbox in the caches of the producer threads, never reused.
+    static inline std::atomic<u64> next_id{1};
+    const u64 id = next_id++;
+    /// Every chunk of nodes, released on destruction.
+    std::atomic<Chunk*> chunks{nullptr};
+    /// Drained nodes, pushed by the consumer and taken as a whole by producers.
+    std::atomic<Node*> free_nodes{nullptr};
+};
+
+/**
+ * Pending events, kept in a hierarchical timing wheel backed by a heap for far-future events.
+ *
+ * Each level of the wheel has NUM_SLOTS slots, a slot of level L spanning 2^LevelShift(L) cycles.
+ * Events are filed into the lowest level whose current rotation contains their time, and cascade
+ * down a level whenever the wheel reaches their slot. Events before the wheel time are moved to a
+ * small heap, from which they are dispatched in time and insertion order. Events beyond the last
+ * level's rotation (about 17 seconds) wait in a heap until the wheel comes around.
+ *
+ * Cancellation is lazy: unscheduling only records a cancellation point per event type and
+ * userdata, and events scheduled before it are discarded when they come up. As the events being
+ * cancelled may still be on their way through the inbox, cancellation points are kept until every
+ * command issued before them has been applied, even when no event is pending for them.
+ */
+class CoreTiming::EventQueue {
+public:
+    void Push(Event&& event) {
+        TypeState& type_state = states[event.type_key];
+        ++type_state.pending;
+        ++type_state.userdata[event.userdata].pending;
+        Insert(std::move(event));
+    }
+
+    /// Cancels the events of a type with the given userdata that were scheduled before barrier.
+    void Cancel(const EventType* type, u64 userdata, u64 barrier) {
+        UserdataState& userdata_state = states[type].userdata[userdata];
+        userdata_state.barrier = std::max(userdata_state.barrier, barrier);
+        if (userdata_state.pending == 0) {
+            idle_states.emplace_back(type, userdata);
+        }
+    }
+
+    /// Cancels all events of a type that were scheduled before barrier.
+    void Cancel(const EventType* type, u64 barrier) {
+        TypeState& type_state = states[type];
+        type_state.barrier = std::max(type_state.barrier, barrier);
+        if (type_state.pending == 0) {
+            idle_states.emplace_back(type, std::nullopt);
+        }
+    }
+
+    /// Drops the cancellation points of types and userdata without pending events. Every command
+    /// issued so far must have been applied.
+    void ReleaseBarriers(u64 fifo_order) {
+        applied_fifo_order = fifo_order;
+        for (const auto& [type, userdata] : idle_states) {
+            const auto type_it = states.find(type);
+            if (type_it == states.end()) {
+                continue;
+            }
+            TypeState& type_state = type_it->second;
+            if (userdata) {
+                const auto userdata_it = type_state.userdata.find(*userdata);
+                if (userdata_it != type_state.userdata.end() && userdata_it->second.pending == 0) {
+                    type_state.userdata.erase(userdata_it);
+                }
+            }
+            if (type_state.pending == 0 && type_state.userdata.empty()) {
+                states.erase(type_it);
+            }
+        }
+        idle_states.clear();
+    }
+
+    /// Removes the earliest event due at or before the given time.
+    std::optional<Event> PopDue(s64 time) {
+        Expire(time);
+        while (!ready.empty() && ready.front().time <= time) {
+            Event event = PopHeap(ready);
+            if (Retire(event)) {
+                return event;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// Returns the time of the earliest pending event.
+    std::optional<s64> NextEventTime() {
+        while (!ready.empty()) {
+            if (IsLive(ready.front())) {
+                return ready.front().time;
+            }
+            Retire(PopHeap(ready));
+        }
+        for (u32 level = 0; level < NUM_LEVELS; ++level) {
+            if (level_sizes[level] == 0) {
+                continue;
+            }
+            for (std::size_t slot = SlotIndex(wheel_time, level); slot < NUM_SLOTS; ++slot) {
+                const Bucket& bucket = levels[level][slot];
+                if (!bucket.empty()) {
+                    return std::min_element(bucket.begin(), bucket.end())->time;
+                }
+            }
+        }
+        if (!far_events.empty()) {
+            return far_events.front().time;
+        }
+        return std::nullopt;
+    }
+
+    void Clear() {
+        for (auto& level : levels) {
+            for (Bucket& bucket : level) {
+                bucket.clear();
+            }
+        }
+        level_sizes.fill(0);
+        ready.clear();
+        far_events.clear();
+        far_compaction_size = MIN_FAR_COMPACTION_SIZE;
+        states.clear();
+        applied_fifo_order = 0;
+        idle_states.clear();
+        wheel_time = 0;
+    }
+
+private:
+    static constexpr u32 GRANULARITY_BITS = 10;
+    static constexpr u32 SLOT_BITS = 8;
+    static constexpr std::size_t NUM_SLOTS = std::size_t{1} << SLOT_BITS;
+    static constexpr u32 NUM_LEVELS = 3;
+    static constexpr std::size_t MIN_FAR_COMPACTION_SIZE = 1024;
+
+    using Bucket = std::vector<Event>;
+
+    struct UserdataState {
+        u64 pending = 0;
+        u64 barrier = 0;
+    };
+
+    struct TypeState {
+        u64 pending = 0;
+        u64 barrier = 0;
+        std::unordered_map<u64, UserdataState> userdata;
+    };
+
+    static constexpr u32 LevelShift(u32 level) {
+        return GRANULARITY_BITS + level * SLOT_BITS;
+    }
+
+    static constexpr std::size_t SlotIndex(u64 time, u32 level) {
+        return static_cast<std::size_t>(time >> LevelShift(level)) & (NUM_SLOTS - 1);
+    }
+
+    static constexpr bool IsAligned(u64 time, u32 level) {
+        return (time & ((u64{1} << LevelShift(level)) - 1)) == 0;
+    }
+
+    static Event PopHeap(std::vector<Event>& heap) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+        Event event = std::move(heap.back());
+        heap.pop_back();
+        return event;
+    }
+
+    static void PushHeap(std::vector<Event>& heap, Event&& event) {
+        heap.push_back(std::move(event));
+        std::push_heap(heap.begin(), heap.end(), std::greater<>());
+    }
+
+    /// Files an event into the ready heap, the wheel or the far heap, depending on its time.
+    void Insert(Event&& event) {
+        if (event.time < static_cast<s64>(wheel_time)) {
+            PushHeap(ready, std::move(event));
+            return;
+        }
+        const u64 time = static_cast<u64>(event.time);
+        for (u32 level = 0; level < NUM_LEVELS; ++level) {
+            if ((time >> LevelShift(level + 1)) == (wheel_time >> LevelShift(level + 1))) {
+                levels[level][SlotIndex(time, level)].push_back(std::move(event));
+                ++level_sizes[level];
+                return;
+            }
+        }
+        PushHeap(far_events, std::move(event));
+        if (far_events.size() >= far_compaction_size) {
+            CompactFarEvents();
+        }
+    }
+
+    /// Turns the wheel up to the given time, moving every event up to it to the ready heap.
+    void Expire(s64 time) {
+        if (time < static_cast<s64>(wheel_time)) {
+            return;
+        }
+        const u64 end = ((static_cast<u64>(time) >> LevelShift(0)) + 1) << LevelShift(0);
+        while (wheel_time < end) {
+            Bucket& bucket = levels[0][SlotIndex(wheel_time, 0)];
+            level_sizes[0] -= bucket.size();
+            for (Event& event : bucket) {
+                PushHeap(ready, std::move(event));
+            }
+            bucket.clear();
+
+            // Skip straight to the next slot of the lowest level that has anything to cascade.
+            u32 level = 0;
+            while (level < NUM_LEVELS && level_sizes[level] == 0) {
+                ++level;
+            }
+            const u32 shift = LevelShift(level);
+            wheel_time = std::min(((wheel_time >> shift) + 1) << shift, end);
+            Cascade();
+        }
+    }
+
+    /// Redistributes the slots the wheel just reached into the levels below them.
+    void Cascade() {
+        if (IsAligned(wheel_time, NUM_LEVELS)) {
+            while (!far_events.empty() &&
+                   (static_cast<u64>(far_events.front().time) >> LevelShift(NUM_LEVELS)) ==
+                       (wheel_time >> LevelShift(NUM_LEVELS))) {
+                Insert(PopHeap(far_events));
+            }
+        }
+        for (u32 level = NUM_LEVELS - 1; level > 0; --level) {
+            if (!IsAligned(wheel_time, level)) {
+                continue;
+            }
+            Bucket bucket = std::move(levels[level][SlotIndex(wheel_time, level)]);
+            levels[level][SlotIndex(wheel_time, level)].clear();
+            level_sizes[level] -= bucket.size();
+            for (Event& event : bucket) {
+                Insert(std::move(event));
+            }
+        }
+    }
+
+    /// Drops cancelled events from the far heap, which could otherwise grow without bound.
+    void CompactFarEvents() {
+        const auto live_end = std::partition(far_events.begin(), far_events.end(),
+                                             [this](const Event& event) { return IsLive(event); });
+        std::for_each(live_end, far_events.end(), [this](const Event& event) { Retire(event); });
+        far_events.erase(live_end, far_events.end());
+        std::make_heap(far_events.begin(), far_events.end(), std::greater<>());
+        far_compaction_size = std::max(MIN_FAR_COMPACTION_SIZE, far_events.size() * 2);
+    }
+
+    bool IsLive(const Event& event) const {
+        const TypeState& type_state = states.at(event.type_key);
+        return event.fifo_order >= type_state.barrier &&
+               event.fifo_order >= type_state.userdata.at(event.userdata).barrier;
+    }
+
+    /// Releases the bookkeeping of an event leaving the queue. Returns whether it was live.
+    bool Retire(const Event& event) {
+        const auto type_it = states.find(event.type_key);
+        ASSERT(type_it != states.end());
+        TypeState& type_state = type_it->second;
+        const auto userdata_it = type_state.userdata.find(event.userdata);
+        ASSERT(userdata_it != type_state.userdata.end());
+
+        const bool is_live = event.fifo_order >= type_state.barrier &&
+                             event.fifo_order >= userdata_it->second.barrier;
+        if (--userdata_it->second.pending == 0) {
+            if (IsBarrierNeeded(userdata_it->second.barrier)) {
+                idle_states.emplace_back(event.type_key, event.userdata);
+            } else {
+                type_state.userdata.erase(userdata_it);
+            }
+        }
+        if (--type_state.pending == 0) {
+            if (IsBarrierNeeded(type_state.barrier)) {
+                idle_states.emplace_back(event.type_key, std::nullopt);
+            } else if (type_state.userdata.empty()) {
+                states.erase(type_it);
+            }
+        }
+        return is_live;
+    }
+
+    /// Whether events scheduled before a cancellation point may not have been applied yet.
+    bool IsBarrierNeeded(u64 barrier) const {
+        return barrier > applied_fifo_order;
+    }
+
+    std::array<std::array<Bucket, NUM_SLOTS>, NUM_LEVELS> levels;
+    std::array<std::size_t, NUM_LEVELS> level_sizes{};
+    // Min-heaps using std::make_heap/push_heap/pop_heap.
+    std::vector<Event> ready;
+    std::vector<Event> far_events;
+    std::size_t far_compaction_size = MIN_FAR_COMPACTION_SIZE;
+    std::unordered_map<const EventType*, TypeState> states;
+    // Every command issued before this fifo order has been applied.
+    u64 applied_fifo_order = 0;
+    // Types and userdata without pending events whose cancellation points are kept in states.
+    std::vector<std::pair<const EventType*, std::optional<u64>>> idle_states;
+    // Every event before this time is in the ready heap.
+    u64 wheel_time = 0;
+};
+
+CoreTiming::CoreTiming()
+    : event_queue{std::make_unique<EventQueue>()}, inbox{std::make_unique<Inbox>()} {}
+
+CoreTiming::~CoreTiming() {
+    StopTimerThread();
+}
 
 void CoreTiming::Initialize() {
     downcounts.fill(MAX_SLICE_LENGTH);
@@ -57,45 +532,60 @@ void CoreTiming::Initialize() {
     is_global_timer_sane = true;
 
     event_fifo_id = 0;
+    drained_commands = 0;
 
     const auto empty_timed_callback = [](u64, s64) {};
     ev_lost = CreateEvent("_lost_event", empty_timed_callback);
+
+    if (use_multicore) {
+        use_host_timing = true;
+    }
+    if (use_host_timing) {
+        clock = Common::CreateBestMatchingClock(Hardware::BASE_CLOCK_RATE);
+        host_slice_start = 0;
+        host_deadline = NO_DEADLINE;
+        shutting_down = false;
+        timer_thread = std::thread(&CoreTiming::TimerThreadLoop, this);
+    }
 }
 
 void CoreTiming::Shutdown() {
+    StopTimerThread();
     ClearPendingEvents();
+    clock.reset();
+}
+
+void CoreTiming::SetInterruptHandler(std::function<void()> handler) {
+    std::lock_guard lock{handler_mutex};
+    interrupt_handler = std::move(handler);
 }
 
 void CoreTiming::ScheduleEvent(s64 cycles_into_future, const std::shared_ptr<EventType>& event_type,
                                u64 userdata) {
-    std::lock_guard guard{inner_mutex};
     const s64 timeout = GetTicks() + cycles_into_future;
 
     // If this event needs to be scheduled before the next advance(), force one early
-    if (!is_global_timer_sane) {
+    if (!use_host_timing && !is_global_timer_sane) {
         ForceExceptionCheck(cycles_into_future);
     }
 
-    event_queue.emplace_back(Event{timeout, event_fifo_id++, userdata, event_type});
+    inbox->Push({Command::Type::Schedule,
+                 Event{timeout, event_fifo_id++, userdata, event_type, event_type.get()}});
 
-    std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    if (use_host_timing) {
+        LowerHostDeadline(timeout);
+    }
 }
 
 void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type, u64 userdata) {
-    std::lock_guard guard{inner_mutex};
-
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get() && e.userdata == userdata;
-    });
-
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-    }
+    inbox->Push({Command::Type::Unschedule,
+                 Event{0, event_fifo_id++, userdata, {}, event_type.get()}});
 }
 
 u64 CoreTiming::GetTicks() const {
+    if (clock) {
+        return clock->GetClockCycles();
+    }
     u64 ticks = static_cast<u64>(global_timer);
     if (!is_global_timer_sane) {
         ticks += accumulated_ticks;
@@ -108,28 +598,130 @@ u64 CoreTiming::GetIdleTicks() const {
 }
 
 void CoreTiming::AddTicks(u64 ticks) {
+    if (use_host_timing) {
+        return;
+    }
     accumulated_ticks += ticks;
     downcounts[current_context] -= static_cast<s64>(ticks);
 }
 
 void CoreTiming::ClearPendingEvents() {
-    event_queue.clear();
+    inbox->Drain([this](Command&&) { ++drained_commands; });
+    event_queue->Clear();
 }
 
 void CoreTiming::RemoveEvent(const std::shared_ptr<EventType>& event_type) {
-    std::lock_guard guard{inner_mutex};
+    inbox->Push({Command::Type::Remove, Event{0, event_fifo_id++, 0, {}, event_type.get()}});
+}
 
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get();
+void CoreTiming::DrainInbox() {
+    inbox->Drain([this](Command&& command) {
+        Event& event = command.event;
+        switch (command.type) {
+        case Command::Type::Schedule:
+            event_queue->Push(std::move(event));
+            break;
+        case Command::Type::Unschedule:
+            event_queue->Cancel(event.type_key, event.userdata, event.fifo_order);
+            break;
+        case Command::Type::Remove:
+            event_queue->Cancel(event.type_key, event.fifo_order);
+            break;
+        }
+        ++drained_commands;
     });
 
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    // Each command takes a fifo order, once as many were drained as were issued, no command can
+    // still be on its way.
+    if (drained_commands == event_fifo_id.load()) {
+        event_queue->ReleaseBarriers(drained_commands);
+    }
+}
+
+void CoreTiming::StartHostSlice() {
+    host_slice_start = static_cast<s64>(GetTicks());
+    UpdateHostDeadline();
+}
+
+void CoreTiming::UpdateHostDeadline() {
+    {
+        std::lock_guard lock{timer_mutex};
+        do {
+            DrainInbox();
+            // Without slices, only events need the timer thread.
+            s64 deadline =
+                use_multicore ? NO_DEADLINE : host_slice_start + time_slice[current_context];
+            if (const auto next_event_time = event_queue->NextEventTime()) {
+                deadline = std::min(deadline, *next_event_time);
+            }
+            host_deadline = deadline;
+            // Anything posted since the drain either shows up here, or its poster sees the new
+            // deadline and lowers it.
+        } while (!inbox->IsEmpty());
+    }
+    timer_cv.notify_all();
+}
+
+void CoreTiming::LowerHostDeadline(s64 time) {
+    s64 deadline = host_deadline.load();
+    while (time < deadline) {
+        if (host_deadline.compare_exchange_weak(deadline, time)) {
+            // Synchronize with the waiters so that the wakeup cannot be missed.
+            { std::lock_guard lock{timer_mutex}; }
+            timer_cv.notify_all();
+            return;
+        }
     }
 }
 
+void CoreTiming::TimerThreadLoop() {
+    Common::SetCurrentThreadName("yuzu:CoreTiming");
+
+    std::unique_lock lock{timer_mutex};
+    while (!shutting_down) {
+        s64 deadline = host_deadline.load();
+        const s64 now = static_cast<s64>(GetTicks());
+        if (now < deadline) {
+            if (deadline == NO_DEADLINE) {
+                timer_cv.wait(lock);
+            } else {
+                timer_cv.wait_for(lock, CyclesToNs(std::min(deadline - now, MAX_HOST_WAIT)));
+            }
+            continue;
+        }
+
+        // Disarm until the emu thread has caught up and picked the next deadline.
+        if (!host_deadline.compare_exchange_strong(deadline, NO_DEADLINE)) {
+            continue;
+        }
+        // An idling emu thread is waiting for the deadline on its own.
+        if (is_idling) {
+            continue;
+        }
+        // The handler may schedule events or dispatch them, both of which take the timer mutex.
+        lock.unlock();
+        {
+            std::lock_guard handler_lock{handler_mutex};
+            if (interrupt_handler) {
+                interrupt_handler();
+            }
+        }
+        lock.lock();
+    }
+}
+
+void CoreTiming::StopTimerThread() {
+    if (!timer_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard lock{timer_mutex};
+        shutting_down = true;
+    }
+    timer_cv.notify_all();
+    timer_thread.join();
+}
+
 void CoreTiming::ForceExceptionCheck(s64 cycles) {
     cycles = std::max<s64>(0, cycles);
     if (downcounts[current_context] <= cycles) {
@@ -156,33 +748,44 @@ std::optional<u64> CoreTiming::NextAvailableCore(const s64 needed_ticks) const {
 }
 
 void CoreTiming::Advance() {
-    std::unique_lock<std::mutex> guard(inner_mutex);
-
-    const u64 cycles_executed = accumulated_ticks;
-    time_slice[current_context] = std::max<s64>(0, time_slice[current_context] - accumulated_ticks);
-    global_timer += cycles_executed;
+    if (use_multicore) {
+        return;
+    }
+    if (use_host_timing) {
+        const s64 now = static_cast<s64>(GetTicks());
+        time_slice[current_context] =
+            std::max<s64>(0, time_slice[current_context] - (now - host_slice_start));
+        host_slice_start = now;
+        global_timer = now;
+    } else {
+        const u64 cycles_executed = accumulated_ticks;
+        time_slice[current_context] =
+            std::max<s64>(0, time_slice[current_context] - accumulated_ticks);
+        global_timer += cycles_executed;
+    }
 
     is_global_timer_sane = true;
 
-    while (!event_queue.empty() && event_queue.front().time <= global_timer) {
-        Event evt = std::move(event_queue.front());
-        std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-        event_queue.pop_back();
-        inner_mutex.unlock();
-
-        if (auto event_type{evt.type.lock()}) {
-            event_type->callback(evt.userdata, global_timer - evt.time);
+    DrainInbox();
+    while (auto evt = event_queue->PopDue(global_timer)) {
+        if (auto event_type{evt->type.lock()}) {
+            event_type->callback(evt->userdata, global_timer - evt->time);
         }
 
-        inner_mutex.lock();
+        // Pick up anything the callback scheduled, it may already be due.
+        DrainInbox();
     }
 
     is_global_timer_sane = false;
 
+    if (use_host_timing) {
+        UpdateHostDeadline();
+        return;
+    }
+
     // Still events left (scheduled in the future)
-    if (!event_queue.empty()) {
-        const s64 needed_ticks =
-            std::min<s64>(event_queue.front().time - global_timer, MAX_SLICE_LENGTH);
+    if (const auto next_event_time = event_queue->NextEventTime()) {
+        const s64 needed_ticks = std::min<s64>(*next_event_time - global_timer, MAX_SLICE_LENGTH);
         const auto next_core = NextAvailableCore(needed_ticks);
         if (next_core) {
             downcounts[*next_core] = needed_ticks;
@@ -195,13 +798,23 @@ void CoreTiming::Advance() {
 }
 
 void CoreTiming::ResetRun() {
+    if (use_multicore) {
+        return;
+    }
+    if (use_host_timing) {
+        time_slice.fill(HOST_SLICE_LENGTH);
+        current_context = 0;
+        StartHostSlice();
+        return;
+    }
+
     downcounts.fill(MAX_SLICE_LENGTH);
     time_slice.fill(MAX_SLICE_LENGTH);
     current_context = 0;
     // Still events left (scheduled in the future)
-    if (!event_queue.empty()) {
-        const s64 needed_ticks =
-            std::min<s64>(event_queue.front().time - global_timer, MAX_SLICE_LENGTH);
+    DrainInbox();
+    if (const auto next_event_time = event_queue->NextEventTime()) {
+        const s64 needed_ticks = std::min<s64>(*next_event_time - global_timer, MAX_SLICE_LENGTH);
         downcounts[current_context] = needed_ticks;
     }
 
@@ -210,16 +823,62 @@ void CoreTiming::ResetRun() {
 }
 
 void CoreTiming::Idle() {
+    if (use_multicore) {
+        return;
+    }
+    if (use_host_timing) {
+        // Sleep until the next event or the end of the slice, instead of spinning through them.
+        std::unique_lock lock{timer_mutex};
+        is_idling = true;
+        const s64 start = static_cast<s64>(GetTicks());
+        s64 wake_time = std::min(host_deadline.load(),
+                                 host_slice_start + time_slice[current_context]);
+        for (;;) {
+            // Deadlines may only be lowered by other threads while the emu thread is here.
+            wake_time = std::min(wake_time, host_deadline.load());
+            const s64 now = static_cast<s64>(GetTicks());
+            if (now >= wake_time || shutting_down) {
+                break;
+            }
+            timer_cv.wait_for(lock, CyclesToNs(std::min(wake_time - now, MAX_HOST_WAIT)));
+        }
+        is_idling = false;
+        idled_cycles += static_cast<s64>(GetTicks()) - start;
+        return;
+    }
+
     accumulated_ticks += downcounts[current_context];
     idled_cycles += downcounts[current_context];
     downcounts[current_context] = 0;
 }
 
+void CoreTiming::DispatchHostEvents() {
+    ASSERT(use_multicore);
+
+    global_timer = static_cast<s64>(GetTicks());
+
+    DrainInbox();
+    while (auto evt = event_queue->PopDue(global_timer)) {
+        if (auto event_type{evt->type.lock()}) {
+            event_type->callback(evt->userdata, global_timer - evt->time);
+        }
+        DrainInbox();
+    }
+
+    UpdateHostDeadline();
+}
+
 std::chrono::microseconds CoreTiming::GetGlobalTimeUs() const {
+    if (clock) {
+        return clock->GetTimeUS();
+    }
     return std::chrono::microseconds{GetTicks() * 1000000 / Hardware::BASE_CLOCK_RATE};
 }
 
 s64 CoreTiming::GetDowncount() const {
+    if (use_host_timing) {
+        return HOST_TIMING_DOWNCOUNT;
+    }
     return downcounts[current_context];
 }
 
@@ -4,17 +4,24 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "common/common_types.h"
 #include "common/threadsafe_queue.h"
 
+namespace Common {
+class WallClock;
+}
+
 namespace Core::Timing {
 
 /// A callback that may be scheduled for a particular core timing event.
@@ -42,6 +49,18 @@ struct EventType {
  * So to schedule a new event on a regular basis:
  * inside callback:
  *   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
+ *
+ * Scheduling and unscheduling may be done from any thread. Requests are posted to a lock-free
+ * inbox, which the emu thread drains at slice boundaries, i.e. whenever it calls Advance().
+ *
+ * By default, time only moves forward as the CPU reports executed ticks. With host timing, time
+ * follows a host clock instead: executed ticks are ignored, and a timer thread calls the interrupt
+ * handler once the next event or the end of the current slice is due, which is expected to make
+ * the running core return to its dispatcher loop.
+ *
+ * In multicore mode, every core runs on its own host thread and there are no slices: the cores
+ * never call Advance(). Instead, the interrupt handler is called whenever the next event is due,
+ * and is expected to dispatch it through DispatchHostEvents(). Multicore implies host timing.
  */
 class CoreTiming {
 public:
@@ -54,6 +73,28 @@ public:
     CoreTiming& operator=(const CoreTiming&) = delete;
     CoreTiming& operator=(CoreTiming&&) = delete;
 
+    /// Selects whether time follows the host clock. Must be called before Initialize().
+    void SetHostTiming(bool is_enabled) {
+        use_host_timing = is_enabled;
+    }
+
+    bool IsHostTiming() const {
+        return use_host_timing;
+    }
+
+    /// Selects whether events are dispatched independently of the cores. Must be called before
+    /// Initialize().
+    void SetMulticore(bool is_enabled) {
+        use_multicore = is_enabled;
+    }
+
+    bool IsMulticore() const {
+        return use_multicore;
+    }
+
+    /// Sets the function called from the timer thread when a deadline is reached with host timing.
+    void SetInterruptHandler(std::function<void()> handler);
+
     /// CoreTiming begins at the boundary of timing slice -1. An initial call to Advance() is
     /// required to end slice - 1 and start slice 0 before the first cycle of code is executed.
     void Initialize();
@@ -93,6 +134,10 @@ public:
     /// Pretend that the main CPU has executed enough cycles to reach the next event.
     void Idle();
 
+    /// Runs the callbacks of every event due by now and rearms the timer thread. Only used in
+    /// multicore mode, where it is called from the interrupt handler.
+    void DispatchHostEvents();
+
     std::chrono::microseconds GetGlobalTimeUs() const;
 
     void ResetRun();
@@ -101,6 +146,9 @@ public:
 
     void SwitchContext(u64 new_context) {
         current_context = new_context;
+        if (use_host_timing) {
+            StartHostSlice();
+        }
     }
 
     bool CanCurrentContextRun() const {
@@ -111,6 +159,24 @@ public:
 
 private:
     struct Event;
+    struct Command;
+    class EventQueue;
+    class Inbox;
+
+    /// Applies every request posted to the inbox to the event queue.
+    void DrainInbox();
+
+    /// Starts measuring the host time spent in the current context's slice.
+    void StartHostSlice();
+
+    /// Arms the timer thread for the next event or the end of the current slice.
+    void UpdateHostDeadline();
+
+    /// Moves the timer thread's deadline earlier, if the given time is before it.
+    void LowerHostDeadline(s64 time);
+
+    void TimerThreadLoop();
+    void StopTimerThread();
 
     /// Clear all pending events. This should ONLY be done on exit.
     void ClearPendingEvents();
@@ -131,16 +197,31 @@ private:
     // don't change slice_length and downcount.
     bool is_global_timer_sane = false;
 
-    // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-    // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-    // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't
-    // accomodated by the standard adaptor class.
-    std::vector<Event> event_queue;
-    u64 event_fifo_id = 0;
+    // Only accessed by the emu thread, or the timer thread in multicore mode. Other threads go
+    // through the inbox.
+    std::unique_ptr<EventQueue> event_queue;
+    std::unique_ptr<Inbox> inbox;
+    std::atomic<u64> event_fifo_id{0};
+    // Number of commands drained from the inbox, emu thread only.
+    u64 drained_commands = 0;
 
     std::shared_ptr<EventType> ev_lost;
 
-    std::mutex inner_mutex;
+    bool use_host_timing = false;
+    bool use_multicore = false;
+    std::unique_ptr<Common::WallClock> clock;
+    // Host time at which the current context started running or last advanced.
+    s64 host_slice_start = 0;
+
+    std::thread timer_thread;
+    std::mutex timer_mutex;
+    std::condition_variable timer_cv;
+    // Held while the interrupt handler runs, so that it can be replaced safely during shutdown.
+    std::mutex handler_mutex;
+    std::function<void()> interrupt_handler;
+    std::atomic<s64> host_deadline;
+    bool is_idling = false;
+    bool shutting_down = false;
 };
 
 /// Creates a core timing event with the given name and callback.
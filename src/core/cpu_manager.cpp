@@ -2,15 +2,34 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <chrono>
+#include <limits>
+#include <string>
+
+#include "common/thread.h"
 #include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/core_manager.h"
 #include "core/core_timing.h"
 #include "core/cpu_manager.h"
 #include "core/gdbstub/gdbstub.h"
+#include "core/hle/lock.h"
 
 namespace Core {
 
+namespace {
+constexpr std::size_t NOT_A_CORE_THREAD = std::numeric_limits<std::size_t>::max();
+
+// Index of the core owned by the calling thread, in multicore mode.
+thread_local std::size_t current_core_thread = NOT_A_CORE_THREAD;
+
+// How long the cores run on their own per RunLoop call in multicore mode.
+constexpr std::chrono::milliseconds MULTICORE_RUN_QUANTUM{10};
+
+// How often parking cores are interrupted again, in case they missed the first interrupt.
+constexpr std::chrono::milliseconds PARK_RETRY_INTERVAL{1};
+} // Anonymous namespace
+
 CpuManager::CpuManager(System& system) : system{system} {}
 CpuManager::~CpuManager() = default;
 
@@ -18,9 +37,36 @@ void CpuManager::Initialize() {
     for (std::size_t index = 0; index < core_managers.size(); ++index) {
         core_managers[index] = std::make_unique<CoreManager>(system, index);
     }
+
+    auto& core_timing = system.CoreTiming();
+    is_multicore = core_timing.IsMulticore();
+    if (is_multicore) {
+        // Events are dispatched from the timer thread, the cores may have threads to wake up.
+        core_timing.SetInterruptHandler([this] {
+            {
+                std::lock_guard lock{HLE::g_hle_lock};
+                system.CoreTiming().DispatchHostEvents();
+            }
+            InterruptAllCores();
+        });
+
+        shutting_down = false;
+        cores_running = false;
+        num_parked_cores = 0;
+        for (std::size_t index = 0; index < core_threads.size(); ++index) {
+            core_threads[index] = std::thread(&CpuManager::CoreThreadLoop, this, index);
+        }
+    } else if (core_timing.IsHostTiming()) {
+        // With host timing, CoreTiming kicks the running core out of the JIT when a deadline is
+        // due.
+        core_timing.SetInterruptHandler(
+            [this] { core_managers[active_core]->PrepareReschedule(); });
+    }
 }
 
 void CpuManager::Shutdown() {
+    system.CoreTiming().SetInterruptHandler(nullptr);
+    StopCoreThreads();
     for (auto& cpu_core : core_managers) {
         cpu_core.reset();
     }
@@ -35,13 +81,19 @@ const CoreManager& CpuManager::GetCoreManager(std::size_t index) const {
 }
 
 CoreManager& CpuManager::GetCurrentCoreManager() {
-    // Otherwise, use single-threaded mode active_core variable
-    return *core_managers[active_core];
+    return *core_managers[GetActiveCoreIndex()];
 }
 
 const CoreManager& CpuManager::GetCurrentCoreManager() const {
+    return *core_managers[GetActiveCoreIndex()];
+}
+
+std::size_t CpuManager::GetActiveCoreIndex() const {
+    if (current_core_thread != NOT_A_CORE_THREAD) {
+        return current_core_thread;
+    }
     // Otherwise, use single-threaded mode active_core variable
-    return *core_managers[active_core];
+    return active_core;
 }
 
 void CpuManager::RunLoop(bool tight_loop) {
@@ -59,6 +111,18 @@ void CpuManager::RunLoop(bool tight_loop) {
         }
     }
 
+    if (is_multicore) {
+        RunMulticore(tight_loop);
+    } else {
+        RunSingleThread(tight_loop);
+    }
+
+    if (GDBStub::IsServerEnabled()) {
+        GDBStub::SetCpuStepFlag(false);
+    }
+}
+
+void CpuManager::RunSingleThread(bool tight_loop) {
     auto& core_timing = system.CoreTiming();
     core_timing.ResetRun();
     bool keep_running{};
@@ -72,9 +136,82 @@ void CpuManager::RunLoop(bool tight_loop) {
             keep_running |= core_timing.CanCurrentContextRun();
         }
     } while (keep_running);
+}
 
-    if (GDBStub::IsServerEnabled()) {
-        GDBStub::SetCpuStepFlag(false);
+void CpuManager::RunMulticore(bool tight_loop) {
+    if (!tight_loop) {
+        // Single stepping is done on the calling thread while the core threads are parked.
+        for (active_core = 0; active_core < NUM_CPU_CORES; ++active_core) {
+            core_managers[active_core]->RunLoop(false);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard lock{run_mutex};
+        cores_running = true;
+    }
+    run_cv.notify_all();
+
+    std::this_thread::sleep_for(MULTICORE_RUN_QUANTUM);
+
+    std::unique_lock lock{run_mutex};
+    ParkCoreThreads(lock);
+}
+
+void CpuManager::CoreThreadLoop(std::size_t core_index) {
+    const std::string name = "yuzu:CoreCPU_" + std::to_string(core_index);
+    Common::SetCurrentThreadName(name.c_str());
+    current_core_thread = core_index;
+    system.RegisterCoreThread(core_index);
+
+    CoreManager& core_manager = *core_managers[core_index];
+    std::unique_lock lock{run_mutex};
+    while (true) {
+        ++num_parked_cores;
+        parked_cv.notify_all();
+        run_cv.wait(lock, [this] { return cores_running || shutting_down; });
+        --num_parked_cores;
+        if (shutting_down) {
+            return;
+        }
+
+        lock.unlock();
+        while (cores_running) {
+            core_manager.RunLoop(true);
+        }
+        lock.lock();
+    }
+}
+
+void CpuManager::StopCoreThreads() {
+    if (!is_multicore) {
+        return;
+    }
+    {
+        std::unique_lock lock{run_mutex};
+        ParkCoreThreads(lock);
+        shutting_down = true;
+    }
+    run_cv.notify_all();
+    for (auto& thread : core_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void CpuManager::ParkCoreThreads(std::unique_lock<std::mutex>& lock) {
+    cores_running = false;
+    do {
+        InterruptAllCores();
+    } while (!parked_cv.wait_for(lock, PARK_RETRY_INTERVAL,
+                                 [this] { return num_parked_cores == NUM_CPU_CORES; }));
+}
+
+void CpuManager::InterruptAllCores() {
+    for (auto& core_manager : core_managers) {
+        core_manager->PrepareReschedule();
     }
 }
 
@@ -5,7 +5,11 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include "core/hardware_properties.h"
 
 namespace Core {
@@ -33,15 +37,41 @@ public:
     CoreManager& GetCurrentCoreManager();
     const CoreManager& GetCurrentCoreManager() const;
 
-    std::size_t GetActiveCoreIndex() const {
-        return active_core;
-    }
+    /// Returns the index of the core running on the calling thread. Threads that do not belong
+    /// to a core get the core last run by the single threaded dispatcher.
+    std::size_t GetActiveCoreIndex() const;
 
+    /// Runs the cores for a while. In multicore mode, the cores run on their own threads during
+    /// the call, and are paused again before it returns.
     void RunLoop(bool tight_loop);
 
 private:
+    void RunSingleThread(bool tight_loop);
+    void RunMulticore(bool tight_loop);
+
+    void CoreThreadLoop(std::size_t core_index);
+    void StopCoreThreads();
+
+    /// Stops the core threads and waits until all of them are parked. Requires run_mutex.
+    void ParkCoreThreads(std::unique_lock<std::mutex>& lock);
+
+    /// Makes every core return to its dispatcher loop.
+    void InterruptAllCores();
+
     std::array<std::unique_ptr<CoreManager>, Hardware::NUM_CPU_CORES> core_managers;
-    std::size_t active_core{}; ///< Active core, only used in single thread mode
+    /// Active core, only used in single thread mode. Also read by the host timing interrupt.
+    std::atomic<std::size_t> active_core{};
+
+    bool is_multicore = false;
+    std::array<std::thread, Hardware::NUM_CPU_CORES> core_threads;
+    std::mutex run_mutex;
+    /// Wakes the core threads up when they are resumed or shut down.
+    std::condition_variable run_cv;
+    /// Notified by core threads as they park.
+    std::condition_variable parked_cv;
+    std::atomic<bool> cores_running = false;
+    bool shutting_down = false;
+    std::size_t num_parked_cores = 0;
 
     System& system;
 };
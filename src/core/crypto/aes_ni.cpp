@@ -0,0 +1,261 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#include "common/assert.h"
+#include "common/swap.h"
+#include "core/crypto/aes_ni.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <wmmintrin.h>
+#include "common/x64/cpu_detect.h"
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AESNI_TARGET __attribute__((target("aes,sse2")))
+#else
+#define AESNI_TARGET
+#endif
+
+namespace Core::Crypto::AESNI {
+
+#ifdef ARCHITECTURE_x86_64
+
+namespace {
+
+constexpr std::size_t BLOCK_SIZE = 0x10;
+constexpr std::size_t NUM_ROUNDS = 10;
+constexpr std::size_t PIPELINE_DEPTH = 8;
+
+struct RoundKeys {
+    __m128i keys[NUM_ROUNDS + 1];
+};
+
+AESNI_TARGET RoundKeys LoadRoundKeys(const std::array<Block, NUM_ROUNDS + 1>& blocks) {
+    RoundKeys round_keys;
+    for (std::size_t i = 0; i <= NUM_ROUNDS; ++i) {
+        round_keys.keys[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[i].data()));
+    }
+    return round_keys;
+}
+
+template <std::size_t N>
+AESNI_TARGET void EncryptBlocks(const RoundKeys& round_keys, __m128i (&blocks)[N]) {
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = _mm_xor_si128(blocks[i], round_keys.keys[0]);
+    }
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        for (std::size_t i = 0; i < N; ++i) {
+            blocks[i] = _mm_aesenc_si128(blocks[i], round_keys.keys[round]);
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = _mm_aesenclast_si128(blocks[i], round_keys.keys[NUM_ROUNDS]);
+    }
+}
+
+template <std::size_t N>
+AESNI_TARGET void DecryptBlocks(const RoundKeys& round_keys, __m128i (&blocks)[N]) {
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = _mm_xor_si128(blocks[i], round_keys.keys[0]);
+    }
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        for (std::size_t i = 0; i < N; ++i) {
+            blocks[i] = _mm_aesdec_si128(blocks[i], round_keys.keys[round]);
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = _mm_aesdeclast_si128(blocks[i], round_keys.keys[NUM_ROUNDS]);
+    }
+}
+
+template <std::size_t N>
+AESNI_TARGET void TranscodeBlocks(const RoundKeys& round_keys, __m128i (&blocks)[N], Op op) {
+    if (op == Op::Encrypt) {
+        EncryptBlocks(round_keys, blocks);
+    } else {
+        DecryptBlocks(round_keys, blocks);
+    }
+}
+
+template <int RoundConstant>
+AESNI_TARGET __m128i ExpandRoundKey(__m128i key) {
+    const __m128i generated =
+        _mm_shuffle_epi32(_mm_aeskeygenassist_si128(key, RoundConstant), 0xFF);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, generated);
+}
+
+/// A 128-bit big-endian counter, kept in host order.
+struct Counter {
+    u64 high;
+    u64 low;
+
+    AESNI_TARGET __m128i Next() {
+        const __m128i block = _mm_set_epi64x(static_cast<s64>(Common::swap64(low)),
+                                             static_cast<s64>(Common::swap64(high)));
+        if (++low == 0) {
+            ++high;
+        }
+        return block;
+    }
+};
+
+/// A 128-bit XTS tweak, a little-endian element of GF(2^128).
+struct Tweak {
+    u64 low;
+    u64 high;
+
+    AESNI_TARGET __m128i Next() {
+        const __m128i block = _mm_set_epi64x(static_cast<s64>(high), static_cast<s64>(low));
+        // Multiply by the primitive element, reducing by x^128 + x^7 + x^2 + x + 1.
+        const u64 carry = high >> 63;
+        high = (high << 1) | (low >> 63);
+        low = (low << 1) ^ (carry * 0x87);
+        return block;
+    }
+};
+
+} // Anonymous namespace
+
+bool IsSupported() {
+    const auto& caps = Common::GetCPUCaps();
+    return caps.aes && caps.sse2;
+}
+
+AESNI_TARGET void ExpandKey(const u8* key, KeySchedule& schedule) {
+    __m128i keys[NUM_ROUNDS + 1];
+    keys[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    keys[1] = ExpandRoundKey<0x01>(keys[0]);
+    keys[2] = ExpandRoundKey<0x02>(keys[1]);
+    keys[3] = ExpandRoundKey<0x04>(keys[2]);
+    keys[4] = ExpandRoundKey<0x08>(keys[3]);
+    keys[5] = ExpandRoundKey<0x10>(keys[4]);
+    keys[6] = ExpandRoundKey<0x20>(keys[5]);
+    keys[7] = ExpandRoundKey<0x40>(keys[6]);
+    keys[8] = ExpandRoundKey<0x80>(keys[7]);
+    keys[9] = ExpandRoundKey<0x1B>(keys[8]);
+    keys[10] = ExpandRoundKey<0x36>(keys[9]);
+
+    // The equivalent inverse cipher runs the rounds backwards, with InvMixColumns applied to the
+    // inner round keys.
+    for (std::size_t i = 0; i <= NUM_ROUNDS; ++i) {
+        __m128i decrypt_key = keys[NUM_ROUNDS - i];
+        if (i != 0 && i != NUM_ROUNDS) {
+            decrypt_key = _mm_aesimc_si128(decrypt_key);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(schedule.encrypt[i].data()), keys[i]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(schedule.decrypt[i].data()), decrypt_key);
+    }
+}
+
+AESNI_TARGET void CTRTranscode(const KeySchedule& schedule, Block& counter_block, const u8* src,
+                               std::size_t size, u8* dest) {
+    const RoundKeys round_keys = LoadRoundKeys(schedule.encrypt);
+    Counter counter;
+    std::memcpy(&counter.high, counter_block.data(), sizeof(u64));
+    std::memcpy(&counter.low, counter_block.data() + sizeof(u64), sizeof(u64));
+    counter.high = Common::swap64(counter.high);
+    counter.low = Common::swap64(counter.low);
+
+    std::size_t offset = 0;
+    for (; offset + PIPELINE_DEPTH * BLOCK_SIZE <= size; offset += PIPELINE_DEPTH * BLOCK_SIZE) {
+        __m128i blocks[PIPELINE_DEPTH];
+        for (auto& block : blocks) {
+            block = counter.Next();
+        }
+        EncryptBlocks(round_keys, blocks);
+        for (std::size_t i = 0; i < PIPELINE_DEPTH; ++i) {
+            const auto* const in = reinterpret_cast<const __m128i*>(src + offset + i * BLOCK_SIZE);
+            auto* const out = reinterpret_cast<__m128i*>(dest + offset + i * BLOCK_SIZE);
+            _mm_storeu_si128(out, _mm_xor_si128(_mm_loadu_si128(in), blocks[i]));
+        }
+    }
+    for (; offset < size; offset += BLOCK_SIZE) {
+        __m128i blocks[1]{counter.Next()};
+        EncryptBlocks(round_keys, blocks);
+        if (size - offset >= BLOCK_SIZE) {
+            const auto* const in = reinterpret_cast<const __m128i*>(src + offset);
+            auto* const out = reinterpret_cast<__m128i*>(dest + offset);
+            _mm_storeu_si128(out, _mm_xor_si128(_mm_loadu_si128(in), blocks[0]));
+            continue;
+        }
+        Block key_stream;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(key_stream.data()), blocks[0]);
+        for (std::size_t i = 0; i < size - offset; ++i) {
+            dest[offset + i] = src[offset + i] ^ key_stream[i];
+        }
+    }
+
+    counter.high = Common::swap64(counter.high);
+    counter.low = Common::swap64(counter.low);
+    std::memcpy(counter_block.data(), &counter.high, sizeof(u64));
+    std::memcpy(counter_block.data() + sizeof(u64), &counter.low, sizeof(u64));
+}
+
+AESNI_TARGET void XTSTranscode(const KeySchedule& data_key, const KeySchedule& tweak_key,
+                               const Block& tweak_block, const u8* src, std::size_t size, u8* dest,
+                               Op op) {
+    ASSERT_MSG(size % BLOCK_SIZE == 0, "XTS data units must be a multiple of the block size");
+    const RoundKeys round_keys =
+        LoadRoundKeys(op == Op::Encrypt ? data_key.encrypt : data_key.decrypt);
+
+    __m128i encrypted_tweak[1]{
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(tweak_block.data()))};
+    EncryptBlocks(LoadRoundKeys(tweak_key.encrypt), encrypted_tweak);
+    Tweak tweak;
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&tweak.low), encrypted_tweak[0]);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&tweak.high),
+                     _mm_unpackhi_epi64(encrypted_tweak[0], encrypted_tweak[0]));
+
+    std::size_t offset = 0;
+    for (; offset + PIPELINE_DEPTH * BLOCK_SIZE <= size; offset += PIPELINE_DEPTH * BLOCK_SIZE) {
+        __m128i tweaks[PIPELINE_DEPTH];
+        __m128i blocks[PIPELINE_DEPTH];
+        for (std::size_t i = 0; i < PIPELINE_DEPTH; ++i) {
+            const auto* const in = reinterpret_cast<const __m128i*>(src + offset + i * BLOCK_SIZE);
+            tweaks[i] = tweak.Next();
+            blocks[i] = _mm_xor_si128(_mm_loadu_si128(in), tweaks[i]);
+        }
+        TranscodeBlocks(round_keys, blocks, op);
+        for (std::size_t i = 0; i < PIPELINE_DEPTH; ++i) {
+            auto* const out = reinterpret_cast<__m128i*>(dest + offset + i * BLOCK_SIZE);
+            _mm_storeu_si128(out, _mm_xor_si128(blocks[i], tweaks[i]));
+        }
+    }
+    for (; offset < size; offset += BLOCK_SIZE) {
+        const __m128i current_tweak = tweak.Next();
+        const auto* const in = reinterpret_cast<const __m128i*>(src + offset);
+        __m128i blocks[1]{_mm_xor_si128(_mm_loadu_si128(in), current_tweak)};
+        TranscodeBlocks(round_keys, blocks, op);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + offset),
+                         _mm_xor_si128(blocks[0], current_tweak));
+    }
+}
+
+#else
+
+bool IsSupported() {
+    return false;
+}
+
+void ExpandKey(const u8*, KeySchedule&) {
+    UNREACHABLE();
+}
+
+void CTRTranscode(const KeySchedule&, Block&, const u8*, std::size_t, u8*) {
+    UNREACHABLE();
+}
+
+void XTSTranscode(const KeySchedule&, const KeySchedule&, const Block&, const u8*, std::size_t,
+                  u8*, Op) {
+    UNREACHABLE();
+}
+
+#endif
+
+} // namespace Core::Crypto::AESNI
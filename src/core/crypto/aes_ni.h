@@ -0,0 +1,48 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "common/common_types.h"
+#include "core/crypto/aes_util.h"
+
+// AES-128 implemented with the AES-NI instructions, used by AESCipher for the CTR and XTS modes
+// when the host supports them. Blocks are processed eight at a time, so that the latency of the
+// AES instructions is hidden.
+namespace Core::Crypto::AESNI {
+
+using Block = std::array<u8, 0x10>;
+
+/// Expanded AES-128 round keys, for encryption and for decryption.
+struct KeySchedule {
+    std::array<Block, 11> encrypt;
+    std::array<Block, 11> decrypt;
+};
+
+/// Whether the host supports AES-NI. Nothing else in this namespace may be used otherwise.
+bool IsSupported();
+
+/// Expands a 128-bit key.
+void ExpandKey(const u8* key, KeySchedule& schedule);
+
+/**
+ * Encrypts or decrypts data in CTR mode. The counter is a big-endian 128-bit integer, which is
+ * advanced past every block used, including a trailing partial block.
+ */
+void CTRTranscode(const KeySchedule& schedule, Block& counter, const u8* src, std::size_t size,
+                  u8* dest);
+
+/**
+ * Encrypts or decrypts a data unit in XTS mode.
+ * @param data_key The key of the data, the first half of the XTS key.
+ * @param tweak_key The key of the tweak, the second half of the XTS key.
+ * @param tweak The tweak of the data unit, before it is encrypted.
+ * @param size The size of the data unit, which must be a multiple of the block size.
+ */
+void XTSTranscode(const KeySchedule& data_key, const KeySchedule& tweak_key, const Block& tweak,
+                  const u8* src, std::size_t size, u8* dest, Op op);
+
+} // namespace Core::Crypto::AESNI
@@ -2,16 +2,18 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "core/crypto/aes_ni.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
 namespace Core::Crypto {
 namespace {
-std::vector<u8> CalculateNintendoTweak(std::size_t sector_id) {
-    std::vector<u8> out(0x10);
+std::array<u8, 0x10> CalculateNintendoTweak(std::size_t sector_id) {
+    std::array<u8, 0x10> out{};
     for (std::size_t i = 0xF; i <= 0xF; --i) {
         out[i] = sector_id & 0xFF;
         sector_id >>= 8;
@@ -34,6 +36,14 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+    // Whether the AES-NI backend handles this cipher, mbedtls is used otherwise. The backend
+    // handles CTR with 128-bit keys and XTS with two 128-bit keys.
+    bool use_aes_ni = false;
+    Mode mode;
+    AESNI::KeySchedule data_key;
+    AESNI::KeySchedule tweak_key;
+    AESNI::Block iv{};
 };
 
 template <typename Key, std::size_t KeySize>
@@ -55,6 +65,16 @@ Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
     ASSERT(
         !mbedtls_cipher_setkey(&ctx->decryption_context, key.data(), KeySize * 8, MBEDTLS_DECRYPT));
     //"Failed to set key on mbedtls ciphers.");
+
+    ctx->mode = mode;
+    ctx->use_aes_ni = AESNI::IsSupported() && ((mode == Mode::CTR && KeySize == 0x10) ||
+                                               (mode == Mode::XTS && KeySize == 0x20));
+    if (ctx->use_aes_ni) {
+        AESNI::ExpandKey(key.data(), ctx->data_key);
+        if (mode == Mode::XTS) {
+            AESNI::ExpandKey(key.data() + 0x10, ctx->tweak_key);
+        }
+    }
 }
 
 template <typename Key, std::size_t KeySize>
@@ -68,10 +88,25 @@ void AESCipher<Key, KeySize>::SetIV(std::vector<u8> iv) {
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, iv.data(), iv.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, iv.data(), iv.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
+
+    ctx->iv.fill(0);
+    std::copy_n(iv.begin(), std::min(iv.size(), ctx->iv.size()), ctx->iv.begin());
 }
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
+    if (ctx->use_aes_ni) {
+        if (ctx->mode == Mode::CTR) {
+            AESNI::CTRTranscode(ctx->data_key, ctx->iv, src, size, dest);
+            return;
+        }
+        // Data units that need ciphertext stealing are left to mbedtls.
+        if (size != 0 && size % ctx->iv.size() == 0) {
+            AESNI::XTSTranscode(ctx->data_key, ctx->tweak_key, ctx->iv, src, size, dest, op);
+            return;
+        }
+    }
+
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
 
     mbedtls_cipher_reset(context);
@@ -118,8 +153,17 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
                                            std::size_t sector_id, std::size_t sector_size, Op op) {
     ASSERT_MSG(size % sector_size == 0, "XTS decryption size must be a multiple of sector size.");
 
+    if (ctx->use_aes_ni && sector_size % ctx->iv.size() == 0) {
+        for (std::size_t i = 0; i < size; i += sector_size) {
+            AESNI::XTSTranscode(ctx->data_key, ctx->tweak_key, CalculateNintendoTweak(sector_id++),
+                                src + i, sector_size, dest + i, op);
+        }
+        return;
+    }
+
     for (std::size_t i = 0; i < size; i += sector_size) {
-        SetIV(CalculateNintendoTweak(sector_id++));
+        const auto tweak = CalculateNintendoTweak(sector_id++);
+        SetIV({tweak.begin(), tweak.end()});
         Transcode<u8, u8>(src + i, sector_size, dest + i, op);
     }
 }
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <array>
 #include <cstring>
 #include "common/assert.h"
 #include "core/crypto/ctr_encryption_layer.h"
@@ -19,14 +20,16 @@ std::size_t CTREncryptionLayer::Read(u8* data, std::size_t length, std::size_t o
 
     const auto sector_offset = offset & 0xF;
     if (sector_offset == 0) {
+        // CTR needs no padding, so the data is decrypted in place.
         UpdateIV(base_offset + offset);
-        std::vector<u8> raw = base->ReadBytes(length, offset);
-        cipher.Transcode(raw.data(), raw.size(), data, Op::Decrypt);
-        return length;
+        const std::size_t read = base->Read(data, length, offset);
+        cipher.Transcode(data, read, data, Op::Decrypt);
+        return read;
     }
 
     // offset does not fall on block boundary (0x10)
-    std::vector<u8> block = base->ReadBytes(0x10, offset - sector_offset);
+    std::array<u8, 0x10> block{};
+    base->Read(block.data(), block.size(), offset - sector_offset);
     UpdateIV(base_offset + offset - sector_offset);
     cipher.Transcode(block.data(), block.size(), block.data(), Op::Decrypt);
     std::size_t read = 0x10 - sector_offset;
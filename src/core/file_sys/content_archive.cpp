@@ -14,6 +14,7 @@
 #include "core/file_sys/nca_patch.h"
 #include "core/file_sys/partition_filesystem.h"
 #include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs_cached.h"
 #include "core/file_sys/vfs_offset.h"
 #include "core/loader/loader.h"
 
@@ -500,7 +501,7 @@ VirtualFile NCA::Decrypt(const NCASectionHeader& s_header, VirtualFile in, u64 s
             for (u8 i = 0; i < 8; ++i)
                 iv[i] = s_header.raw.section_ctr[0x8 - i - 1];
             out->SetIV(iv);
-            return std::static_pointer_cast<VfsFile>(out);
+            return std::make_shared<CachedVfsFile>(std::move(out));
         }
     case NCASectionCryptoType::XTS:
         // TODO(DarkLordZach): Find a test case for XTS-encrypted NCAs
@@ -26,10 +26,12 @@
 #include <string_view>
 #include "common/alignment.h"
 #include "common/assert.h"
+#include "common/common_funcs.h"
+#include "common/logging/log.h"
+#include "common/swap.h"
 #include "core/file_sys/fsmitm_romfsbuild.h"
 #include "core/file_sys/ips_layer.h"
 #include "core/file_sys/vfs.h"
-#include "core/file_sys/vfs_vector.h"
 
 namespace FileSys {
 
@@ -73,6 +75,29 @@ struct RomFSFileEntry {
 };
 static_assert(sizeof(RomFSFileEntry) == 0x20, "RomFSFileEntry has incorrect size.");
 
+// Types for caching the layout of a built RomFS.
+constexpr u32 ROMFS_LAYOUT_CACHE_MAGIC = Common::MakeMagic('R', 'F', 'S', 'L');
+constexpr u32 ROMFS_LAYOUT_CACHE_VERSION = 1;
+
+struct RomFSLayoutCacheHeader {
+    u32_le magic;
+    u32_le version;
+    u64_le key;
+    u64_le metadata_offset;
+    u64_le metadata_size;
+    u64_le num_files;
+};
+static_assert(sizeof(RomFSLayoutCacheHeader) == 0x28,
+              "RomFSLayoutCacheHeader has incorrect size.");
+
+struct RomFSLayoutCacheFile {
+    u64_le offset;
+    u64_le size;
+    u32_le path_size;
+    INSERT_PADDING_BYTES(4);
+};
+static_assert(sizeof(RomFSLayoutCacheFile) == 0x18, "RomFSLayoutCacheFile has incorrect size.");
+
 struct RomFSBuildFileContext;
 
 struct RomFSBuildDirectoryContext {
@@ -169,18 +194,7 @@ void RomFSBuildContext::VisitDirectory(VirtualDir root_romfs, VirtualDir ext,
             // Sanity check on path_len
             ASSERT(child->path_len < FS_MAX_PATH);
 
-            child->source = root_romfs->GetFileRelative(child->path);
-
-            if (ext != nullptr) {
-                const auto ips = ext->GetFileRelative(child->path + ".ips");
-
-                if (ips != nullptr) {
-                    auto patched = PatchIPS(child->source, ips);
-                    if (patched != nullptr)
-                        child->source = std::move(patched);
-                }
-            }
-
+            child->source = OpenRomFSSourceFile(root_romfs, ext, child->path);
             child->size = child->source->GetSize();
 
             AddFile(parent, child);
@@ -240,7 +254,7 @@ RomFSBuildContext::RomFSBuildContext(VirtualDir base_, VirtualDir ext_)
 
 RomFSBuildContext::~RomFSBuildContext() = default;
 
-std::map<u64, VirtualFile> RomFSBuildContext::Build() {
+RomFSLayout RomFSBuildContext::Build() {
     const u64 dir_hash_table_entry_count = romfs_get_hash_table_count(num_dirs);
     const u64 file_hash_table_entry_count = romfs_get_hash_table_count(num_files);
     dir_hash_table_size = 4 * dir_hash_table_entry_count;
@@ -294,7 +308,8 @@ std::map<u64, VirtualFile> RomFSBuildContext::Build() {
         cur_dir->parent->child = cur_dir;
     }
 
-    std::map<u64, VirtualFile> out;
+    RomFSLayout layout;
+    layout.files.reserve(files.size());
 
     // Populate file tables.
     for (const auto& it : files) {
@@ -315,7 +330,8 @@ std::map<u64, VirtualFile> RomFSBuildContext::Build() {
 
         cur_entry.name_size = name_size;
 
-        out.emplace(cur_file->offset + ROMFS_FILEPARTITION_OFS, cur_file->source);
+        layout.files.push_back({cur_file->offset + ROMFS_FILEPARTITION_OFS, cur_file->size,
+                                cur_file->path, cur_file->source});
         std::memcpy(file_table.data() + cur_file->entry_offset, &cur_entry, sizeof(RomFSFileEntry));
         std::memset(file_table.data() + cur_file->entry_offset + sizeof(RomFSFileEntry), 0,
                     Common::AlignUp(cur_entry.name_size, 4));
@@ -363,9 +379,8 @@ std::map<u64, VirtualFile> RomFSBuildContext::Build() {
     header.file_hash_table_ofs = header.dir_table_ofs + header.dir_table_size;
     header.file_table_ofs = header.file_hash_table_ofs + header.file_hash_table_size;
 
-    std::vector<u8> header_data(sizeof(RomFSHeader));
-    std::memcpy(header_data.data(), &header, header_data.size());
-    out.emplace(0, std::make_shared<VectorVfsFile>(std::move(header_data)));
+    layout.header.resize(sizeof(RomFSHeader));
+    std::memcpy(layout.header.data(), &header, layout.header.size());
 
     std::vector<u8> metadata(file_hash_table_size + file_table_size + dir_hash_table_size +
                              dir_table_size);
@@ -378,9 +393,114 @@ std::map<u64, VirtualFile> RomFSBuildContext::Build() {
                 file_hash_table.size() * sizeof(u32));
     index += file_hash_table.size() * sizeof(u32);
     std::memcpy(metadata.data() + index, file_table.data(), file_table.size());
-    out.emplace(header.dir_hash_table_ofs, std::make_shared<VectorVfsFile>(std::move(metadata)));
+    layout.metadata_offset = header.dir_hash_table_ofs;
+    layout.metadata = std::move(metadata);
+
+    return layout;
+}
+
+std::vector<u8> SerializeRomFSLayout(const RomFSLayout& layout, u64 key) {
+    RomFSLayoutCacheHeader cache_header{};
+    cache_header.magic = ROMFS_LAYOUT_CACHE_MAGIC;
+    cache_header.version = ROMFS_LAYOUT_CACHE_VERSION;
+    cache_header.key = key;
+    cache_header.metadata_offset = layout.metadata_offset;
+    cache_header.metadata_size = layout.metadata.size();
+    cache_header.num_files = layout.files.size();
+
+    std::vector<u8> out(sizeof(RomFSLayoutCacheHeader));
+    std::memcpy(out.data(), &cache_header, sizeof(RomFSLayoutCacheHeader));
+    out.insert(out.end(), layout.header.begin(), layout.header.end());
+    out.insert(out.end(), layout.metadata.begin(), layout.metadata.end());
+
+    for (const auto& file : layout.files) {
+        RomFSLayoutCacheFile cache_file{};
+        cache_file.offset = file.offset;
+        cache_file.size = file.size;
+        cache_file.path_size = static_cast<u32>(file.path.size());
+
+        const std::size_t position = out.size();
+        out.resize(position + sizeof(RomFSLayoutCacheFile) + file.path.size());
+        std::memcpy(out.data() + position, &cache_file, sizeof(RomFSLayoutCacheFile));
+        std::memcpy(out.data() + position + sizeof(RomFSLayoutCacheFile), file.path.data(),
+                    file.path.size());
+    }
 
     return out;
 }
 
+std::optional<RomFSLayout> DeserializeRomFSLayout(const std::vector<u8>& data, u64 key) {
+    std::size_t position = 0;
+    const auto read = [&data, &position](void* dest, std::size_t size) {
+        if (size > data.size() - position)
+            return false;
+        std::memcpy(dest, data.data() + position, size);
+        position += size;
+        return true;
+    };
+
+    RomFSLayoutCacheHeader cache_header{};
+    if (!read(&cache_header, sizeof(RomFSLayoutCacheHeader)) ||
+        cache_header.magic != ROMFS_LAYOUT_CACHE_MAGIC ||
+        cache_header.version != ROMFS_LAYOUT_CACHE_VERSION || cache_header.key != key ||
+        cache_header.metadata_size > data.size()) {
+        return std::nullopt;
+    }
+
+    RomFSLayout layout;
+    layout.header.resize(sizeof(RomFSHeader));
+    layout.metadata_offset = cache_header.metadata_offset;
+    layout.metadata.resize(cache_header.metadata_size);
+    if (!read(layout.header.data(), layout.header.size()) ||
+        !read(layout.metadata.data(), layout.metadata.size())) {
+        return std::nullopt;
+    }
+
+    for (u64 i = 0; i < cache_header.num_files; ++i) {
+        RomFSLayoutCacheFile cache_file{};
+        if (!read(&cache_file, sizeof(RomFSLayoutCacheFile)) || cache_file.path_size >= FS_MAX_PATH)
+            return std::nullopt;
+
+        std::string path(cache_file.path_size, '\0');
+        if (!read(path.data(), path.size()))
+            return std::nullopt;
+        layout.files.push_back({cache_file.offset, cache_file.size, std::move(path), nullptr});
+    }
+
+    if (position != data.size())
+        return std::nullopt;
+    return layout;
+}
+
+VirtualFile OpenRomFSSourceFile(const VirtualDir& base, const VirtualDir& ext,
+                                std::string_view path) {
+    auto source = base->GetFileRelative(path);
+    if (ext == nullptr)
+        return source;
+
+    const auto ips = ext->GetFileRelative(std::string(path) + ".ips");
+    if (ips != nullptr) {
+        auto patched = PatchIPS(source, ips);
+        if (patched != nullptr)
+            source = std::move(patched);
+    }
+
+    return source;
+}
+
+bool OpenRomFSLayoutSources(RomFSLayout& layout, const VirtualDir& base, const VirtualDir& ext) {
+    for (auto& file : layout.files) {
+        if (file.source != nullptr)
+            continue;
+
+        file.source = OpenRomFSSourceFile(base, ext, file.path);
+        if (file.source == nullptr || file.source->GetSize() != file.size) {
+            LOG_WARNING(Service_FS, "File {} of the RomFS layout changed", file.path);
+            file.source = nullptr;
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace FileSys
@@ -26,7 +26,10 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "common/common_types.h"
 #include "core/file_sys/vfs.h"
 
@@ -37,13 +40,44 @@ struct RomFSBuildFileContext;
 struct RomFSDirectoryEntry;
 struct RomFSFileEntry;
 
+// Placement of the metadata and files of a built RomFS. Layouts can be cached, so that later builds
+// from unchanged directories do not have to walk them again.
+struct RomFSLayout {
+    struct File {
+        u64 offset;
+        u64 size;
+        std::string path;
+        // Not cached, layouts read from a cache have no sources.
+        VirtualFile source;
+    };
+
+    std::vector<u8> header;
+    u64 metadata_offset = 0;
+    std::vector<u8> metadata;
+    std::vector<File> files;
+};
+
+// Serializes a layout, tagging it with a key identifying the directories it was built from.
+std::vector<u8> SerializeRomFSLayout(const RomFSLayout& layout, u64 key);
+
+// Reads back a serialized layout, returning std::nullopt if it is invalid or has another key.
+std::optional<RomFSLayout> DeserializeRomFSLayout(const std::vector<u8>& data, u64 key);
+
+// Opens the file at path in a RomFS built from base and ext, applying the IPS patches in ext.
+VirtualFile OpenRomFSSourceFile(const VirtualDir& base, const VirtualDir& ext,
+                                std::string_view path);
+
+// Opens the sources of the files of a layout, such as a cached one, in base and ext. Returns false
+// if any of them is missing or changed size, in which case the layout has to be built again.
+bool OpenRomFSLayoutSources(RomFSLayout& layout, const VirtualDir& base, const VirtualDir& ext);
+
 class RomFSBuildContext {
 public:
     explicit RomFSBuildContext(VirtualDir base, VirtualDir ext = nullptr);
     ~RomFSBuildContext();
 
     // This finalizes the context.
-    std::map<u64, VirtualFile> Build();
+    RomFSLayout Build();
 
 private:
     VirtualDir base;
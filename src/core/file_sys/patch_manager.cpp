@@ -6,13 +6,19 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
 
+#include "common/cityhash.h"
+#include "common/common_paths.h"
 #include "common/file_util.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
 #include "core/core.h"
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/control_metadata.h"
+#include "core/file_sys/fsmitm_romfsbuild.h"
 #include "core/file_sys/ips_layer.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
@@ -313,6 +319,75 @@ std::vector<Memory::CheatEntry> PatchManager::CreateCheatList(
     return out;
 }
 
+// Appends the names, sizes and modification times of the entries under a host directory.
+static void AppendDirectoryStamp(std::string& stamp, const std::string& path) {
+    std::vector<std::string> names;
+    FileUtil::ForeachDirectoryEntry(
+        nullptr, path,
+        [&names](u64* entries_out, const std::string& directory, const std::string& name) {
+            names.push_back(name);
+            return true;
+        });
+    std::sort(names.begin(), names.end());
+
+    stamp += path + '\n';
+    for (const auto& name : names) {
+        const auto full_path = path + DIR_SEP + name;
+        if (FileUtil::IsDirectory(full_path)) {
+            AppendDirectoryStamp(stamp, full_path);
+            continue;
+        }
+        stamp += fmt::format("{}:{}:{}\n", name, FileUtil::GetSize(full_path),
+                             FileUtil::GetModificationTime(full_path));
+    }
+}
+
+// Identifies the inputs of a LayeredFS build, the base RomFS and the files of every mod.
+static u64 GetLayeredFSCacheKey(const VirtualFile& romfs, const std::vector<VirtualDir>& layers,
+                                const std::vector<VirtualDir>& layers_ext) {
+    std::string stamp = fmt::format("{}\n", romfs->GetSize());
+    const auto header = romfs->ReadBytes(0x50);
+    stamp.append(header.begin(), header.end());
+
+    for (const auto& layer : layers) {
+        AppendDirectoryStamp(stamp, layer->GetFullPath());
+    }
+    stamp += "ext\n";
+    for (const auto& layer : layers_ext) {
+        AppendDirectoryStamp(stamp, layer->GetFullPath());
+    }
+
+    return Common::CityHash64(stamp.data(), stamp.size());
+}
+
+static std::string GetLayeredFSCachePath(u64 title_id, ContentRecordType type) {
+    return fmt::format("{}layeredfs{}{:016X}_{:02X}.bin",
+                       FileUtil::GetUserPath(FileUtil::UserPath::CacheDir), DIR_SEP, title_id,
+                       static_cast<u8>(type));
+}
+
+static std::optional<RomFSLayout> LoadLayeredFSCache(const std::string& path, u64 key) {
+    FileUtil::IOFile file{path, "rb"};
+    if (!file.IsOpen()) {
+        return std::nullopt;
+    }
+
+    std::vector<u8> data(file.GetSize());
+    if (file.ReadBytes(data.data(), data.size()) != data.size()) {
+        return std::nullopt;
+    }
+    return DeserializeRomFSLayout(data, key);
+}
+
+static void SaveLayeredFSCache(const std::string& path, const RomFSLayout& layout, u64 key) {
+    const auto data = SerializeRomFSLayout(layout, key);
+    FileUtil::CreateFullPath(path);
+    FileUtil::IOFile file{path, "wb"};
+    if (!file.IsOpen() || file.WriteBytes(data.data(), data.size()) != data.size()) {
+        LOG_WARNING(Loader, "Failed to write the LayeredFS cache to {}", path);
+    }
+}
+
 static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType type) {
     const auto load_dir =
         Core::System::GetInstance().GetFileSystemController().GetModificationLoadRoot(title_id);
@@ -348,6 +423,11 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
         if (ext_dir != nullptr)
             layers_ext.push_back(std::move(ext_dir));
     }
+
+    // Building the RomFS walks every file of the layers, the layout of the previous boot is reused
+    // as long as neither the base RomFS nor the mods changed.
+    const auto cache_path = GetLayeredFSCachePath(title_id, type);
+    const u64 cache_key = GetLayeredFSCacheKey(romfs, layers, layers_ext);
     layers.push_back(std::move(extracted));
 
     auto layered = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers));
@@ -357,7 +437,23 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
 
     auto layered_ext = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers_ext));
 
-    auto packed = CreateRomFS(std::move(layered), std::move(layered_ext));
+    auto layout = LoadLayeredFSCache(cache_path, cache_key);
+    if (layout && !OpenRomFSLayoutSources(*layout, layered, layered_ext)) {
+        LOG_WARNING(Loader, "    RomFS: The cached LayeredFS layout is stale, rebuilding it");
+        layout.reset();
+    }
+
+    if (layout) {
+        LOG_INFO(Loader, "    RomFS: Using the cached LayeredFS layout");
+    } else {
+        RomFSBuildContext ctx{layered, layered_ext};
+        layout = ctx.Build();
+        SaveLayeredFSCache(cache_path, *layout, cache_key);
+    }
+
+    auto name = layered->GetName();
+    auto packed = CreateRomFS(std::move(*layout), std::move(layered), std::move(layered_ext),
+                              std::move(name));
     if (packed == nullptr) {
         return;
     }
@@ -2,7 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <cstring>
 #include <memory>
+#include <utility>
 
 #include "common/common_types.h"
 #include "common/swap.h"
@@ -55,6 +57,15 @@ static_assert(sizeof(FileEntry) == 0x20, "FileEntry has incorrect size.");
 template <typename Entry>
 std::pair<Entry, std::string> GetEntry(const VirtualFile& file, std::size_t offset) {
     Entry entry{};
+    // Unencrypted images are parsed straight from the mapped file.
+    if (const auto span = file->GetSpan(sizeof(Entry), offset); !span.empty()) {
+        std::memcpy(&entry, span.data(), sizeof(Entry));
+        const auto name = file->GetSpan(entry.name_length, offset + sizeof(Entry));
+        if (name.size() != entry.name_length)
+            return {};
+        return {entry, std::string(reinterpret_cast<const char*>(name.data()), name.size())};
+    }
+
     if (file->ReadObject(&entry, offset) != sizeof(Entry))
         return {};
     std::string string(entry.name_length, '\0');
@@ -101,6 +112,7 @@ void ProcessDirectory(VirtualFile file, std::size_t dir_offset, std::size_t file
         this_dir_offset = entry.first.sibling;
     }
 }
+
 } // Anonymous namespace
 
 VirtualDir ExtractRomFS(VirtualFile file, RomFSExtractionType type) {
@@ -140,7 +152,25 @@ VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext) {
         return nullptr;
 
     RomFSBuildContext ctx{dir, ext};
-    return ConcatenatedVfsFile::MakeConcatenatedFile(0, ctx.Build(), dir->GetName());
+    auto name = dir->GetName();
+    return CreateRomFS(ctx.Build(), std::move(dir), std::move(ext), std::move(name));
+}
+
+VirtualFile CreateRomFS(RomFSLayout layout, VirtualDir dir, VirtualDir ext, std::string name) {
+    if (!OpenRomFSLayoutSources(layout, dir, ext)) {
+        RomFSBuildContext ctx{dir, ext};
+        layout = ctx.Build();
+    }
+
+    std::map<u64, VirtualFile> files;
+    for (auto& file : layout.files) {
+        files.emplace(file.offset, std::move(file.source));
+    }
+    files.emplace(0, std::make_shared<VectorVfsFile>(std::move(layout.header)));
+    files.emplace(layout.metadata_offset,
+                  std::make_shared<VectorVfsFile>(std::move(layout.metadata)));
+
+    return ConcatenatedVfsFile::MakeConcatenatedFile(0, std::move(files), std::move(name));
 }
 
 } // namespace FileSys
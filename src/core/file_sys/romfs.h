@@ -5,10 +5,13 @@
 #pragma once
 
 #include <array>
+#include <string>
 #include "core/file_sys/vfs.h"
 
 namespace FileSys {
 
+struct RomFSLayout;
+
 enum class RomFSExtractionType {
     Full,          // Includes data directory
     Truncated,     // Traverses into data directory
@@ -24,4 +27,9 @@ VirtualDir ExtractRomFS(VirtualFile file,
 // Returns nullptr on failure
 VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext = nullptr);
 
+// Assembles a RomFS binary from a layout built from dir and ext, such as a cached one
+// Files of the layout without a source are opened in dir and ext, the layout is built again if any
+// of them changed
+VirtualFile CreateRomFS(RomFSLayout layout, VirtualDir dir, VirtualDir ext, std::string name);
+
 } // namespace FileSys
@@ -167,6 +167,10 @@ std::string VfsFile::GetExtension() const {
 
 VfsDirectory::~VfsDirectory() = default;
 
+Common::Span<const u8> VfsFile::GetSpan(std::size_t length, std::size_t offset) const {
+    return {};
+}
+
 std::optional<u8> VfsFile::ReadByte(std::size_t offset) const {
     u8 out{};
     std::size_t size = Read(&out, 1, offset);
@@ -177,6 +181,10 @@ std::optional<u8> VfsFile::ReadByte(std::size_t offset) const {
 }
 
 std::vector<u8> VfsFile::ReadBytes(std::size_t size, std::size_t offset) const {
+    if (const auto span = GetSpan(size, offset); !span.empty()) {
+        return {span.begin(), span.end()};
+    }
+
     std::vector<u8> out(size);
     std::size_t read_size = Read(out.data(), size, offset);
     out.resize(read_size);
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/span.h"
 #include "core/file_sys/vfs_types.h"
 
 namespace FileSys {
@@ -105,6 +106,12 @@ public:
     // into file. Returns number of bytes successfully written.
     virtual std::size_t Write(const u8* data, std::size_t length, std::size_t offset = 0) = 0;
 
+    // Returns a view of length bytes of the file starting at offset, without copying them. The view
+    // stays valid while the file is alive and not written to. Returns an empty span if the range is
+    // not entirely within the file, or if the file cannot expose its data directly, for example
+    // because it has to be decrypted.
+    virtual Common::Span<const u8> GetSpan(std::size_t length, std::size_t offset = 0) const;
+
     // Reads exactly one byte at the offset provided, returning std::nullopt on error.
     virtual std::optional<u8> ReadByte(std::size_t offset = 0) const;
     // Reads size bytes starting at offset in file into a vector.
@@ -0,0 +1,174 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "common/assert.h"
+#include "common/bit_util.h"
+#include "core/file_sys/vfs_cached.h"
+
+namespace FileSys {
+
+namespace {
+std::atomic<u64> total_hits{};
+std::atomic<u64> total_misses{};
+std::atomic<u64> total_bypassed_reads{};
+thread_local bool is_thread_bypassed = false;
+} // Anonymous namespace
+
+CachedVfsFile::CachedVfsFile(VirtualFile file_, std::size_t block_size_, std::size_t capacity)
+    : file(std::move(file_)), size(file->GetSize()), block_size(block_size_),
+      block_bits(Common::Log2Floor64(block_size_)),
+      blocks_per_shard(std::max<std::size_t>(capacity / block_size_ / NUM_SHARDS, 1)) {
+    ASSERT_MSG(block_size != 0 && (block_size & (block_size - 1)) == 0,
+               "Block size must be a power of two");
+}
+
+CachedVfsFile::~CachedVfsFile() = default;
+
+std::string CachedVfsFile::GetName() const {
+    return file->GetName();
+}
+
+std::size_t CachedVfsFile::GetSize() const {
+    return size;
+}
+
+bool CachedVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+std::shared_ptr<VfsDirectory> CachedVfsFile::GetContainingDirectory() const {
+    return file->GetContainingDirectory();
+}
+
+bool CachedVfsFile::IsWritable() const {
+    return false;
+}
+
+bool CachedVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t CachedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (offset >= size) {
+        return 0;
+    }
+    length = std::min(length, size - offset);
+
+    if (is_thread_bypassed || length > blocks_per_shard * NUM_SHARDS * block_size / 4) {
+        bypassed_reads.fetch_add(1, std::memory_order_relaxed);
+        total_bypassed_reads.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard lock{file_mutex};
+        return file->Read(data, length, offset);
+    }
+
+    std::size_t read = 0;
+    while (read < length) {
+        const std::size_t position = offset + read;
+        const std::size_t block_offset = position & (block_size - 1);
+        const std::size_t block_length = std::min(length - read, block_size - block_offset);
+        const std::size_t block_read =
+            ReadBlock(position >> block_bits, data + read, block_length, block_offset);
+        read += block_read;
+        if (block_read < block_length) {
+            break;
+        }
+    }
+    return read;
+}
+
+std::size_t CachedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+bool CachedVfsFile::Rename(std::string_view name) {
+    return false;
+}
+
+CachedVfsFile::Stats CachedVfsFile::GetStats() const {
+    return {hits.load(std::memory_order_relaxed), misses.load(std::memory_order_relaxed),
+            bypassed_reads.load(std::memory_order_relaxed)};
+}
+
+CachedVfsFile::Stats CachedVfsFile::GetTotalStats() {
+    return {total_hits.load(std::memory_order_relaxed),
+            total_misses.load(std::memory_order_relaxed),
+            total_bypassed_reads.load(std::memory_order_relaxed)};
+}
+
+void CachedVfsFile::ResetTotalStats() {
+    total_hits.store(0, std::memory_order_relaxed);
+    total_misses.store(0, std::memory_order_relaxed);
+    total_bypassed_reads.store(0, std::memory_order_relaxed);
+}
+
+void CachedVfsFile::SetBypassedOnCurrentThread(bool bypassed) {
+    is_thread_bypassed = bypassed;
+}
+
+std::size_t CachedVfsFile::ReadBlock(u64 index, u8* data, std::size_t length,
+                                     std::size_t block_offset) const {
+    const auto copy_out = [&](const std::vector<u8>& block) {
+        if (block_offset >= block.size()) {
+            return std::size_t{0};
+        }
+        const std::size_t copied = std::min(length, block.size() - block_offset);
+        std::memcpy(data, block.data() + block_offset, copied);
+        return copied;
+    };
+
+    Shard& shard = shards[index % NUM_SHARDS];
+    {
+        std::lock_guard lock{shard.mutex};
+        const auto it = shard.lookup.find(index);
+        if (it != shard.lookup.end()) {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            total_hits.fetch_add(1, std::memory_order_relaxed);
+            shard.blocks.splice(shard.blocks.begin(), shard.blocks, it->second);
+            return copy_out(it->second->data);
+        }
+    }
+
+    // The shard is not locked while decrypting, so that other blocks can be served meanwhile.
+    misses.fetch_add(1, std::memory_order_relaxed);
+    total_misses.fetch_add(1, std::memory_order_relaxed);
+    std::vector<u8> block;
+    ReadBase(index, block);
+    const std::size_t copied = copy_out(block);
+
+    std::lock_guard lock{shard.mutex};
+    if (shard.lookup.count(index) != 0) {
+        // Another reader missed on the same block and cached it first.
+        return copied;
+    }
+    if (shard.blocks.size() < blocks_per_shard) {
+        shard.blocks.push_front({index, std::move(block)});
+    } else {
+        // Reuse the node of the least recently used block.
+        const auto last = std::prev(shard.blocks.end());
+        shard.lookup.erase(last->index);
+        last->index = index;
+        last->data = std::move(block);
+        shard.blocks.splice(shard.blocks.begin(), shard.blocks, last);
+    }
+    shard.lookup.emplace(index, shard.blocks.begin());
+    return copied;
+}
+
+std::size_t CachedVfsFile::ReadBase(u64 index, std::vector<u8>& block) const {
+    const std::size_t block_start = index << block_bits;
+    block.resize(std::min(block_size, size - block_start));
+
+    std::lock_guard lock{file_mutex};
+    const std::size_t read = file->Read(block.data(), block.size(), block_start);
+    block.resize(read);
+    return read;
+}
+
+} // namespace FileSys
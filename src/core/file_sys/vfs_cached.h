@@ -0,0 +1,106 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+// An implementation of VfsFile that keeps recently read blocks of another, read-only VfsFile in
+// memory. Placed above the encryption layers, so that data read over and over, like the RomFS
+// metadata tables, is only decrypted once.
+// Blocks are spread over several independently locked shards, each evicting its least recently
+// used blocks, so that concurrent readers rarely contend. Reads spanning a large part of the
+// capacity go straight to the wrapped file, so that streaming assets does not evict hot blocks.
+class CachedVfsFile : public VfsFile {
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 0x4000;
+    static constexpr std::size_t DEFAULT_CAPACITY = 0x400000;
+
+    struct Stats {
+        u64 hits;
+        u64 misses;
+        u64 bypassed_reads;
+    };
+
+    /**
+     * @param file The file to cache, it must not be written to while wrapped.
+     * @param block_size Size of the cached blocks in bytes, must be a power of two.
+     * @param capacity Maximum number of cached bytes, rounded down to whole blocks per shard.
+     */
+    explicit CachedVfsFile(VirtualFile file, std::size_t block_size = DEFAULT_BLOCK_SIZE,
+                           std::size_t capacity = DEFAULT_CAPACITY);
+    ~CachedVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    std::shared_ptr<VfsDirectory> GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+
+    /// Returns the hit and miss counters of the cache, in blocks.
+    Stats GetStats() const;
+
+    /// Returns the counters summed over every CachedVfsFile, including destroyed ones.
+    static Stats GetTotalStats();
+
+    /// Zeroes the counters summed over every CachedVfsFile.
+    static void ResetTotalStats();
+
+    /// Makes the reads of the calling thread go straight to the wrapped files, so that speculative
+    /// reads like the prefetches of ReadaheadVfsFile do not evict blocks that are in use.
+    static void SetBypassedOnCurrentThread(bool bypassed);
+
+private:
+    static constexpr std::size_t NUM_SHARDS = 8;
+
+    struct Block {
+        u64 index;
+        std::vector<u8> data;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        /// Cached blocks, most recently used first.
+        std::list<Block> blocks;
+        std::unordered_map<u64, std::list<Block>::iterator> lookup;
+    };
+
+    /// Copies part of a block into data, reading the block from the wrapped file on a miss.
+    std::size_t ReadBlock(u64 index, u8* data, std::size_t length, std::size_t block_offset) const;
+
+    /// Reads a whole block from the wrapped file.
+    std::size_t ReadBase(u64 index, std::vector<u8>& block) const;
+
+    VirtualFile file;
+    std::size_t size;
+    std::size_t block_size;
+    std::size_t block_bits;
+    std::size_t blocks_per_shard;
+
+    // The encryption layers keep their cipher state in the file, reads from it are serialized.
+    mutable std::mutex file_mutex;
+    mutable std::array<Shard, NUM_SHARDS> shards;
+
+    mutable std::atomic<u64> hits{};
+    mutable std::atomic<u64> misses{};
+    mutable std::atomic<u64> bypassed_reads{};
+};
+
+} // namespace FileSys
@@ -132,6 +132,22 @@ std::size_t ConcatenatedVfsFile::Write(const u8* data, std::size_t length, std::
     return 0;
 }
 
+Common::Span<const u8> ConcatenatedVfsFile::GetSpan(std::size_t length,
+                                                    std::size_t offset) const {
+    // Only ranges within a single file are contiguous.
+    auto entry = files.upper_bound(offset);
+    if (entry == files.begin())
+        return {};
+    --entry;
+
+    const auto file_offset = offset - entry->first;
+    const auto file_size = entry->second->GetSize();
+    if (file_offset > file_size || length > file_size - file_offset)
+        return {};
+
+    return entry->second->GetSpan(length, file_offset);
+}
+
 bool ConcatenatedVfsFile::Rename(std::string_view name) {
     return false;
 }
@@ -36,6 +36,7 @@ public:
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    Common::Span<const u8> GetSpan(std::size_t length, std::size_t offset) const override;
     bool Rename(std::string_view name) override;
 
 private:
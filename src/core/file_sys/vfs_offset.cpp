@@ -57,6 +57,13 @@ std::size_t OffsetVfsFile::Write(const u8* data, std::size_t length, std::size_t
     return file->Write(data, TrimToFit(length, r_offset), offset + r_offset);
 }
 
+Common::Span<const u8> OffsetVfsFile::GetSpan(std::size_t length, std::size_t r_offset) const {
+    if (r_offset > size || length > size - r_offset)
+        return {};
+
+    return file->GetSpan(length, offset + r_offset);
+}
+
 std::optional<u8> OffsetVfsFile::ReadByte(std::size_t r_offset) const {
     if (r_offset < size)
         return file->ReadByte(offset + r_offset);
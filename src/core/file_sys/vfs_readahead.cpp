@@ -0,0 +1,307 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/file_sys/vfs_cached.h"
+#include "core/file_sys/vfs_readahead.h"
+
+namespace FileSys {
+
+namespace {
+
+/// Number of back to back reads after which a reader is considered sequential.
+constexpr u32 SEQUENTIAL_READ_THRESHOLD = 2;
+
+std::atomic<u64> total_hits{};
+std::atomic<u64> total_misses{};
+std::atomic<u64> total_prefetched_bytes{};
+
+/// Background thread running the prefetches of every ReadaheadVfsFile.
+class PrefetchWorker {
+public:
+    PrefetchWorker() : thread{[this] { ThreadLoop(); }} {}
+
+    ~PrefetchWorker() {
+        {
+            std::lock_guard lock{queue_mutex};
+            stop_requested = true;
+        }
+        queue_cv.notify_one();
+        thread.join();
+    }
+
+    void QueueWork(std::function<void()>&& work) {
+        {
+            std::lock_guard lock{queue_mutex};
+            queue.push(std::move(work));
+        }
+        queue_cv.notify_one();
+    }
+
+private:
+    void ThreadLoop() {
+        Common::SetCurrentThreadName("yuzu:FsReadahead");
+        CachedVfsFile::SetBypassedOnCurrentThread(true);
+        while (true) {
+            std::function<void()> work;
+            {
+                std::unique_lock lock{queue_mutex};
+                queue_cv.wait(lock, [this] { return stop_requested || !queue.empty(); });
+                if (stop_requested) {
+                    return;
+                }
+                work = std::move(queue.front());
+                queue.pop();
+            }
+            work();
+        }
+    }
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    std::queue<std::function<void()>> queue;
+    bool stop_requested = false;
+    std::thread thread;
+};
+
+PrefetchWorker& GetPrefetchWorker() {
+    static PrefetchWorker worker;
+    return worker;
+}
+
+} // Anonymous namespace
+
+struct ReadaheadVfsFile::State {
+    struct Window {
+        std::vector<u8> data;
+        /// Set once the worker starts reading the window.
+        bool started = false;
+        bool ready = false;
+    };
+
+    State(VirtualFile file_, std::size_t window_size_, std::size_t num_windows_)
+        : file{std::move(file_)}, size{file->GetSize()}, window_size{window_size_},
+          num_windows{num_windows_} {}
+
+    /**
+     * Copies the data of the windows covering the start of a range, waiting on the ones being
+     * read. Windows still queued behind other prefetches are left to the reader, which is quicker
+     * reading them itself.
+     */
+    std::size_t ReadFromWindows(u8* data, std::size_t length, std::size_t offset) {
+        std::unique_lock lock{mutex};
+        std::size_t read = 0;
+        while (read < length) {
+            const std::size_t position = offset + read;
+            const u64 index = position / window_size;
+            auto it = windows.find(index);
+            if (it == windows.end() || !it->second.started) {
+                break;
+            }
+            window_ready.wait(lock, [&] {
+                it = windows.find(index);
+                return it == windows.end() || it->second.ready;
+            });
+            if (it == windows.end()) {
+                break;
+            }
+
+            const auto& window = it->second.data;
+            const std::size_t window_offset = position - index * window_size;
+            if (window_offset >= window.size()) {
+                break;
+            }
+            const std::size_t copied = std::min(length - read, window.size() - window_offset);
+            std::memcpy(data + read, window.data() + window_offset, copied);
+            read += copied;
+        }
+        return read;
+    }
+
+    /// Tracks the access pattern, and queues prefetches ahead of sequential readers.
+    void OnRead(const std::shared_ptr<State>& self, std::size_t offset, std::size_t length) {
+        const std::size_t end = offset + length;
+        std::lock_guard lock{mutex};
+        if (offset == next_offset) {
+            ++sequential_reads;
+            // The reader moved past these, they will not be read again.
+            windows.erase(windows.begin(), windows.lower_bound(end / window_size));
+        } else {
+            sequential_reads = 0;
+        }
+        next_offset = end;
+
+        if (sequential_reads < SEQUENTIAL_READ_THRESHOLD) {
+            return;
+        }
+
+        const u64 first_window = end / window_size;
+        for (u64 index = first_window; index < first_window + num_windows; ++index) {
+            if (index * window_size >= size) {
+                break;
+            }
+            if (!windows.try_emplace(index).second) {
+                continue;
+            }
+            GetPrefetchWorker().QueueWork([self, index] { self->Prefetch(index); });
+        }
+
+        // Readers jumping around leave windows behind, keep their number bounded.
+        while (windows.size() > num_windows * 2) {
+            windows.erase(windows.begin());
+        }
+    }
+
+    void Prefetch(u64 index) {
+        {
+            std::lock_guard lock{mutex};
+            const auto it = windows.find(index);
+            if (it == windows.end()) {
+                // Dropped before it was started.
+                return;
+            }
+            it->second.started = true;
+        }
+
+        const std::size_t window_start = index * window_size;
+        std::vector<u8> data(std::min(window_size, size - window_start));
+        {
+            std::lock_guard lock{file_mutex};
+            data.resize(file->Read(data.data(), data.size(), window_start));
+        }
+
+        {
+            std::lock_guard lock{mutex};
+            const auto it = windows.find(index);
+            if (it == windows.end()) {
+                // Dropped while it was being read.
+                return;
+            }
+            prefetched_bytes.fetch_add(data.size(), std::memory_order_relaxed);
+            total_prefetched_bytes.fetch_add(data.size(), std::memory_order_relaxed);
+            it->second.data = std::move(data);
+            it->second.ready = true;
+        }
+        window_ready.notify_all();
+    }
+
+    const VirtualFile file;
+    const std::size_t size;
+    const std::size_t window_size;
+    const std::size_t num_windows;
+
+    /// Serializes reads of the wrapped file, which may keep cipher state.
+    std::mutex file_mutex;
+
+    std::mutex mutex;
+    std::condition_variable window_ready;
+    std::map<u64, Window> windows;
+    std::size_t next_offset = 0;
+    u32 sequential_reads = 0;
+
+    std::atomic<u64> hits{};
+    std::atomic<u64> misses{};
+    std::atomic<u64> prefetched_bytes{};
+};
+
+ReadaheadVfsFile::ReadaheadVfsFile(VirtualFile file, std::size_t window_size,
+                                   std::size_t num_windows)
+    : state{std::make_shared<State>(std::move(file), window_size, num_windows)} {
+    ASSERT(window_size != 0 && num_windows != 0);
+}
+
+ReadaheadVfsFile::~ReadaheadVfsFile() {
+    const Stats stats = GetStats();
+    if (stats.hits + stats.misses != 0) {
+        LOG_DEBUG(Service_FS, "Readahead of {}: {} hits, {} misses, {} bytes prefetched",
+                  state->file->GetName(), stats.hits, stats.misses, stats.prefetched_bytes);
+    }
+}
+
+std::string ReadaheadVfsFile::GetName() const {
+    return state->file->GetName();
+}
+
+std::size_t ReadaheadVfsFile::GetSize() const {
+    return state->size;
+}
+
+bool ReadaheadVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+std::shared_ptr<VfsDirectory> ReadaheadVfsFile::GetContainingDirectory() const {
+    return state->file->GetContainingDirectory();
+}
+
+bool ReadaheadVfsFile::IsWritable() const {
+    return false;
+}
+
+bool ReadaheadVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t ReadaheadVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (offset >= state->size) {
+        return 0;
+    }
+    length = std::min(length, state->size - offset);
+
+    std::size_t read = state->ReadFromWindows(data, length, offset);
+    if (read == length) {
+        state->hits.fetch_add(1, std::memory_order_relaxed);
+        total_hits.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        state->misses.fetch_add(1, std::memory_order_relaxed);
+        total_misses.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard lock{state->file_mutex};
+        read += state->file->Read(data + read, length - read, offset + read);
+    }
+
+    state->OnRead(state, offset, read);
+    return read;
+}
+
+std::size_t ReadaheadVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+bool ReadaheadVfsFile::Rename(std::string_view name) {
+    return false;
+}
+
+ReadaheadVfsFile::Stats ReadaheadVfsFile::GetStats() const {
+    return {state->hits.load(std::memory_order_relaxed),
+            state->misses.load(std::memory_order_relaxed),
+            state->prefetched_bytes.load(std::memory_order_relaxed)};
+}
+
+ReadaheadVfsFile::Stats ReadaheadVfsFile::GetTotalStats() {
+    return {total_hits.load(std::memory_order_relaxed),
+            total_misses.load(std::memory_order_relaxed),
+            total_prefetched_bytes.load(std::memory_order_relaxed)};
+}
+
+void ReadaheadVfsFile::ResetTotalStats() {
+    total_hits.store(0, std::memory_order_relaxed);
+    total_misses.store(0, std::memory_order_relaxed);
+    total_prefetched_bytes.store(0, std::memory_order_relaxed);
+}
+
+} // namespace FileSys
@@ -0,0 +1,66 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+// An implementation of VfsFile that prefetches the data ahead of sequential readers. Once a few
+// reads followed each other, the next windows of the wrapped file are read (and decrypted, when
+// the wrapped file is an encryption layer) on a background thread, so that streaming readers find
+// them ready instead of waiting on the wrapped file. Prefetches bypass the CachedVfsFiles they
+// read through, as the windows would otherwise evict the blocks readers come back to.
+// The wrapped file must not be written to while wrapped. Reads of it are serialized.
+class ReadaheadVfsFile : public VfsFile {
+public:
+    static constexpr std::size_t DEFAULT_WINDOW_SIZE = 0x40000;
+    static constexpr std::size_t DEFAULT_NUM_WINDOWS = 4;
+
+    struct Stats {
+        u64 hits;             ///< Reads served entirely from prefetched windows.
+        u64 misses;           ///< Reads that had to go to the wrapped file.
+        u64 prefetched_bytes; ///< Bytes read ahead of the reader.
+    };
+
+    /**
+     * @param file The file to read ahead of.
+     * @param window_size Size in bytes of the windows read ahead.
+     * @param num_windows Number of windows kept ahead of a sequential reader.
+     */
+    explicit ReadaheadVfsFile(VirtualFile file, std::size_t window_size = DEFAULT_WINDOW_SIZE,
+                              std::size_t num_windows = DEFAULT_NUM_WINDOWS);
+    ~ReadaheadVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    std::shared_ptr<VfsDirectory> GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    bool Rename(std::string_view name) override;
+
+    Stats GetStats() const;
+
+    /// Returns the counters summed over every ReadaheadVfsFile, including destroyed ones.
+    static Stats GetTotalStats();
+
+    /// Zeroes the counters summed over every ReadaheadVfsFile.
+    static void ResetTotalStats();
+
+private:
+    // Shared with the pending prefetches, which may outlive the file.
+    struct State;
+
+    std::shared_ptr<State> state;
+};
+
+} // namespace FileSys
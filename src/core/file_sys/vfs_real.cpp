@@ -4,11 +4,15 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
+#include <mutex>
+#include <shared_mutex>
 #include <utility>
 #include "common/assert.h"
 #include "common/common_paths.h"
 #include "common/file_util.h"
+#include "common/host_memory.h"
 #include "common/logging/log.h"
 #include "core/file_sys/vfs_real.h"
 
@@ -39,6 +43,37 @@ static std::string ModeFlagsToString(Mode mode) {
     return mode_str;
 }
 
+RealVfsBackingFile::RealVfsBackingFile(const std::string& path, const char openmode[])
+    : file{path, openmode}, is_mappable{std::strcmp(openmode, "rb") == 0} {}
+
+RealVfsBackingFile::~RealVfsBackingFile() = default;
+
+void RealVfsBackingFile::Map(const std::string& path) {
+    {
+        std::shared_lock lock{mapping_mutex};
+        if (!is_mappable || mapping != nullptr) {
+            return;
+        }
+    }
+
+    std::unique_lock lock{mapping_mutex};
+    if (!is_mappable || mapping != nullptr) {
+        return;
+    }
+    // Only try once, files that cannot be mapped keep being read through the IOFile.
+    is_mappable = false;
+    auto new_mapping = std::make_unique<Common::MappedFile>(path);
+    if (new_mapping->IsValid()) {
+        mapping = std::move(new_mapping);
+    }
+}
+
+void RealVfsBackingFile::Unmap() {
+    std::unique_lock lock{mapping_mutex};
+    mapping.reset();
+    is_mappable = false;
+}
+
 RealVfsFilesystem::RealVfsFilesystem() : VfsFilesystem(nullptr) {}
 RealVfsFilesystem::~RealVfsFilesystem() = default;
 
@@ -76,7 +111,7 @@ VirtualFile RealVfsFilesystem::OpenFile(std::string_view path_, Mode perms) {
     if (!FileUtil::Exists(path) && (perms & Mode::WriteAppend) != 0)
         FileUtil::CreateEmptyFile(path);
 
-    auto backing = std::make_shared<FileUtil::IOFile>(path, ModeFlagsToString(perms).c_str());
+    auto backing = std::make_shared<RealVfsBackingFile>(path, ModeFlagsToString(perms).c_str());
     cache[path] = backing;
 
     // Cannot use make_shared as RealVfsFile constructor is private
@@ -113,14 +148,25 @@ VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_
         FileUtil::SanitizePath(new_path_, FileUtil::DirectorySeparator::PlatformDefault);
 
     if (!FileUtil::Exists(old_path) || FileUtil::Exists(new_path) ||
-        FileUtil::IsDirectory(old_path) || !FileUtil::Rename(old_path, new_path))
+        FileUtil::IsDirectory(old_path))
+        return nullptr;
+
+    // Mapped files cannot be renamed on every host.
+    const auto cached_old = cache.find(old_path);
+    if (cached_old != cache.end() && !cached_old->second.expired()) {
+        cached_old->second.lock()->Unmap();
+    }
+    if (!FileUtil::Rename(old_path, new_path))
         return nullptr;
 
     if (cache.find(old_path) != cache.end()) {
         auto cached = cache[old_path];
         if (!cached.expired()) {
             auto file = cached.lock();
-            file->Open(new_path, "r+b");
+            {
+                std::lock_guard lock{file->mutex};
+                file->file.Open(new_path, "r+b");
+            }
             cache.erase(old_path);
             cache[new_path] = file;
         }
@@ -131,8 +177,12 @@ VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_
 bool RealVfsFilesystem::DeleteFile(std::string_view path_) {
     const auto path = FileUtil::SanitizePath(path_, FileUtil::DirectorySeparator::PlatformDefault);
     if (cache.find(path) != cache.end()) {
-        if (!cache[path].expired())
-            cache[path].lock()->Close();
+        if (!cache[path].expired()) {
+            const auto file = cache[path].lock();
+            file->Unmap();
+            std::lock_guard lock{file->mutex};
+            file->file.Close();
+        }
         cache.erase(path);
     }
     return FileUtil::Delete(path);
@@ -176,7 +226,16 @@ VirtualDir RealVfsFilesystem::MoveDirectory(std::string_view old_path_,
     const auto new_path =
         FileUtil::SanitizePath(new_path_, FileUtil::DirectorySeparator::PlatformDefault);
     if (!FileUtil::Exists(old_path) || FileUtil::Exists(new_path) ||
-        FileUtil::IsDirectory(old_path) || !FileUtil::Rename(old_path, new_path))
+        FileUtil::IsDirectory(old_path))
+        return nullptr;
+
+    // Mapped files cannot be renamed on every host.
+    for (auto& kv : cache) {
+        if (kv.first.rfind(old_path, 0) == 0 && !kv.second.expired()) {
+            kv.second.lock()->Unmap();
+        }
+    }
+    if (!FileUtil::Rename(old_path, new_path))
         return nullptr;
 
     for (auto& kv : cache) {
@@ -190,7 +249,8 @@ VirtualDir RealVfsFilesystem::MoveDirectory(std::string_view old_path_,
             auto cached = cache[file_old_path];
             if (!cached.expired()) {
                 auto file = cached.lock();
-                file->Open(file_new_path, "r+b");
+                std::lock_guard lock{file->mutex};
+                file->file.Open(file_new_path, "r+b");
                 cache.erase(file_old_path);
                 cache[file_new_path] = file;
             }
@@ -205,15 +265,19 @@ bool RealVfsFilesystem::DeleteDirectory(std::string_view path_) {
     for (auto& kv : cache) {
         // Path in cache starts with old_path
         if (kv.first.rfind(path, 0) == 0) {
-            if (!cache[kv.first].expired())
-                cache[kv.first].lock()->Close();
+            if (!cache[kv.first].expired()) {
+                const auto file = cache[kv.first].lock();
+                file->Unmap();
+                std::lock_guard lock{file->mutex};
+                file->file.Close();
+            }
             cache.erase(kv.first);
         }
     }
     return FileUtil::DeleteDirRecursively(path);
 }
 
-RealVfsFile::RealVfsFile(RealVfsFilesystem& base_, std::shared_ptr<FileUtil::IOFile> backing_,
+RealVfsFile::RealVfsFile(RealVfsFilesystem& base_, std::shared_ptr<RealVfsBackingFile> backing_,
                          const std::string& path_, Mode perms_)
     : base(base_), backing(std::move(backing_)), path(path_),
       parent_path(FileUtil::GetParentPath(path_)),
@@ -228,11 +292,13 @@ std::string RealVfsFile::GetName() const {
 }
 
 std::size_t RealVfsFile::GetSize() const {
-    return backing->GetSize();
+    std::lock_guard lock{backing->mutex};
+    return backing->file.GetSize();
 }
 
 bool RealVfsFile::Resize(std::size_t new_size) {
-    return backing->Resize(new_size);
+    std::lock_guard lock{backing->mutex};
+    return backing->file.Resize(new_size);
 }
 
 std::shared_ptr<VfsDirectory> RealVfsFile::GetContainingDirectory() const {
@@ -248,15 +314,37 @@ bool RealVfsFile::IsReadable() const {
 }
 
 std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
-    if (!backing->Seek(offset, SEEK_SET))
+    backing->Map(path);
+    {
+        std::shared_lock lock{backing->mapping_mutex};
+        const Common::MappedFile* const mapping = backing->mapping.get();
+        if (mapping != nullptr && offset <= mapping->Size() && length <= mapping->Size() - offset) {
+            std::memcpy(data, mapping->Data() + offset, length);
+            return length;
+        }
+    }
+
+    std::lock_guard lock{backing->mutex};
+    if (!backing->file.Seek(offset, SEEK_SET))
         return 0;
-    return backing->ReadBytes(data, length);
+    return backing->file.ReadBytes(data, length);
 }
 
 std::size_t RealVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
-    if (!backing->Seek(offset, SEEK_SET))
+    std::lock_guard lock{backing->mutex};
+    if (!backing->file.Seek(offset, SEEK_SET))
         return 0;
-    return backing->WriteBytes(data, length);
+    return backing->file.WriteBytes(data, length);
+}
+
+Common::Span<const u8> RealVfsFile::GetSpan(std::size_t length, std::size_t offset) const {
+    backing->Map(path);
+    std::shared_lock lock{backing->mapping_mutex};
+    const Common::MappedFile* const mapping = backing->mapping.get();
+    if (mapping == nullptr || offset > mapping->Size() || length > mapping->Size() - offset) {
+        return {};
+    }
+    return {mapping->Data() + offset, length};
 }
 
 bool RealVfsFile::Rename(std::string_view name) {
@@ -264,7 +352,8 @@ bool RealVfsFile::Rename(std::string_view name) {
 }
 
 bool RealVfsFile::Close() {
-    return backing->Close();
+    std::lock_guard lock{backing->mutex};
+    return backing->file.Close();
 }
 
 // TODO(DarkLordZach): MSVC would not let me combine the following two functions using 'if
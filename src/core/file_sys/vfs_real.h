@@ -4,17 +4,45 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string_view>
 #include <boost/container/flat_map.hpp>
+#include "common/file_util.h"
 #include "core/file_sys/mode.h"
 #include "core/file_sys/vfs.h"
 
-namespace FileUtil {
-class IOFile;
+namespace Common {
+class MappedFile;
 }
 
 namespace FileSys {
 
+/// Host file shared by every RealVfsFile opened on the same path.
+struct RealVfsBackingFile {
+    RealVfsBackingFile(const std::string& path, const char openmode[]);
+    ~RealVfsBackingFile();
+
+    /// Maps the file at the given path on first call, if it was opened read-only.
+    void Map(const std::string& path);
+
+    /// Drops the mapping for good, a mapped file can not be moved, deleted or truncated on every
+    /// host. Spans obtained from the mapping are invalidated.
+    void Unmap();
+
+    FileUtil::IOFile file;
+    /// Serializes seeking and accessing the file, which may happen from the HLE service threads.
+    std::mutex mutex;
+
+    /// Held shared while copying from the mapping, so that it is not dropped meanwhile.
+    std::shared_mutex mapping_mutex;
+    /// Mapping of the file, shared by every RealVfsFile opened on its path.
+    std::unique_ptr<Common::MappedFile> mapping;
+    /// Whether the file may still be mapped, only files opened read-only are.
+    bool is_mappable;
+};
+
 class RealVfsFilesystem : public VfsFilesystem {
 public:
     RealVfsFilesystem();
@@ -36,10 +64,13 @@ public:
     bool DeleteDirectory(std::string_view path) override;
 
 private:
-    boost::container::flat_map<std::string, std::weak_ptr<FileUtil::IOFile>> cache;
+    boost::container::flat_map<std::string, std::weak_ptr<RealVfsBackingFile>> cache;
 };
 
 // An implmentation of VfsFile that represents a file on the user's computer.
+// Files opened read-only are mapped into memory on first access, reads then copy from the mapping
+// and GetSpan exposes it directly. Moving or deleting the file through the filesystem drops the
+// mapping, along with the spans obtained from it.
 class RealVfsFile : public VfsFile {
     friend class RealVfsDirectory;
     friend class RealVfsFilesystem;
@@ -55,16 +86,17 @@ public:
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    Common::Span<const u8> GetSpan(std::size_t length, std::size_t offset) const override;
     bool Rename(std::string_view name) override;
 
 private:
-    RealVfsFile(RealVfsFilesystem& base, std::shared_ptr<FileUtil::IOFile> backing,
+    RealVfsFile(RealVfsFilesystem& base, std::shared_ptr<RealVfsBackingFile> backing,
                 const std::string& path, Mode perms = Mode::Read);
 
     bool Close();
 
     RealVfsFilesystem& base;
-    std::shared_ptr<FileUtil::IOFile> backing;
+    std::shared_ptr<RealVfsBackingFile> backing;
     std::string path;
     std::string parent_path;
     std::vector<std::string> path_components;
@@ -2,8 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <algorithm>
-#include <vector>
+#include <limits>
 
 #include "common/assert.h"
 #include "common/common_types.h"
@@ -17,25 +16,33 @@
 
 namespace Kernel {
 
-// Wake up num_to_wake (or all) threads in a vector.
-void AddressArbiter::WakeThreads(const std::vector<std::shared_ptr<Thread>>& waiting_threads,
-                                 s32 num_to_wake) {
+Common::WaitTableLink<Thread>& AddressArbiter::WaitTableTraits::GetLink(Thread& thread) {
+    return thread.GetArbiterQueueLink();
+}
+
+u64 AddressArbiter::WaitTableTraits::GetKey(const Thread& thread) {
+    return thread.GetArbiterWaitAddress();
+}
+
+u32 AddressArbiter::WaitTableTraits::GetPriority(const Thread& thread) {
+    return thread.GetPriority();
+}
+
+// Wake up num_to_wake (or all) threads waiting on an address.
+void AddressArbiter::WakeThreads(VAddr address, s32 num_to_wake) {
     // Only process up to 'target' threads, unless 'target' is <= 0, in which case process
     // them all.
-    std::size_t last = waiting_threads.size();
-    if (num_to_wake > 0) {
-        last = std::min(last, static_cast<std::size_t>(num_to_wake));
-    }
+    const std::size_t max_count = num_to_wake > 0 ? static_cast<std::size_t>(num_to_wake)
+                                                  : std::numeric_limits<std::size_t>::max();
 
     // Signal the waiting threads.
-    for (std::size_t i = 0; i < last; i++) {
-        ASSERT(waiting_threads[i]->GetStatus() == ThreadStatus::WaitArb);
-        waiting_threads[i]->SetWaitSynchronizationResult(RESULT_SUCCESS);
-        RemoveThread(waiting_threads[i]);
-        waiting_threads[i]->SetArbiterWaitAddress(0);
-        waiting_threads[i]->ResumeFromWait();
-        system.PrepareReschedule(waiting_threads[i]->GetProcessorID());
-    }
+    waiting_threads.wake(address, max_count, [this](Thread* thread) {
+        ASSERT(thread->GetStatus() == ThreadStatus::WaitArb);
+        thread->SetWaitSynchronizationResult(RESULT_SUCCESS);
+        thread->SetArbiterWaitAddress(0);
+        thread->ResumeFromWait();
+        system.PrepareReschedule(thread->GetProcessorID());
+    });
 }
 
 AddressArbiter::AddressArbiter(Core::System& system) : system{system} {}
@@ -56,9 +63,7 @@ ResultCode AddressArbiter::SignalToAddress(VAddr address, SignalType type, s32 v
 }
 
 ResultCode AddressArbiter::SignalToAddressOnly(VAddr address, s32 num_to_wake) {
-    const std::vector<std::shared_ptr<Thread>> waiting_threads =
-        GetThreadsWaitingOnAddress(address);
-    WakeThreads(waiting_threads, num_to_wake);
+    WakeThreads(address, num_to_wake);
     return RESULT_SUCCESS;
 }
 
@@ -88,22 +93,22 @@ ResultCode AddressArbiter::ModifyByWaitingCountAndSignalToAddressIfEqual(VAddr a
         return ERR_INVALID_ADDRESS_STATE;
     }
 
-    // Get threads waiting on the address.
-    const std::vector<std::shared_ptr<Thread>> waiting_threads =
-        GetThreadsWaitingOnAddress(address);
+    // Count the threads waiting on the address, only as far as the decision below needs.
+    const std::size_t num_waiting = waiting_threads.count(
+        address, num_to_wake <= 0 ? 1 : static_cast<std::size_t>(num_to_wake) + 1);
 
     // Determine the modified value depending on the waiting count.
     s32 updated_value;
     if (num_to_wake <= 0) {
-        if (waiting_threads.empty()) {
+        if (num_waiting == 0) {
             updated_value = value + 1;
         } else {
             updated_value = value - 1;
         }
     } else {
-        if (waiting_threads.empty()) {
+        if (num_waiting == 0) {
             updated_value = value + 1;
-        } else if (waiting_threads.size() <= static_cast<u32>(num_to_wake)) {
+        } else if (num_waiting <= static_cast<u32>(num_to_wake)) {
             updated_value = value - 1;
         } else {
             updated_value = value;
@@ -115,7 +120,7 @@ ResultCode AddressArbiter::ModifyByWaitingCountAndSignalToAddressIfEqual(VAddr a
     }
 
     memory.Write32(address, static_cast<u32>(updated_value));
-    WakeThreads(waiting_threads, num_to_wake);
+    WakeThreads(address, num_to_wake);
     return RESULT_SUCCESS;
 }
 
@@ -183,7 +188,7 @@ ResultCode AddressArbiter::WaitForAddressIfEqual(VAddr address, s32 value, s64 t
 ResultCode AddressArbiter::WaitForAddressImpl(VAddr address, s64 timeout) {
     Thread* current_thread = system.CurrentScheduler().GetCurrentThread();
     current_thread->SetArbiterWaitAddress(address);
-    InsertThread(SharedFrom(current_thread));
+    InsertThread(current_thread);
     current_thread->SetStatus(ThreadStatus::WaitArb);
     current_thread->InvalidateWakeupCallback();
     current_thread->WakeAfterDelay(timeout);
@@ -192,48 +197,19 @@ ResultCode AddressArbiter::WaitForAddressImpl(VAddr address, s64 timeout) {
     return RESULT_TIMEOUT;
 }
 
-void AddressArbiter::HandleWakeupThread(std::shared_ptr<Thread> thread) {
+void AddressArbiter::HandleWakeupThread(Thread* thread) {
     ASSERT(thread->GetStatus() == ThreadStatus::WaitArb);
     RemoveThread(thread);
     thread->SetArbiterWaitAddress(0);
 }
 
-void AddressArbiter::InsertThread(std::shared_ptr<Thread> thread) {
-    const VAddr arb_addr = thread->GetArbiterWaitAddress();
-    std::list<std::shared_ptr<Thread>>& thread_list = arb_threads[arb_addr];
-
-    const auto iter =
-        std::find_if(thread_list.cbegin(), thread_list.cend(), [&thread](const auto& entry) {
-            return entry->GetPriority() >= thread->GetPriority();
-        });
-
-    if (iter == thread_list.cend()) {
-        thread_list.push_back(std::move(thread));
-    } else {
-        thread_list.insert(iter, std::move(thread));
-    }
+void AddressArbiter::InsertThread(Thread* thread) {
+    waiting_threads.insert(thread);
 }
 
-void AddressArbiter::RemoveThread(std::shared_ptr<Thread> thread) {
-    const VAddr arb_addr = thread->GetArbiterWaitAddress();
-    std::list<std::shared_ptr<Thread>>& thread_list = arb_threads[arb_addr];
-
-    const auto iter = std::find_if(thread_list.cbegin(), thread_list.cend(),
-                                   [&thread](const auto& entry) { return thread == entry; });
-
-    ASSERT(iter != thread_list.cend());
-
-    thread_list.erase(iter);
+void AddressArbiter::RemoveThread(Thread* thread) {
+    ASSERT(waiting_threads.contains(thread));
+    waiting_threads.remove(thread);
 }
 
-std::vector<std::shared_ptr<Thread>> AddressArbiter::GetThreadsWaitingOnAddress(
-    VAddr address) const {
-    const auto iter = arb_threads.find(address);
-    if (iter == arb_threads.cend()) {
-        return {};
-    }
-
-    const std::list<std::shared_ptr<Thread>>& thread_list = iter->second;
-    return {thread_list.cbegin(), thread_list.cend()};
-}
 } // namespace Kernel
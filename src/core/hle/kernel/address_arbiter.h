@@ -4,12 +4,10 @@
 
 #pragma once
 
-#include <list>
-#include <memory>
-#include <unordered_map>
-#include <vector>
+#include <cstddef>
 
 #include "common/common_types.h"
+#include "common/intrusive_wait_table.h"
 
 union ResultCode;
 
@@ -51,7 +49,7 @@ public:
     ResultCode WaitForAddress(VAddr address, ArbitrationType type, s32 value, s64 timeout_ns);
 
     /// Removes a thread from the container and resets its address arbiter adress to 0
-    void HandleWakeupThread(std::shared_ptr<Thread> thread);
+    void HandleWakeupThread(Thread* thread);
 
 private:
     /// Signals an address being waited on.
@@ -76,20 +74,28 @@ private:
     // Waits on the given address with a timeout in nanoseconds
     ResultCode WaitForAddressImpl(VAddr address, s64 timeout);
 
-    /// Wake up num_to_wake (or all) threads in a vector.
-    void WakeThreads(const std::vector<std::shared_ptr<Thread>>& waiting_threads, s32 num_to_wake);
+    /// Wake up num_to_wake (or all) threads waiting on an address.
+    void WakeThreads(VAddr address, s32 num_to_wake);
 
     /// Insert a thread into the address arbiter container
-    void InsertThread(std::shared_ptr<Thread> thread);
+    void InsertThread(Thread* thread);
 
     /// Removes a thread from the address arbiter container
-    void RemoveThread(std::shared_ptr<Thread> thread);
+    void RemoveThread(Thread* thread);
 
-    // Gets the threads waiting on an address.
-    std::vector<std::shared_ptr<Thread>> GetThreadsWaitingOnAddress(VAddr address) const;
+    struct WaitTableTraits {
+        static Common::WaitTableLink<Thread>& GetLink(Thread& thread);
+        static u64 GetKey(const Thread& thread);
+        static u32 GetPriority(const Thread& thread);
+        static constexpr auto TIE_BREAK = Common::WaitTableTieBreak::LastInFirstOut;
+    };
+
+    /// Number of buckets the waiting threads are hashed into by address.
+    static constexpr std::size_t NUM_WAIT_BUCKETS = 64;
 
-    /// List of threads waiting for a address arbiter
-    std::unordered_map<VAddr, std::list<std::shared_ptr<Thread>>> arb_threads;
+    /// Threads waiting for a address arbiter, by address. They are kept alive by their process,
+    /// and unlinked when they stop.
+    Common::IntrusiveWaitTable<Thread, NUM_WAIT_BUCKETS, WaitTableTraits> waiting_threads;
 
     Core::System& system;
 };
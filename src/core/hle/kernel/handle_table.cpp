@@ -12,15 +12,6 @@
 #include "core/hle/kernel/thread.h"
 
 namespace Kernel {
-namespace {
-constexpr u16 GetSlot(Handle handle) {
-    return static_cast<u16>(handle >> 15);
-}
-
-constexpr u16 GetGeneration(Handle handle) {
-    return static_cast<u16>(handle & 0x7FFF);
-}
-} // Anonymous namespace
 
 HandleTable::HandleTable() {
     Clear();
@@ -63,6 +54,7 @@ ResultVal<Handle> HandleTable::Create(std::shared_ptr<Object> obj) {
     }
 
     generations[slot] = generation;
+    types[slot] = obj->GetHandleType();
     objects[slot] = std::move(obj);
 
     Handle handle = generation | (slot << 15);
@@ -86,19 +78,13 @@ ResultCode HandleTable::Close(Handle handle) {
     const u16 slot = GetSlot(handle);
 
     objects[slot] = nullptr;
+    types[slot] = HandleType::Unknown;
 
     generations[slot] = next_free_slot;
     next_free_slot = slot;
     return RESULT_SUCCESS;
 }
 
-bool HandleTable::IsValid(Handle handle) const {
-    const std::size_t slot = GetSlot(handle);
-    const u16 generation = GetGeneration(handle);
-
-    return slot < table_size && objects[slot] != nullptr && generations[slot] == generation;
-}
-
 std::shared_ptr<Object> HandleTable::GetGeneric(Handle handle) const {
     if (handle == CurrentThread) {
         return SharedFrom(GetCurrentThread());
@@ -112,10 +98,19 @@ std::shared_ptr<Object> HandleTable::GetGeneric(Handle handle) const {
     return objects[GetSlot(handle)];
 }
 
+Object* HandleTable::BorrowPseudoHandle(Handle handle) {
+    if (handle == CurrentThread) {
+        return GetCurrentThread();
+    }
+    ASSERT(handle == CurrentProcess);
+    return Core::System::GetInstance().CurrentProcess();
+}
+
 void HandleTable::Clear() {
     for (u16 i = 0; i < table_size; ++i) {
         generations[i] = i + 1;
         objects[i] = nullptr;
+        types[i] = HandleType::Unknown;
     }
     next_free_slot = 0;
 }
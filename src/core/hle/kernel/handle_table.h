@@ -42,6 +42,10 @@ enum KernelHandle : Handle {
  * is destroyed, it is again pushed onto the list to be re-used by the next allocation. It is
  * likely that this allocation strategy differs from the one used in CTR-OS, but this hasn't been
  * verified and isn't likely to cause any problems.
+ *
+ * The type of each object is stored next to it, so that typed lookups don't need to go through
+ * the object itself. Lookups that only need the object for the duration of an SVC should use
+ * Borrow, which avoids touching the object's reference count.
  */
 class HandleTable final : NonCopyable {
 public:
@@ -88,7 +92,11 @@ public:
     ResultCode Close(Handle handle);
 
     /// Checks if a handle is valid and points to an existing object.
-    bool IsValid(Handle handle) const;
+    bool IsValid(Handle handle) const {
+        const std::size_t slot = GetSlot(handle);
+        return slot < table_size && objects[slot] != nullptr &&
+               generations[slot] == GetGeneration(handle);
+    }
 
     /**
      * Looks up a handle.
@@ -103,16 +111,71 @@ public:
      */
     template <class T>
     std::shared_ptr<T> Get(Handle handle) const {
-        return DynamicObjectCast<T>(GetGeneric(handle));
+        if (IsPseudoHandle(handle)) {
+            return DynamicObjectCast<T>(GetGeneric(handle));
+        }
+        if (!IsValid(handle) || !IsHandleTypeOf<T>(types[GetSlot(handle)])) {
+            return nullptr;
+        }
+        return std::static_pointer_cast<T>(objects[GetSlot(handle)]);
+    }
+
+    /**
+     * Looks up a handle without taking a reference to the object.
+     * @return Pointer to the looked-up object, or `nullptr` if the handle is not valid. The pointer
+     *         is only valid until the handle is closed, or the HLE lock is released.
+     */
+    Object* BorrowGeneric(Handle handle) const {
+        if (IsPseudoHandle(handle)) {
+            return BorrowPseudoHandle(handle);
+        }
+        return IsValid(handle) ? objects[GetSlot(handle)].get() : nullptr;
+    }
+
+    /**
+     * Looks up a handle while verifying its type, without taking a reference to the object.
+     * @return Pointer to the looked-up object, or `nullptr` if the handle is not valid or its
+     *         type differs from the requested one. The pointer is only valid until the handle is
+     *         closed, or the HLE lock is released.
+     */
+    template <class T>
+    T* Borrow(Handle handle) const {
+        if (IsPseudoHandle(handle)) {
+            Object* const object = BorrowPseudoHandle(handle);
+            const bool matches = object != nullptr && IsHandleTypeOf<T>(object->GetHandleType());
+            return matches ? static_cast<T*>(object) : nullptr;
+        }
+        if (!IsValid(handle) || !IsHandleTypeOf<T>(types[GetSlot(handle)])) {
+            return nullptr;
+        }
+        return static_cast<T*>(objects[GetSlot(handle)].get());
     }
 
     /// Closes all handles held in this table.
     void Clear();
 
 private:
+    static constexpr u16 GetSlot(Handle handle) {
+        return static_cast<u16>(handle >> 15);
+    }
+
+    static constexpr u16 GetGeneration(Handle handle) {
+        return static_cast<u16>(handle & 0x7FFF);
+    }
+
+    static constexpr bool IsPseudoHandle(Handle handle) {
+        return handle == CurrentThread || handle == CurrentProcess;
+    }
+
+    /// Returns the object referred to by CurrentThread or CurrentProcess.
+    static Object* BorrowPseudoHandle(Handle handle);
+
     /// Stores the Object referenced by the handle or null if the slot is empty.
     std::array<std::shared_ptr<Object>, MAX_COUNT> objects;
 
+    /// Type of the object referenced by the handle, Unknown if the slot is empty.
+    std::array<HandleType, MAX_COUNT> types{};
+
     /**
      * The value of `next_generation` when the handle was created, used to check for validity. For
      * empty slots, contains the index of the next free slot in the list.
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <sstream>
 #include <utility>
 
@@ -32,6 +33,14 @@ SessionRequestHandler::SessionRequestHandler() = default;
 
 SessionRequestHandler::~SessionRequestHandler() = default;
 
+bool SessionRequestHandler::CanHandleAsync(const HLERequestContext& context) const {
+    return false;
+}
+
+void SessionRequestHandler::HandleAsyncRequest(HLERequestContext& context) {
+    UNREACHABLE_MSG("Handler does not support asynchronous requests");
+}
+
 void SessionRequestHandler::ClientConnected(std::shared_ptr<ServerSession> server_session) {
     server_session->SetHleHandler(shared_from_this());
     connected_sessions.push_back(std::move(server_session));
@@ -80,8 +89,19 @@ std::shared_ptr<WritableEvent> HLERequestContext::SleepClientThread(
 }
 
 HLERequestContext::HLERequestContext(std::shared_ptr<Kernel::ServerSession> server_session,
-                                     std::shared_ptr<Thread> thread)
-    : server_session(std::move(server_session)), thread(std::move(thread)) {
+                                     std::shared_ptr<Thread> thread, Common::Arena* arena)
+    : server_session(std::move(server_session)), thread(std::move(thread)),
+      buffer_x_desciptors(Common::ArenaAllocator<IPC::BufferDescriptorX>{arena}),
+      buffer_a_desciptors(Common::ArenaAllocator<IPC::BufferDescriptorABW>{arena}),
+      buffer_b_desciptors(Common::ArenaAllocator<IPC::BufferDescriptorABW>{arena}),
+      buffer_w_desciptors(Common::ArenaAllocator<IPC::BufferDescriptorABW>{arena}),
+      buffer_c_desciptors(Common::ArenaAllocator<IPC::BufferDescriptorC>{arena}),
+      domain_request_handlers(
+          Common::ArenaAllocator<std::shared_ptr<SessionRequestHandler>>{arena}),
+      read_scratch_buffers(Common::ArenaAllocator<Common::ArenaVector<u8>>{arena}),
+      pending_buffer_writes(Common::ArenaAllocator<PendingBufferWrite>{arena}),
+      detached_read_buffers(Common::ArenaAllocator<DetachedBuffer>{arena}),
+      detached_write_buffers(Common::ArenaAllocator<DetachedBuffer>{arena}) {
     cmd_buf[0] = 0;
 }
 
@@ -279,10 +299,77 @@ ResultCode HLERequestContext::WriteToOutgoingCommandBuffer(Thread& thread) {
     memory.WriteBlock(owner_process, thread.GetTLSAddress(), dst_cmdbuf.data(),
                       dst_cmdbuf.size() * sizeof(u32));
 
+    // Write back output buffers that could not be accessed in place.
+    for (const auto& write : pending_buffer_writes) {
+        memory.WriteBlock(owner_process, write.address, write.data.data(), write.data.size());
+    }
+    pending_buffer_writes.clear();
+    WriteBackBuffers(owner_process);
+
     return RESULT_SUCCESS;
 }
 
+void HLERequestContext::DetachBuffers(const Process& process) {
+    auto& memory = Core::System::GetInstance().Memory();
+    const auto detach = [&memory, &process](auto& buffers, VAddr address, std::size_t size) {
+        const Common::ArenaAllocator<u8> allocator{buffers.get_allocator()};
+        auto& buffer = buffers.emplace_back(
+            DetachedBuffer{address, Common::ArenaVector<u8>(size, allocator), 0});
+        memory.ReadBlock(process, address, buffer.data.data(), size);
+    };
+
+    // Buffers are picked the same way ReadBuffer and WriteBuffer do.
+    const std::size_t num_read_buffers =
+        std::max(buffer_a_desciptors.size(), buffer_x_desciptors.size());
+    for (std::size_t i = 0; i < num_read_buffers; ++i) {
+        if (i < buffer_a_desciptors.size() && buffer_a_desciptors[i].Size() != 0) {
+            detach(detached_read_buffers, buffer_a_desciptors[i].Address(),
+                   buffer_a_desciptors[i].Size());
+        } else if (i < buffer_x_desciptors.size()) {
+            detach(detached_read_buffers, buffer_x_desciptors[i].Address(),
+                   buffer_x_desciptors[i].Size());
+        } else {
+            detach(detached_read_buffers, 0, 0);
+        }
+    }
+
+    // Output buffers start with their current contents, as handlers may only write parts of them.
+    const std::size_t num_write_buffers =
+        std::max(buffer_b_desciptors.size(), buffer_c_desciptors.size());
+    for (std::size_t i = 0; i < num_write_buffers; ++i) {
+        if (i < buffer_b_desciptors.size() && buffer_b_desciptors[i].Size() != 0) {
+            detach(detached_write_buffers, buffer_b_desciptors[i].Address(),
+                   buffer_b_desciptors[i].Size());
+        } else if (i < buffer_c_desciptors.size()) {
+            detach(detached_write_buffers, buffer_c_desciptors[i].Address(),
+                   buffer_c_desciptors[i].Size());
+        } else {
+            detach(detached_write_buffers, 0, 0);
+        }
+    }
+
+    buffers_detached = true;
+}
+
+void HLERequestContext::WriteBackBuffers(const Process& process) {
+    auto& memory = Core::System::GetInstance().Memory();
+    for (const auto& buffer : detached_write_buffers) {
+        if (buffer.written != 0) {
+            memory.WriteBlock(process, buffer.address, buffer.data.data(), buffer.written);
+        }
+    }
+    detached_read_buffers.clear();
+    detached_write_buffers.clear();
+}
+
 std::vector<u8> HLERequestContext::ReadBuffer(int buffer_index) const {
+    if (buffers_detached) {
+        ASSERT_MSG(detached_read_buffers.size() > buffer_index, "Invalid buffer_index {}",
+                   buffer_index);
+        const auto& data = detached_read_buffers[buffer_index].data;
+        return std::vector<u8>(data.begin(), data.end());
+    }
+
     std::vector<u8> buffer;
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
@@ -319,6 +406,15 @@ std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
         size = buffer_size; // TODO(bunnei): This needs to be HW tested
     }
 
+    if (buffers_detached) {
+        ASSERT_MSG(detached_write_buffers.size() > buffer_index, "Invalid buffer_index {}",
+                   buffer_index);
+        auto& detached = detached_write_buffers[buffer_index];
+        std::memcpy(detached.data.data(), buffer, size);
+        detached.written = std::max(detached.written, size);
+        return size;
+    }
+
     auto& memory = Core::System::GetInstance().Memory();
     if (is_buffer_b) {
         ASSERT_MSG(BufferDescriptorB().size() > buffer_index,
@@ -337,6 +433,80 @@ std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
     return size;
 }
 
+Common::Span<const u8> HLERequestContext::ReadBufferSpan(int buffer_index) const {
+    if (buffers_detached) {
+        ASSERT_MSG(detached_read_buffers.size() > buffer_index, "Invalid buffer_index {}",
+                   buffer_index);
+        return detached_read_buffers[buffer_index].data;
+    }
+
+    const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
+                           BufferDescriptorA()[buffer_index].Size()};
+    VAddr address;
+    std::size_t size;
+    if (is_buffer_a) {
+        address = BufferDescriptorA()[buffer_index].Address();
+        size = BufferDescriptorA()[buffer_index].Size();
+    } else {
+        ASSERT_MSG(BufferDescriptorX().size() > buffer_index,
+                   "BufferDescriptorX invalid buffer_index {}", buffer_index);
+        address = BufferDescriptorX()[buffer_index].Address();
+        size = BufferDescriptorX()[buffer_index].Size();
+    }
+    if (size == 0) {
+        return {};
+    }
+
+    auto& memory = Core::System::GetInstance().Memory();
+    if (const u8* const pointer = memory.GetContiguousSpan(address, size)) {
+        return {pointer, size};
+    }
+
+    const Common::ArenaAllocator<u8> allocator{read_scratch_buffers.get_allocator()};
+    auto& scratch = read_scratch_buffers.emplace_back(size, allocator);
+    memory.ReadBlock(address, scratch.data(), size);
+    return scratch;
+}
+
+Common::Span<u8> HLERequestContext::WriteBufferSpan(int buffer_index) {
+    if (buffers_detached) {
+        ASSERT_MSG(detached_write_buffers.size() > buffer_index, "Invalid buffer_index {}",
+                   buffer_index);
+        auto& detached = detached_write_buffers[buffer_index];
+        detached.written = detached.data.size();
+        return detached.data;
+    }
+
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    VAddr address;
+    std::size_t size;
+    if (is_buffer_b) {
+        address = BufferDescriptorB()[buffer_index].Address();
+        size = BufferDescriptorB()[buffer_index].Size();
+    } else {
+        ASSERT_MSG(BufferDescriptorC().size() > buffer_index,
+                   "BufferDescriptorC invalid buffer_index {}", buffer_index);
+        address = BufferDescriptorC()[buffer_index].Address();
+        size = BufferDescriptorC()[buffer_index].Size();
+    }
+    if (size == 0) {
+        return {};
+    }
+
+    auto& memory = Core::System::GetInstance().Memory();
+    if (u8* const pointer = memory.GetContiguousSpan(address, size)) {
+        return {pointer, size};
+    }
+
+    // Start from the current contents, so that the parts the handler skips are left unchanged.
+    const Common::ArenaAllocator<u8> allocator{pending_buffer_writes.get_allocator()};
+    auto& write = pending_buffer_writes.emplace_back(
+        PendingBufferWrite{address, Common::ArenaVector<u8>(size, allocator)});
+    memory.ReadBlock(address, write.data.data(), size);
+    return write.data;
+}
+
 std::size_t HLERequestContext::GetReadBufferSize(int buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
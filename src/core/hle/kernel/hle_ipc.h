@@ -7,12 +7,15 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <type_traits>
 #include <vector>
 #include <boost/container/small_vector.hpp>
+#include "common/arena.h"
 #include "common/common_types.h"
+#include "common/span.h"
 #include "common/swap.h"
 #include "core/hle/ipc.h"
 #include "core/hle/kernel/object.h"
@@ -56,6 +59,22 @@ public:
      */
     virtual ResultCode HandleSyncRequest(Kernel::HLERequestContext& context) = 0;
 
+    /**
+     * Returns whether a request may be handled by HandleAsyncRequest on a service thread rather
+     * than by HandleSyncRequest on the emulated core. Requests are never handled asynchronously
+     * unless Settings::values.use_async_services is enabled.
+     */
+    virtual bool CanHandleAsync(const Kernel::HLERequestContext& context) const;
+
+    /**
+     * Handles a request accepted by CanHandleAsync, from a service thread and without the HLE
+     * lock held. Requests to a handler are handled one at a time, and never while it handles a
+     * request through HandleSyncRequest. The buffers of the request are detached from guest
+     * memory, and the response and output buffers are written back to the guest by the caller
+     * once the handler returns.
+     */
+    virtual void HandleAsyncRequest(Kernel::HLERequestContext& context);
+
     /**
      * Signals that a client has just connected to this HLE handler and keeps the
      * associated ServerSession alive for the duration of the connection.
@@ -75,6 +94,16 @@ protected:
     /// A ServerSession whose server endpoint is an HLE implementation is kept alive by this list
     /// for the duration of the connection.
     std::vector<std::shared_ptr<ServerSession>> connected_sessions;
+
+private:
+    friend class ServerSession;
+
+    /// Serializes the requests to this handler running on the service threads.
+    std::mutex async_request_mutex;
+
+    /// Number of requests to this handler queued to or running on the service threads. Only
+    /// accessed with the HLE lock held, sync requests are deferred while it is nonzero.
+    u32 pending_async_requests = 0;
 };
 
 /**
@@ -95,11 +124,14 @@ protected:
  * The end result is similar to just giving services their own real handle tables, but since these
  * ids are local to a specific context, it avoids requiring services to manage handles for objects
  * across multiple calls and ensuring that unneeded handles are cleaned up.
+ *
+ * The request-scoped containers of a context draw from the arena it was created with, if any.
+ * Copies of a context, such as the ones kept by SleepClientThread, use the heap instead.
  */
 class HLERequestContext {
 public:
     explicit HLERequestContext(std::shared_ptr<ServerSession> session,
-                               std::shared_ptr<Thread> thread);
+                               std::shared_ptr<Thread> thread, Common::Arena* arena = nullptr);
     ~HLERequestContext();
 
     /// Returns a pointer to the IPC command buffer for this request.
@@ -142,6 +174,21 @@ public:
     /// Writes data from this context back to the requesting process/thread.
     ResultCode WriteToOutgoingCommandBuffer(Thread& thread);
 
+    /**
+     * Copies the buffers of the request out of the memory of a process, so that it can be handled
+     * away from the emulated cores. Buffer reads and writes then go to these copies, and written
+     * output buffers reach the guest through WriteBackBuffers. Must be called from an emulated
+     * core.
+     */
+    void DetachBuffers(const Process& process);
+
+    /**
+     * Writes the output buffers written since DetachBuffers back to the memory of a process, and
+     * drops the copies. Must be called from an emulated core. WriteToOutgoingCommandBuffer does
+     * this as well.
+     */
+    void WriteBackBuffers(const Process& process);
+
     u32_le GetCommand() const {
         return command;
     }
@@ -154,19 +201,19 @@ public:
         return data_payload_offset;
     }
 
-    const std::vector<IPC::BufferDescriptorX>& BufferDescriptorX() const {
+    const Common::ArenaVector<IPC::BufferDescriptorX>& BufferDescriptorX() const {
         return buffer_x_desciptors;
     }
 
-    const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorA() const {
+    const Common::ArenaVector<IPC::BufferDescriptorABW>& BufferDescriptorA() const {
         return buffer_a_desciptors;
     }
 
-    const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorB() const {
+    const Common::ArenaVector<IPC::BufferDescriptorABW>& BufferDescriptorB() const {
         return buffer_b_desciptors;
     }
 
-    const std::vector<IPC::BufferDescriptorC>& BufferDescriptorC() const {
+    const Common::ArenaVector<IPC::BufferDescriptorC>& BufferDescriptorC() const {
         return buffer_c_desciptors;
     }
 
@@ -204,6 +251,21 @@ public:
                            buffer_index);
     }
 
+    /**
+     * Gets a view of an input buffer, using the appropriate buffer descriptor. Guest memory is
+     * viewed in place when it is contiguous on the host, otherwise it is copied into scratch
+     * memory owned by this context. The view is valid until the context is destroyed.
+     */
+    Common::Span<const u8> ReadBufferSpan(int buffer_index = 0) const;
+
+    /**
+     * Gets a writable view of a whole output buffer, using the appropriate buffer descriptor.
+     * Guest memory is viewed in place when it is contiguous on the host, otherwise it is viewed
+     * through a scratch copy that is written back with the reply. Avoid mixing it with
+     * WriteBuffer on the same buffer, as the scratch copy would overwrite the data written there.
+     */
+    Common::Span<u8> WriteBufferSpan(int buffer_index = 0);
+
     /// Helper function to get the size of the input buffer
     std::size_t GetReadBufferSize(int buffer_index = 0) const;
 
@@ -239,7 +301,7 @@ public:
 
     void SetDomainRequestHandlers(
         const std::vector<std::shared_ptr<SessionRequestHandler>>& handlers) {
-        domain_request_handlers = handlers;
+        domain_request_handlers.assign(handlers.begin(), handlers.end());
     }
 
     /// Clears the list of objects so that no lingering objects are written accidentally to the
@@ -291,18 +353,41 @@ private:
     std::optional<IPC::HandleDescriptorHeader> handle_descriptor_header;
     std::optional<IPC::DataPayloadHeader> data_payload_header;
     std::optional<IPC::DomainMessageHeader> domain_message_header;
-    std::vector<IPC::BufferDescriptorX> buffer_x_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_a_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_b_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_w_desciptors;
-    std::vector<IPC::BufferDescriptorC> buffer_c_desciptors;
+    Common::ArenaVector<IPC::BufferDescriptorX> buffer_x_desciptors;
+    Common::ArenaVector<IPC::BufferDescriptorABW> buffer_a_desciptors;
+    Common::ArenaVector<IPC::BufferDescriptorABW> buffer_b_desciptors;
+    Common::ArenaVector<IPC::BufferDescriptorABW> buffer_w_desciptors;
+    Common::ArenaVector<IPC::BufferDescriptorC> buffer_c_desciptors;
 
     unsigned data_payload_offset{};
     unsigned buffer_c_offset{};
     u32_le command{};
 
-    std::vector<std::shared_ptr<SessionRequestHandler>> domain_request_handlers;
+    Common::ArenaVector<std::shared_ptr<SessionRequestHandler>> domain_request_handlers;
     bool is_thread_waiting{};
+
+    /// Output buffer handed out through a scratch copy, written back with the reply.
+    struct PendingBufferWrite {
+        VAddr address;
+        Common::ArenaVector<u8> data;
+    };
+
+    /// Copies of input buffers that are not contiguous in host memory.
+    mutable Common::ArenaVector<Common::ArenaVector<u8>> read_scratch_buffers;
+    Common::ArenaVector<PendingBufferWrite> pending_buffer_writes;
+
+    /// Copy of a guest buffer made by DetachBuffers.
+    struct DetachedBuffer {
+        VAddr address;
+        Common::ArenaVector<u8> data;
+        /// Number of bytes to write back, output buffers only.
+        std::size_t written;
+    };
+
+    /// Copies of the input and output buffers, by buffer index, once they are detached.
+    Common::ArenaVector<DetachedBuffer> detached_read_buffers;
+    mutable Common::ArenaVector<DetachedBuffer> detached_write_buffers;
+    bool buffers_detached{};
 };
 
 } // namespace Kernel
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <atomic>
 #include <bitset>
 #include <functional>
@@ -27,12 +28,15 @@
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/resource_limit.h"
 #include "core/hle/kernel/scheduler.h"
+#include "core/hle/kernel/service_thread_pool.h"
+#include "core/hle/kernel/svc_stats.h"
 #include "core/hle/kernel/synchronization.h"
 #include "core/hle/kernel/thread.h"
 #include "core/hle/kernel/time_manager.h"
 #include "core/hle/lock.h"
 #include "core/hle/result.h"
 #include "core/memory.h"
+#include "core/settings.h"
 
 namespace Kernel {
 
@@ -74,7 +78,7 @@ static void ThreadWakeupCallback(u64 thread_handle, [[maybe_unused]] s64 cycles_
         thread->SetMutexWaitAddress(0);
         thread->SetWaitHandle(0);
         if (thread->GetStatus() == ThreadStatus::WaitCondVar) {
-            thread->GetOwnerProcess()->RemoveConditionVariableThread(thread);
+            thread->GetOwnerProcess()->RemoveConditionVariableThread(thread.get());
             thread->SetCondVarWaitAddress(0);
         }
 
@@ -89,7 +93,7 @@ static void ThreadWakeupCallback(u64 thread_handle, [[maybe_unused]] s64 cycles_
 
     if (thread->GetStatus() == ThreadStatus::WaitArb) {
         auto& address_arbiter = thread->GetOwnerProcess()->GetAddressArbiter();
-        address_arbiter.HandleWakeupThread(thread);
+        address_arbiter.HandleWakeupThread(thread.get());
     }
 
     if (resume) {
@@ -112,9 +116,13 @@ struct KernelCore::Impl {
         InitializeSystemResourceLimit(kernel);
         InitializeThreads();
         InitializePreemption();
+        InitializeServiceThreadPool(kernel);
     }
 
     void Shutdown() {
+        // Finish the requests in flight while the objects they refer to are still around.
+        service_thread_pool.reset();
+
         next_object_id = 0;
         next_kernel_process_id = Process::InitialKIPIDMin;
         next_user_process_id = Process::ProcessIDMin;
@@ -138,6 +146,13 @@ struct KernelCore::Impl {
         }
         cores.clear();
 
+        {
+            std::lock_guard lock{register_thread_mutex};
+            host_thread_ids.clear();
+            registered_thread_ids = Core::Hardware::NUM_CPU_CORES;
+            registered_core_threads.reset();
+        }
+
         exclusive_monitor.reset();
     }
 
@@ -162,6 +177,19 @@ struct KernelCore::Impl {
         ASSERT(system_resource_limit->SetLimitValue(ResourceType::Sessions, 900).IsSuccess());
     }
 
+    void InitializeServiceThreadPool(KernelCore& kernel) {
+        // With a single host thread emulating every core, requests completed from another thread
+        // would make guest scheduling depend on host timing, for little gain as nothing else runs
+        // while the core waits for the HLE lock.
+        if (!Settings::values.use_async_services || !Settings::values.use_multi_core) {
+            return;
+        }
+        // Service requests mostly wait on the host, a few threads are enough to overlap them.
+        const std::size_t num_threads =
+            std::clamp<std::size_t>(std::thread::hardware_concurrency() / 4, 2, 4);
+        service_thread_pool = std::make_unique<Kernel::ServiceThreadPool>(kernel, num_threads);
+    }
+
     void InitializeThreads() {
         thread_wakeup_event_type =
             Core::Timing::CreateEvent("ThreadWakeupCallback", ThreadWakeupCallback);
@@ -248,6 +276,7 @@ struct KernelCore::Impl {
     Kernel::GlobalScheduler global_scheduler;
     Kernel::Synchronization synchronization;
     Kernel::TimeManager time_manager;
+    Kernel::SVCStatsRegistry svc_stats;
 
     std::shared_ptr<ResourceLimit> system_resource_limit;
 
@@ -265,6 +294,8 @@ struct KernelCore::Impl {
     std::unique_ptr<Core::ExclusiveMonitor> exclusive_monitor;
     std::vector<Kernel::PhysicalCore> cores;
 
+    std::unique_ptr<Kernel::ServiceThreadPool> service_thread_pool;
+
     // 0-3 IDs represent core threads, >3 represent others
     std::unordered_map<std::thread::id, u32> host_thread_ids;
     u32 registered_thread_ids{Core::Hardware::NUM_CPU_CORES};
@@ -356,6 +387,18 @@ const Kernel::TimeManager& KernelCore::TimeManager() const {
     return impl->time_manager;
 }
 
+Kernel::ServiceThreadPool* KernelCore::ServiceThreadPool() {
+    return impl->service_thread_pool.get();
+}
+
+Kernel::SVCStatsRegistry& KernelCore::SVCStats() {
+    return impl->svc_stats;
+}
+
+const Kernel::SVCStatsRegistry& KernelCore::SVCStats() const {
+    return impl->svc_stats;
+}
+
 Core::ExclusiveMonitor& KernelCore::GetExclusiveMonitor() {
     return *impl->exclusive_monitor;
 }
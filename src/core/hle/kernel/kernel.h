@@ -31,6 +31,8 @@ class PhysicalCore;
 class Process;
 class ResourceLimit;
 class Scheduler;
+class ServiceThreadPool;
+class SVCStatsRegistry;
 class Synchronization;
 class Thread;
 class TimeManager;
@@ -114,6 +116,16 @@ public:
     /// Gets the an instance of the TimeManager Interface.
     const Kernel::TimeManager& TimeManager() const;
 
+    /// Gets the threads running HLE service requests asynchronously, or nullptr if they are
+    /// disabled. See Settings::values.use_async_services.
+    Kernel::ServiceThreadPool* ServiceThreadPool();
+
+    /// Gets the call statistics of SVCs.
+    Kernel::SVCStatsRegistry& SVCStats();
+
+    /// Gets the call statistics of SVCs.
+    const Kernel::SVCStatsRegistry& SVCStats() const;
+
     /// Stops execution of 'id' core, in order to reschedule a new thread.
     void PrepareReschedule(std::size_t id);
 
@@ -73,12 +73,12 @@ ResultCode Mutex::TryAcquire(VAddr address, Handle holding_thread_handle,
     const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
     std::shared_ptr<Thread> current_thread =
         SharedFrom(system.CurrentScheduler().GetCurrentThread());
-    std::shared_ptr<Thread> holding_thread = handle_table.Get<Thread>(holding_thread_handle);
-    std::shared_ptr<Thread> requesting_thread = handle_table.Get<Thread>(requesting_thread_handle);
+    Thread* const holding_thread = handle_table.Borrow<Thread>(holding_thread_handle);
+    const Thread* const requesting_thread = handle_table.Borrow<Thread>(requesting_thread_handle);
 
     // TODO(Subv): It is currently unknown if it is possible to lock a mutex in behalf of another
     // thread.
-    ASSERT(requesting_thread == current_thread);
+    ASSERT(requesting_thread == current_thread.get());
 
     const u32 addr_value = system.Memory().Read32(address);
 
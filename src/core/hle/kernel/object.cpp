@@ -8,11 +8,8 @@
 
 namespace Kernel {
 
-Object::Object(KernelCore& kernel) : kernel{kernel}, object_id{kernel.CreateNewObjectID()} {}
-Object::~Object() = default;
-
-bool Object::IsWaitable() const {
-    switch (GetHandleType()) {
+bool IsWaitableHandleType(HandleType type) {
+    switch (type) {
     case HandleType::ReadableEvent:
     case HandleType::Thread:
     case HandleType::Process:
@@ -35,4 +32,11 @@ bool Object::IsWaitable() const {
     return false;
 }
 
+Object::Object(KernelCore& kernel) : kernel{kernel}, object_id{kernel.CreateNewObjectID()} {}
+Object::~Object() = default;
+
+bool Object::IsWaitable() const {
+    return IsWaitableHandleType(GetHandleType());
+}
+
 } // namespace Kernel
@@ -32,6 +32,9 @@ enum class HandleType : u32 {
     Session,
 };
 
+/// Returns whether threads can wait on objects of the given type.
+bool IsWaitableHandleType(HandleType type);
+
 class Object : NonCopyable, public std::enable_shared_from_this<Object> {
 public:
     explicit Object(KernelCore& kernel);
@@ -64,6 +67,15 @@ private:
     std::atomic<u32> object_id{0};
 };
 
+/**
+ * Returns whether objects of the given type are of type T. Specialized for base classes of several
+ * object types.
+ */
+template <typename T>
+inline bool IsHandleTypeOf(HandleType type) {
+    return type == T::HANDLE_TYPE;
+}
+
 template <typename T>
 std::shared_ptr<T> SharedFrom(T* raw) {
     if (raw == nullptr)
@@ -77,7 +89,7 @@ std::shared_ptr<T> SharedFrom(T* raw) {
  */
 template <typename T>
 inline std::shared_ptr<T> DynamicObjectCast(std::shared_ptr<Object> object) {
-    if (object != nullptr && object->GetHandleType() == T::HANDLE_TYPE) {
+    if (object != nullptr && IsHandleTypeOf<T>(object->GetHandleType())) {
         return std::static_pointer_cast<T>(object);
     }
     return nullptr;
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include "common/logging/log.h"
+#include "common/thread.h"
 #include "core/arm/arm_interface.h"
 #ifdef ARCHITECTURE_x86_64
 #include "core/arm/dynarmic/arm_dynarmic_32.h"
@@ -32,10 +33,14 @@ PhysicalCore::PhysicalCore(Core::System& system, std::size_t id,
 #endif
 
     scheduler = std::make_unique<Kernel::Scheduler>(system, core_index);
+    interrupt_event = std::make_unique<Common::Event>();
 }
 
 PhysicalCore::~PhysicalCore() = default;
 
+PhysicalCore::PhysicalCore(PhysicalCore&&) = default;
+PhysicalCore& PhysicalCore::operator=(PhysicalCore&&) = default;
+
 void PhysicalCore::Run() {
     arm_interface->Run();
     arm_interface->ClearExclusiveState();
@@ -47,6 +52,11 @@ void PhysicalCore::Step() {
 
 void PhysicalCore::Stop() {
     arm_interface->PrepareReschedule();
+    interrupt_event->Set();
+}
+
+void PhysicalCore::WaitForInterrupt(std::chrono::microseconds timeout) {
+    interrupt_event->WaitUntil(std::chrono::steady_clock::now() + timeout);
 }
 
 void PhysicalCore::Shutdown() {
@@ -4,9 +4,14 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
 
+namespace Common {
+class Event;
+} // namespace Common
+
 namespace Kernel {
 class Scheduler;
 } // namespace Kernel
@@ -27,16 +32,19 @@ public:
     PhysicalCore(const PhysicalCore&) = delete;
     PhysicalCore& operator=(const PhysicalCore&) = delete;
 
-    PhysicalCore(PhysicalCore&&) = default;
-    PhysicalCore& operator=(PhysicalCore&&) = default;
+    PhysicalCore(PhysicalCore&&);
+    PhysicalCore& operator=(PhysicalCore&&);
 
     /// Execute current jit state
     void Run();
     /// Execute a single instruction in current jit.
     void Step();
-    /// Stop JIT execution/exit
+    /// Stop JIT execution/exit, waking the core up if it is waiting for an interrupt.
     void Stop();
 
+    /// Blocks until the core is stopped or the timeout expires. Used by idle cores in multicore.
+    void WaitForInterrupt(std::chrono::microseconds timeout);
+
     // Shutdown this physical core.
     void Shutdown();
 
@@ -76,6 +84,7 @@ private:
     std::unique_ptr<Core::ARM_Interface> arm_interface_64;
     std::unique_ptr<Kernel::Scheduler> scheduler;
     Core::ARM_Interface* arm_interface{};
+    std::unique_ptr<Common::Event> interrupt_event;
 };
 
 } // namespace Kernel
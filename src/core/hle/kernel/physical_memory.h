@@ -4,17 +4,21 @@
 
 #pragma once
 
-#include "common/alignment.h"
+#include <vector>
+#include "common/common_types.h"
+#include "common/host_memory.h"
 
 namespace Kernel {
 
-// This encapsulation serves 2 purposes:
+// This encapsulation serves 3 purposes:
 // - First, to encapsulate host physical memory under a single type and set an
 // standard for managing it.
 // - Second to ensure all host backing memory used is aligned to 256 bytes due
-// to strict alignment restrictions on GPU memory.
+// to strict alignment restrictions on GPU memory. Allocations are page aligned,
+// which satisfies this.
+// - Third, to allow large allocations to be backed by host huge pages.
 
-using PhysicalMemoryVector = std::vector<u8, Common::AlignmentAllocator<u8, 256>>;
+using PhysicalMemoryVector = std::vector<u8, Common::HostMemoryAllocator<u8>>;
 class PhysicalMemory final : public PhysicalMemoryVector {
     using PhysicalMemoryVector::PhysicalMemoryVector;
 };
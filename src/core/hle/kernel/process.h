@@ -8,9 +8,10 @@
 #include <cstddef>
 #include <list>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "common/common_types.h"
+#include "common/intrusive_wait_table.h"
 #include "core/hle/kernel/address_arbiter.h"
 #include "core/hle/kernel/handle_table.h"
 #include "core/hle/kernel/mutex.h"
@@ -238,13 +239,21 @@ public:
     }
 
     /// Insert a thread into the condition variable wait container
-    void InsertConditionVariableThread(std::shared_ptr<Thread> thread);
+    void InsertConditionVariableThread(Thread* thread);
 
     /// Remove a thread from the condition variable wait container
-    void RemoveConditionVariableThread(std::shared_ptr<Thread> thread);
+    void RemoveConditionVariableThread(Thread* thread);
 
-    /// Obtain all condition variable threads waiting for some address
-    std::vector<std::shared_ptr<Thread>> GetConditionVariableThreads(VAddr cond_var_addr);
+    /**
+     * Removes up to max_count threads waiting for some address from the condition variable wait
+     * container, in priority order, and calls func on each of them once it is removed.
+     * @return The number of removed threads.
+     */
+    template <typename Func>
+    std::size_t WakeConditionVariableThreads(VAddr cond_var_addr, std::size_t max_count,
+                                             Func&& func) {
+        return cond_var_threads.wake(cond_var_addr, max_count, std::forward<Func>(func));
+    }
 
     /// Registers a thread as being created under this process,
     /// adding it to this process' thread list.
@@ -382,8 +391,20 @@ private:
     /// List of threads that are running with this process as their owner.
     std::list<const Thread*> thread_list;
 
-    /// List of threads waiting for a condition variable
-    std::unordered_map<VAddr, std::list<std::shared_ptr<Thread>>> cond_var_threads;
+    struct CondVarTableTraits {
+        static Common::WaitTableLink<Thread>& GetLink(Thread& thread);
+        static u64 GetKey(const Thread& thread);
+        static u32 GetPriority(const Thread& thread);
+        // Threads of the same priority are signaled in the order they started waiting.
+        static constexpr auto TIE_BREAK = Common::WaitTableTieBreak::FirstInFirstOut;
+    };
+
+    /// Number of buckets the threads waiting for a condition variable are hashed into by address.
+    static constexpr std::size_t NUM_COND_VAR_BUCKETS = 64;
+
+    /// Threads waiting for a condition variable, by address. They are kept alive by this process,
+    /// and unlinked when they stop.
+    Common::IntrusiveWaitTable<Thread, NUM_COND_VAR_BUCKETS, CondVarTableTraits> cond_var_threads;
 
     /// System context
     Core::System& system;
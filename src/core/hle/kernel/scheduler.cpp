@@ -6,11 +6,11 @@
 // licensed under GPLv2 or later under exception provided by the author.
 
 #include <algorithm>
-#include <set>
 #include <unordered_set>
 #include <utility>
 
 #include "common/assert.h"
+#include "common/bit_util.h"
 #include "common/logging/log.h"
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
@@ -22,7 +22,12 @@
 
 namespace Kernel {
 
-GlobalScheduler::GlobalScheduler(KernelCore& kernel) : kernel{kernel} {}
+GlobalScheduler::GlobalScheduler(KernelCore& kernel) : kernel{kernel} {
+    for (std::size_t core = 0; core < Core::Hardware::NUM_CPU_CORES; core++) {
+        scheduled_queue[core] = ScheduledQueue{core};
+        suggested_queue[core] = SuggestedQueue{core};
+    }
+}
 
 GlobalScheduler::~GlobalScheduler() = default;
 
@@ -53,7 +58,7 @@ void GlobalScheduler::SelectThread(std::size_t core) {
     };
     Scheduler& sched = kernel.Scheduler(core);
     Thread* current_thread = nullptr;
-    // Step 1: Get top thread in schedule queue.
+    // Step 1: Get top thread in schedule queue. This only looks at the queue of this core.
     current_thread = scheduled_queue[core].empty() ? nullptr : scheduled_queue[core].front();
     if (current_thread) {
         update_thread(current_thread, sched);
@@ -61,7 +66,7 @@ void GlobalScheduler::SelectThread(std::size_t core) {
     }
     // Step 2: Try selecting a suggested thread.
     Thread* winner = nullptr;
-    std::set<s32> sug_cores;
+    u32 sug_cores = 0;
     for (auto thread : suggested_queue[core]) {
         s32 this_core = thread->GetProcessorID();
         Thread* thread_on_core = nullptr;
@@ -72,7 +77,7 @@ void GlobalScheduler::SelectThread(std::size_t core) {
             winner = thread;
             break;
         }
-        sug_cores.insert(this_core);
+        sug_cores |= 1U << this_core;
     }
     // if we got a suggested thread, select it, else do a second pass.
     if (winner && winner->GetPriority() > 2) {
@@ -84,7 +89,8 @@ void GlobalScheduler::SelectThread(std::size_t core) {
         return;
     }
     // Step 3: Select a suggested thread from another core
-    for (auto& src_core : sug_cores) {
+    for (; sug_cores != 0; sug_cores &= sug_cores - 1) {
+        const u32 src_core = Common::CountTrailingZeroes32(sug_cores);
         auto it = scheduled_queue[src_core].begin();
         it++;
         if (it != scheduled_queue[src_core].end()) {
@@ -223,11 +229,11 @@ void GlobalScheduler::PreemptThreads() {
         Thread* current_thread =
             scheduled_queue[core_id].empty() ? nullptr : scheduled_queue[core_id].front();
         Thread* winner = nullptr;
-        for (auto& thread : suggested_queue[core_id]) {
+        // Only the suggested threads at the preemption priority are candidates.
+        for (auto it = suggested_queue[core_id].begin(priority);
+             it != suggested_queue[core_id].end(priority); ++it) {
+            Thread* const thread = *it;
             const s32 source_core = thread->GetProcessorID();
-            if (thread->GetPriority() != priority) {
-                continue;
-            }
             if (source_core >= 0) {
                 Thread* next_thread = scheduled_queue[source_core].empty()
                                           ? nullptr
@@ -256,11 +262,10 @@ void GlobalScheduler::PreemptThreads() {
         }
 
         if (current_thread != nullptr && current_thread->GetPriority() > priority) {
-            for (auto& thread : suggested_queue[core_id]) {
+            for (auto it = suggested_queue[core_id].begin(priority);
+                 it != suggested_queue[core_id].end(); ++it) {
+                Thread* const thread = *it;
                 const s32 source_core = thread->GetProcessorID();
-                if (thread->GetPriority() < priority) {
-                    continue;
-                }
                 if (source_core >= 0) {
                     Thread* next_thread = scheduled_queue[source_core].empty()
                                               ? nullptr
@@ -10,7 +10,8 @@
 #include <vector>
 
 #include "common/common_types.h"
-#include "common/multi_level_queue.h"
+#include "common/intrusive_multi_level_queue.h"
+#include "common/spin_lock.h"
 #include "core/hardware_properties.h"
 #include "core/hle/kernel/thread.h"
 
@@ -158,11 +159,26 @@ private:
 
     bool AskForReselectionOrMarkRedundant(Thread* current_thread, const Thread* winner);
 
+    struct ScheduledQueueLinks {
+        Thread::SchedulerQueueLink& operator()(Thread& thread, std::size_t core) const {
+            return thread.GetScheduledQueueLink(core);
+        }
+    };
+    struct SuggestedQueueLinks {
+        Thread::SchedulerQueueLink& operator()(Thread& thread, std::size_t core) const {
+            return thread.GetSuggestedQueueLink(core);
+        }
+    };
+
+    // Queues are indexed by core, which selects the links threads use within them.
+    using ScheduledQueue =
+        Common::IntrusiveMultiLevelQueue<Thread, THREADPRIO_COUNT, ScheduledQueueLinks>;
+    using SuggestedQueue =
+        Common::IntrusiveMultiLevelQueue<Thread, THREADPRIO_COUNT, SuggestedQueueLinks>;
+
     static constexpr u32 min_regular_priority = 2;
-    std::array<Common::MultiLevelQueue<Thread*, THREADPRIO_COUNT>, Core::Hardware::NUM_CPU_CORES>
-        scheduled_queue;
-    std::array<Common::MultiLevelQueue<Thread*, THREADPRIO_COUNT>, Core::Hardware::NUM_CPU_CORES>
-        suggested_queue;
+    std::array<ScheduledQueue, Core::Hardware::NUM_CPU_CORES> scheduled_queue;
+    std::array<SuggestedQueue, Core::Hardware::NUM_CPU_CORES> suggested_queue;
     std::atomic<bool> is_reselection_pending{false};
 
     // The priority levels at which the global scheduler preempts threads every 10 ms. They are
@@ -170,7 +186,7 @@ private:
     std::array<u32, Core::Hardware::NUM_CPU_CORES> preemption_priorities = {59, 59, 59, 62};
 
     /// Scheduler lock mechanisms.
-    std::mutex inner_lock{}; // TODO(Blinkhawk): Replace for a SpinLock
+    Common::SpinLock inner_lock{};
     std::atomic<s64> scope_lock{};
     Core::EmuThreadHandle current_owner{Core::EmuThreadHandle::InvalidHandle()};
 
@@ -18,12 +18,20 @@
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/server_session.h"
+#include "core/hle/kernel/service_thread_pool.h"
 #include "core/hle/kernel/session.h"
 #include "core/hle/kernel/thread.h"
+#include "core/hle/kernel/writable_event.h"
+#include "core/hle/lock.h"
 #include "core/memory.h"
 
 namespace Kernel {
 
+namespace {
+/// Delay before completing a request, in cycles.
+constexpr s64 REQUEST_DELAY_CYCLES = 20000;
+} // Anonymous namespace
+
 ServerSession::ServerSession(KernelCore& kernel) : SynchronizationObject{kernel} {}
 ServerSession::~ServerSession() = default;
 
@@ -136,23 +144,37 @@ ResultCode ServerSession::HandleDomainSyncRequest(Kernel::HLERequestContext& con
 
 ResultCode ServerSession::QueueSyncRequest(std::shared_ptr<Thread> thread, Memory::Memory& memory) {
     u32* cmd_buf{reinterpret_cast<u32*>(memory.GetPointer(thread->GetTLSAddress()))};
-    std::shared_ptr<Kernel::HLERequestContext> context{
-        std::make_shared<Kernel::HLERequestContext>(SharedFrom(this), std::move(thread))};
+    // The context and its containers are carved out of the session arena, which is rewound once
+    // the session is idle, so that steady-state requests do not touch the heap.
+    std::shared_ptr<Kernel::HLERequestContext> context{std::allocate_shared<HLERequestContext>(
+        Common::ArenaAllocator<HLERequestContext>{&request_arena}, SharedFrom(this),
+        std::move(thread), &request_arena)};
 
     context->PopulateFromIncomingCommandBuffer(kernel.CurrentProcess()->GetHandleTable(), cmd_buf);
-    request_queue.Push(std::move(context));
+    request_queue.push_back(std::move(context));
 
     return RESULT_SUCCESS;
 }
 
 ResultCode ServerSession::CompleteSyncRequest() {
-    ASSERT(!request_queue.Empty());
+    ASSERT(!request_queue.empty());
 
-    auto& context = *request_queue.Front();
+    auto& context = *request_queue.front();
 
     ResultCode result = RESULT_SUCCESS;
-    // If the session has been converted to a domain, handle the domain request
-    if (IsDomain() && context.HasDomainMessageHeader()) {
+    auto handler = GetRequestHandler(context);
+    if (handler != nullptr && kernel.ServiceThreadPool() != nullptr &&
+        handler->CanHandleAsync(context)) {
+        // The client thread stays parked until a service thread is done with the request
+        QueueAsyncRequest(context, std::move(handler));
+    } else if (handler != nullptr && handler->pending_async_requests != 0) {
+        // Handlers are not synchronized, and the service threads may need the HLE lock to finish
+        // their requests to this one. Try again later instead of waiting for them here.
+        Core::System::GetInstance().CoreTiming().ScheduleEvent(REQUEST_DELAY_CYCLES,
+                                                               request_event, {});
+        return RESULT_SUCCESS;
+    } else if (IsDomain() && context.HasDomainMessageHeader()) {
+        // If the session has been converted to a domain, handle the domain request
         result = HandleDomainSyncRequest(context);
         // If there is no domain header, the regular session handler is used
     } else if (hle_handler != nullptr) {
@@ -172,14 +194,79 @@ ResultCode ServerSession::CompleteSyncRequest() {
         context.GetThread().SetWaitSynchronizationResult(result);
     }
 
-    request_queue.Pop();
+    request_queue.erase(request_queue.begin());
+    if (request_queue.empty()) {
+        request_arena.Reset();
+    }
 
     return result;
 }
 
+std::shared_ptr<SessionRequestHandler> ServerSession::GetRequestHandler(
+    const Kernel::HLERequestContext& context) const {
+    if (!IsDomain() || !context.HasDomainMessageHeader()) {
+        return hle_handler;
+    }
+
+    const auto& domain_message_header = context.GetDomainMessageHeader();
+    const u32 object_id{domain_message_header.object_id};
+    if (domain_message_header.command != IPC::DomainMessageHeader::CommandType::SendMessage ||
+        object_id == 0 || object_id > domain_request_handlers.size()) {
+        return nullptr;
+    }
+    return domain_request_handlers[object_id - 1];
+}
+
+void ServerSession::QueueAsyncRequest(Kernel::HLERequestContext& context,
+                                      std::shared_ptr<SessionRequestHandler> handler) {
+    if (IsDomain()) {
+        context.SetDomainRequestHandlers(domain_request_handlers);
+    }
+    ++handler->pending_async_requests;
+
+    // The service thread works on a heap backed copy of the context, as the original lives in the
+    // session arena, which may only be touched with the HLE lock held. Guest memory is only
+    // accessed from here and from the wakeup callback, which both run on the emulated core: the
+    // service thread sees copies of the buffers, so that it never reaches into the rasterizer
+    // caches, which have to be flushed from the thread owning the GPU context.
+    auto async_context = std::make_shared<HLERequestContext>(context);
+    async_context->DetachBuffers(*context.GetThread().GetOwnerProcess());
+    auto writable_event = context.SleepClientThread(
+        "AsyncServiceRequest", 0,
+        [async_context](std::shared_ptr<Thread> thread, HLERequestContext& ctx,
+                        ThreadWakeupReason reason) mutable {
+            // Write the buffers back from the copy they were detached into, then hand the
+            // response over to the context written back to the client thread.
+            async_context->WriteBackBuffers(*thread->GetOwnerProcess());
+            ctx = *async_context;
+            async_context.reset();
+        });
+
+    kernel.ServiceThreadPool()->QueueWork(
+        [session = SharedFrom(this), handler = std::move(handler),
+         async_context = std::move(async_context),
+         writable_event = std::move(writable_event)]() mutable {
+            {
+                std::lock_guard lock{handler->async_request_mutex};
+                handler->HandleAsyncRequest(*async_context);
+            }
+
+            // Signaling wakes up the client thread, which touches kernel state.
+            std::lock_guard lock{HLE::g_hle_lock};
+            --handler->pending_async_requests;
+            writable_event->Signal();
+            // These may be the last references to kernel objects, release them under the lock.
+            session.reset();
+            handler.reset();
+            async_context.reset();
+            writable_event.reset();
+        });
+}
+
 ResultCode ServerSession::HandleSyncRequest(std::shared_ptr<Thread> thread,
                                             Memory::Memory& memory) {
-    Core::System::GetInstance().CoreTiming().ScheduleEvent(20000, request_event, {});
+    Core::System::GetInstance().CoreTiming().ScheduleEvent(REQUEST_DELAY_CYCLES, request_event,
+                                                           {});
     return QueueSyncRequest(std::move(thread), memory);
 }
 
@@ -9,7 +9,8 @@
 #include <utility>
 #include <vector>
 
-#include "common/threadsafe_queue.h"
+#include <boost/container/small_vector.hpp>
+#include "common/arena.h"
 #include "core/hle/kernel/synchronization_object.h"
 #include "core/hle/result.h"
 
@@ -135,6 +136,14 @@ private:
     /// object handle.
     ResultCode HandleDomainSyncRequest(Kernel::HLERequestContext& context);
 
+    /// Returns the handler a request is addressed to, or null if it is handled by the session.
+    std::shared_ptr<SessionRequestHandler> GetRequestHandler(
+        const Kernel::HLERequestContext& context) const;
+
+    /// Parks the client thread and hands its request over to the service threads.
+    void QueueAsyncRequest(Kernel::HLERequestContext& context,
+                           std::shared_ptr<SessionRequestHandler> handler);
+
     /// The parent session, which links to the client endpoint.
     std::shared_ptr<Session> parent;
 
@@ -163,8 +172,13 @@ private:
     /// Core timing event used to schedule the service request at some point in the future
     std::shared_ptr<Core::Timing::EventType> request_event;
 
-    /// Queue of scheduled service requests
-    Common::MPSCQueue<std::shared_ptr<Kernel::HLERequestContext>> request_queue;
+    /// Backs the contexts of in-flight requests, rewound whenever the session becomes idle.
+    /// Declared before the queue, so that it outlives the contexts left in it.
+    Common::Arena request_arena;
+
+    /// Queue of scheduled service requests, completed in order. Requests are serialized by the HLE
+    /// lock, and sessions seldom have more than one in flight.
+    boost::container::small_vector<std::shared_ptr<Kernel::HLERequestContext>, 2> request_queue;
 };
 
 } // namespace Kernel
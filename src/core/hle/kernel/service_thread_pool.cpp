@@ -0,0 +1,60 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <string>
+
+#include "common/thread.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/service_thread_pool.h"
+
+namespace Kernel {
+
+ServiceThreadPool::ServiceThreadPool(KernelCore& kernel, std::size_t num_threads) {
+    threads.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([this, &kernel, i] { ThreadLoop(kernel, i); });
+    }
+}
+
+ServiceThreadPool::~ServiceThreadPool() {
+    {
+        std::lock_guard lock{queue_mutex};
+        stop_requested = true;
+    }
+    queue_cv.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ServiceThreadPool::QueueWork(std::function<void()>&& work) {
+    {
+        std::lock_guard lock{queue_mutex};
+        queue.push(std::move(work));
+    }
+    queue_cv.notify_one();
+}
+
+void ServiceThreadPool::ThreadLoop(KernelCore& kernel, std::size_t index) {
+    const std::string name = "yuzu:HLEService_" + std::to_string(index);
+    Common::SetCurrentThreadName(name.c_str());
+    kernel.RegisterHostThread();
+
+    while (true) {
+        std::function<void()> work;
+        {
+            std::unique_lock lock{queue_mutex};
+            queue_cv.wait(lock, [this] { return stop_requested || !queue.empty(); });
+            // Pending requests hold parked guest threads, finish them before stopping.
+            if (queue.empty()) {
+                return;
+            }
+            work = std::move(queue.front());
+            queue.pop();
+        }
+        work();
+    }
+}
+
+} // namespace Kernel
@@ -0,0 +1,54 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace Kernel {
+
+class KernelCore;
+
+/**
+ * Host threads running HLE service requests off the emulated cores, so that slow requests such as
+ * file I/O do not stall guest execution. See ServerSession for how requests get here.
+ *
+ * Work is run in submission order, by whichever thread is free first. Work runs without the HLE
+ * lock held, it has to take it itself before touching kernel state. It must not access guest
+ * memory, which may be cached by the GPU and can only be flushed from the emulated cores.
+ */
+class ServiceThreadPool {
+public:
+    ServiceThreadPool(KernelCore& kernel, std::size_t num_threads);
+
+    /// Runs the queued work and joins the threads.
+    ~ServiceThreadPool();
+
+    ServiceThreadPool(const ServiceThreadPool&) = delete;
+    ServiceThreadPool& operator=(const ServiceThreadPool&) = delete;
+
+    ServiceThreadPool(ServiceThreadPool&&) = delete;
+    ServiceThreadPool& operator=(ServiceThreadPool&&) = delete;
+
+    /// Queues work to be run on one of the threads.
+    void QueueWork(std::function<void()>&& work);
+
+private:
+    void ThreadLoop(KernelCore& kernel, std::size_t index);
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    std::queue<std::function<void()>> queue;
+    bool stop_requested = false;
+
+    std::vector<std::thread> threads;
+};
+
+} // namespace Kernel
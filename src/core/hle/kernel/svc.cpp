@@ -3,8 +3,10 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <chrono>
 #include <cinttypes>
 #include <iterator>
+#include <limits>
 #include <mutex>
 #include <vector>
 
@@ -31,6 +33,7 @@
 #include "core/hle/kernel/scheduler.h"
 #include "core/hle/kernel/shared_memory.h"
 #include "core/hle/kernel/svc.h"
+#include "core/hle/kernel/svc_stats.h"
 #include "core/hle/kernel/svc_wrap.h"
 #include "core/hle/kernel/synchronization.h"
 #include "core/hle/kernel/thread.h"
@@ -412,7 +415,7 @@ static ResultCode GetThreadId(Core::System& system, u64* thread_id, Handle threa
     LOG_TRACE(Kernel_SVC, "called thread=0x{:08X}", thread_handle);
 
     const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
-    const std::shared_ptr<Thread> thread = handle_table.Get<Thread>(thread_handle);
+    const Thread* const thread = handle_table.Borrow<Thread>(thread_handle);
     if (!thread) {
         LOG_ERROR(Kernel_SVC, "Thread handle does not exist, handle=0x{:08X}", thread_handle);
         return ERR_INVALID_HANDLE;
@@ -438,13 +441,13 @@ static ResultCode GetProcessId(Core::System& system, u64* process_id, Handle han
     LOG_DEBUG(Kernel_SVC, "called handle=0x{:08X}", handle);
 
     const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
-    const std::shared_ptr<Process> process = handle_table.Get<Process>(handle);
+    const Process* const process = handle_table.Borrow<Process>(handle);
     if (process) {
         *process_id = process->GetProcessID();
         return RESULT_SUCCESS;
     }
 
-    const std::shared_ptr<Thread> thread = handle_table.Get<Thread>(handle);
+    const Thread* const thread = handle_table.Borrow<Thread>(handle);
     if (thread) {
         const Process* const owner_process = thread->GetOwnerProcess();
         if (!owner_process) {
@@ -518,7 +521,7 @@ static ResultCode CancelSynchronization(Core::System& system, Handle thread_hand
     LOG_TRACE(Kernel_SVC, "called thread=0x{:X}", thread_handle);
 
     const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
-    std::shared_ptr<Thread> thread = handle_table.Get<Thread>(thread_handle);
+    Thread* const thread = handle_table.Borrow<Thread>(thread_handle);
     if (!thread) {
         LOG_ERROR(Kernel_SVC, "Thread handle does not exist, thread_handle=0x{:08X}",
                   thread_handle);
@@ -1124,7 +1127,7 @@ static ResultCode GetThreadPriority(Core::System& system, u32* priority, Handle
     LOG_TRACE(Kernel_SVC, "called");
 
     const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
-    const std::shared_ptr<Thread> thread = handle_table.Get<Thread>(handle);
+    const Thread* const thread = handle_table.Borrow<Thread>(handle);
     if (!thread) {
         LOG_ERROR(Kernel_SVC, "Thread handle does not exist, handle=0x{:08X}", handle);
         return ERR_INVALID_HANDLE;
@@ -1152,7 +1155,7 @@ static ResultCode SetThreadPriority(Core::System& system, Handle handle, u32 pri
 
     const auto* const current_process = system.Kernel().CurrentProcess();
 
-    std::shared_ptr<Thread> thread = current_process->GetHandleTable().Get<Thread>(handle);
+    Thread* const thread = current_process->GetHandleTable().Borrow<Thread>(handle);
     if (!thread) {
         LOG_ERROR(Kernel_SVC, "Thread handle does not exist, handle=0x{:08X}", handle);
         return ERR_INVALID_HANDLE;
@@ -1642,7 +1645,7 @@ static ResultCode WaitProcessWideKeyAtomic(Core::System& system, VAddr mutex_add
     current_thread->SetWaitHandle(thread_handle);
     current_thread->SetStatus(ThreadStatus::WaitCondVar);
     current_thread->InvalidateWakeupCallback();
-    current_process->InsertConditionVariableThread(SharedFrom(current_thread));
+    current_process->InsertConditionVariableThread(current_thread);
 
     current_thread->WakeAfterDelay(nano_seconds);
 
@@ -1659,75 +1662,67 @@ static void SignalProcessWideKey(Core::System& system, VAddr condition_variable_
 
     ASSERT(condition_variable_addr == Common::AlignDown(condition_variable_addr, 4));
 
-    // Retrieve a list of all threads that are waiting for this condition variable.
-    auto* const current_process = system.Kernel().CurrentProcess();
-    std::vector<std::shared_ptr<Thread>> waiting_threads =
-        current_process->GetConditionVariableThreads(condition_variable_addr);
-
     // Only process up to 'target' threads, unless 'target' is less equal 0, in which case process
     // them all.
-    std::size_t last = waiting_threads.size();
-    if (target > 0)
-        last = std::min(waiting_threads.size(), static_cast<std::size_t>(target));
-
-    for (std::size_t index = 0; index < last; ++index) {
-        auto& thread = waiting_threads[index];
-
-        ASSERT(thread->GetCondVarWaitAddress() == condition_variable_addr);
+    const std::size_t max_count = target > 0 ? static_cast<std::size_t>(target)
+                                             : std::numeric_limits<std::size_t>::max();
 
-        // liberate Cond Var Thread.
-        current_process->RemoveConditionVariableThread(thread);
-        thread->SetCondVarWaitAddress(0);
-
-        const std::size_t current_core = system.CurrentCoreIndex();
-        auto& monitor = system.Monitor();
-        auto& memory = system.Memory();
-
-        // Atomically read the value of the mutex.
-        u32 mutex_val = 0;
-        u32 update_val = 0;
-        const VAddr mutex_address = thread->GetMutexWaitAddress();
-        do {
-            monitor.SetExclusive(current_core, mutex_address);
-
-            // If the mutex is not yet acquired, acquire it.
-            mutex_val = memory.Read32(mutex_address);
+    // Liberate the threads waiting for this condition variable, in priority order.
+    auto* const current_process = system.Kernel().CurrentProcess();
+    current_process->WakeConditionVariableThreads(
+        condition_variable_addr, max_count, [&system, condition_variable_addr](Thread* thread) {
+            ASSERT(thread->GetCondVarWaitAddress() == condition_variable_addr);
+            thread->SetCondVarWaitAddress(0);
+
+            const std::size_t current_core = system.CurrentCoreIndex();
+            auto& monitor = system.Monitor();
+            auto& memory = system.Memory();
+
+            // Atomically read the value of the mutex.
+            u32 mutex_val = 0;
+            u32 update_val = 0;
+            const VAddr mutex_address = thread->GetMutexWaitAddress();
+            do {
+                monitor.SetExclusive(current_core, mutex_address);
+
+                // If the mutex is not yet acquired, acquire it.
+                mutex_val = memory.Read32(mutex_address);
+
+                if (mutex_val != 0) {
+                    update_val = mutex_val | Mutex::MutexHasWaitersFlag;
+                } else {
+                    update_val = thread->GetWaitHandle();
+                }
+            } while (!monitor.ExclusiveWrite32(current_core, mutex_address, update_val));
+            if (mutex_val == 0) {
+                // We were able to acquire the mutex, resume this thread.
+                ASSERT(thread->GetStatus() == ThreadStatus::WaitCondVar);
+                thread->ResumeFromWait();
+
+                auto* const lock_owner = thread->GetLockOwner();
+                if (lock_owner != nullptr) {
+                    lock_owner->RemoveMutexWaiter(SharedFrom(thread));
+                }
 
-            if (mutex_val != 0) {
-                update_val = mutex_val | Mutex::MutexHasWaitersFlag;
+                thread->SetLockOwner(nullptr);
+                thread->SetMutexWaitAddress(0);
+                thread->SetWaitHandle(0);
+                thread->SetWaitSynchronizationResult(RESULT_SUCCESS);
+                system.PrepareReschedule(thread->GetProcessorID());
             } else {
-                update_val = thread->GetWaitHandle();
-            }
-        } while (!monitor.ExclusiveWrite32(current_core, mutex_address, update_val));
-        if (mutex_val == 0) {
-            // We were able to acquire the mutex, resume this thread.
-            ASSERT(thread->GetStatus() == ThreadStatus::WaitCondVar);
-            thread->ResumeFromWait();
-
-            auto* const lock_owner = thread->GetLockOwner();
-            if (lock_owner != nullptr) {
-                lock_owner->RemoveMutexWaiter(thread);
+                // The mutex is already owned by some other thread, make this thread wait on it.
+                const Handle owner_handle = static_cast<Handle>(mutex_val & Mutex::MutexOwnerMask);
+                const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
+                auto owner = handle_table.Get<Thread>(owner_handle);
+                ASSERT(owner);
+                ASSERT(thread->GetStatus() == ThreadStatus::WaitCondVar);
+                thread->InvalidateWakeupCallback();
+                thread->SetStatus(ThreadStatus::WaitMutex);
+
+                owner->AddMutexWaiter(SharedFrom(thread));
+                system.PrepareReschedule(thread->GetProcessorID());
             }
-
-            thread->SetLockOwner(nullptr);
-            thread->SetMutexWaitAddress(0);
-            thread->SetWaitHandle(0);
-            thread->SetWaitSynchronizationResult(RESULT_SUCCESS);
-            system.PrepareReschedule(thread->GetProcessorID());
-        } else {
-            // The mutex is already owned by some other thread, make this thread wait on it.
-            const Handle owner_handle = static_cast<Handle>(mutex_val & Mutex::MutexOwnerMask);
-            const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
-            auto owner = handle_table.Get<Thread>(owner_handle);
-            ASSERT(owner);
-            ASSERT(thread->GetStatus() == ThreadStatus::WaitCondVar);
-            thread->InvalidateWakeupCallback();
-            thread->SetStatus(ThreadStatus::WaitMutex);
-
-            owner->AddMutexWaiter(thread);
-            system.PrepareReschedule(thread->GetProcessorID());
-        }
-    }
+        });
 }
 
 static void SignalProcessWideKey32(Core::System& system, u32 condition_variable_addr, s32 target) {
@@ -1829,12 +1824,12 @@ static ResultCode ResetSignal(Core::System& system, Handle handle) {
 
     const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
 
-    auto event = handle_table.Get<ReadableEvent>(handle);
+    auto* const event = handle_table.Borrow<ReadableEvent>(handle);
     if (event) {
         return event->Reset();
     }
 
-    auto process = handle_table.Get<Process>(handle);
+    auto* const process = handle_table.Borrow<Process>(handle);
     if (process) {
         return process->ClearSignalState();
     }
@@ -2152,13 +2147,13 @@ static ResultCode ClearEvent(Core::System& system, Handle handle) {
 
     const auto& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
 
-    auto writable_event = handle_table.Get<WritableEvent>(handle);
+    auto* const writable_event = handle_table.Borrow<WritableEvent>(handle);
     if (writable_event) {
         writable_event->Clear();
         return RESULT_SUCCESS;
     }
 
-    auto readable_event = handle_table.Get<ReadableEvent>(handle);
+    auto* const readable_event = handle_table.Borrow<ReadableEvent>(handle);
     if (readable_event) {
         readable_event->Clear();
         return RESULT_SUCCESS;
@@ -2172,7 +2167,7 @@ static ResultCode SignalEvent(Core::System& system, Handle handle) {
     LOG_DEBUG(Kernel_SVC, "called. Handle=0x{:08X}", handle);
 
     HandleTable& handle_table = system.Kernel().CurrentProcess()->GetHandleTable();
-    auto writable_event = handle_table.Get<WritableEvent>(handle);
+    auto* const writable_event = handle_table.Borrow<WritableEvent>(handle);
 
     if (!writable_event) {
         LOG_ERROR(Kernel_SVC, "Non-existent writable event handle used (0x{:08X})", handle);
@@ -2638,6 +2633,9 @@ static const FunctionDef SVC_Table_64[] = {
     {0x7F, nullptr, "CallSecureMonitor"},
 };
 
+static_assert(std::size(SVC_Table_32) <= NUM_SVC_IDS && std::size(SVC_Table_64) <= NUM_SVC_IDS,
+              "SVC statistics do not cover every SVC id");
+
 static const FunctionDef* GetSVCInfo32(u32 func_num) {
     if (func_num >= std::size(SVC_Table_32)) {
         LOG_ERROR(Kernel_SVC, "Unknown svc=0x{:02X}", func_num);
@@ -2662,11 +2660,19 @@ void CallSVC(Core::System& system, u32 immediate) {
     // Lock the global kernel mutex when we enter the kernel HLE.
     std::lock_guard lock{HLE::g_hle_lock};
 
-    const FunctionDef* info = system.CurrentProcess()->Is64BitProcess() ? GetSVCInfo64(immediate)
-                                                                        : GetSVCInfo32(immediate);
+    const bool is_64_bit = system.CurrentProcess()->Is64BitProcess();
+    const FunctionDef* info = is_64_bit ? GetSVCInfo64(immediate) : GetSVCInfo32(immediate);
     if (info) {
         if (info->func) {
+            auto& svc_stats = system.Kernel().SVCStats();
+            if (!svc_stats.IsEnabled()) {
+                info->func(system);
+                return;
+            }
+            const auto start = std::chrono::steady_clock::now();
             info->func(system);
+            svc_stats.Get(immediate, is_64_bit)
+                .latency.Record(std::chrono::steady_clock::now() - start);
         } else {
             LOG_CRITICAL(Kernel_SVC, "Unimplemented SVC function {}(..)", info->name);
         }
@@ -2675,4 +2681,11 @@ void CallSVC(Core::System& system, u32 immediate) {
     }
 }
 
+const char* GetSVCName(u32 immediate, bool is_64_bit) {
+    if (is_64_bit) {
+        return immediate < std::size(SVC_Table_64) ? SVC_Table_64[immediate].name : nullptr;
+    }
+    return immediate < std::size(SVC_Table_32) ? SVC_Table_32[immediate].name : nullptr;
+}
+
 } // namespace Kernel
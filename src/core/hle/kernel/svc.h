@@ -14,4 +14,7 @@ namespace Kernel {
 
 void CallSVC(Core::System& system, u32 immediate);
 
+/// Returns the name of an SVC, or nullptr if there is no SVC with the given id.
+const char* GetSVCName(u32 immediate, bool is_64_bit);
+
 } // namespace Kernel
@@ -0,0 +1,85 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <json.hpp>
+
+#include "common/logging/log.h"
+#include "core/hle/kernel/svc.h"
+#include "core/hle/kernel/svc_stats.h"
+
+namespace Kernel {
+
+SVCStatsRegistry::SVCStatsRegistry() {
+    for (u32 id = 0; id < NUM_SVC_IDS; ++id) {
+        stats_32[id].name = GetSVCName(id, false);
+        stats_64[id].name = GetSVCName(id, true);
+    }
+}
+
+SVCStatsRegistry::~SVCStatsRegistry() = default;
+
+std::vector<SVCStatsSnapshot> SVCStatsRegistry::Snapshot() const {
+    std::vector<SVCStatsSnapshot> snapshots;
+    const auto add_snapshots = [&snapshots](const auto& table, bool is_64_bit) {
+        for (u32 id = 0; id < NUM_SVC_IDS; ++id) {
+            const SVCStats& stats = table[id];
+            auto& snapshot = snapshots.emplace_back();
+            snapshot.id = id;
+            snapshot.is_64_bit = is_64_bit;
+            snapshot.name = stats.name != nullptr ? stats.name : "Unknown";
+            snapshot.latency = stats.latency.GetSnapshot();
+        }
+    };
+    add_snapshots(stats_32, false);
+    add_snapshots(stats_64, true);
+
+    Common::SortLatencySnapshots(snapshots);
+    return snapshots;
+}
+
+std::string SVCStatsRegistry::ToJson() const {
+    auto svcs = nlohmann::json::array();
+    for (const auto& snapshot : Snapshot()) {
+        svcs.push_back({
+            {"id", snapshot.id},
+            {"is_64_bit", snapshot.is_64_bit},
+            {"name", snapshot.name},
+            {"calls", snapshot.latency.calls},
+            {"total_ns", snapshot.latency.total_time.count()},
+            {"latency_histogram", snapshot.latency.buckets},
+        });
+    }
+
+    // Upper bounds of the histogram buckets, the last bucket also counts every slower call.
+    auto bucket_bounds = nlohmann::json::array();
+    for (std::size_t i = 0; i < NUM_SVC_LATENCY_BUCKETS; ++i) {
+        bucket_bounds.push_back(SVCLatencyHistogram::BucketBound(i).count());
+    }
+
+    const nlohmann::json out{
+        {"latency_bucket_bounds_ns", std::move(bucket_bounds)},
+        {"svcs", std::move(svcs)},
+    };
+    return out.dump(4);
+}
+
+void SVCStatsRegistry::LogSummary(std::size_t max_entries) const {
+    const auto lines = Common::SummarizeLatencySnapshots(
+        Snapshot(), max_entries, "called SVCs", [](const SVCStatsSnapshot& snapshot) {
+            return fmt::format("{} (0x{:02X})", snapshot.name, snapshot.id);
+        });
+    for (const auto& line : lines) {
+        LOG_INFO(Kernel_SVC, "{}", line);
+    }
+}
+
+void SVCStatsRegistry::Reset() {
+    for (auto* table : {&stats_32, &stats_64}) {
+        for (SVCStats& stats : *table) {
+            stats.latency.Reset();
+        }
+    }
+}
+
+} // namespace Kernel
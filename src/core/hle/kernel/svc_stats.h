@@ -0,0 +1,84 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+#include "common/latency_histogram.h"
+
+namespace Kernel {
+
+/// Number of SVC ids, for both the 32-bit and the 64-bit SVC tables.
+constexpr std::size_t NUM_SVC_IDS = 0x80;
+
+/// Number of buckets of the SVC latency histograms. Bucket i counts the calls that took less than
+/// 2^(i + 1) nanoseconds, the last bucket counts every call that took longer.
+constexpr std::size_t NUM_SVC_LATENCY_BUCKETS = 32;
+
+using SVCLatencyHistogram =
+    Common::LatencyHistogram<std::chrono::nanoseconds, NUM_SVC_LATENCY_BUCKETS>;
+
+/// Statistics of an SVC, updated by CallSVC on every call while recording is enabled.
+struct SVCStats {
+    /// Name of the SVC, set once when the registry is created.
+    const char* name = nullptr;
+    SVCLatencyHistogram latency;
+};
+
+/// Copy of the statistics of an SVC.
+struct SVCStatsSnapshot {
+    u32 id;
+    bool is_64_bit;
+    std::string name;
+    SVCLatencyHistogram::Snapshot latency;
+};
+
+/**
+ * Collects the call counts and host latencies of SVCs, to find out which ones a title spends its
+ * time in. Recording is always compiled in and can be toggled at runtime, it starts out as
+ * Settings::values.record_svc_stats.
+ */
+class SVCStatsRegistry {
+public:
+    SVCStatsRegistry();
+    ~SVCStatsRegistry();
+
+    void SetEnabled(bool enabled) {
+        is_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool IsEnabled() const {
+        return is_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the statistics of an SVC. The id must be below NUM_SVC_IDS.
+    SVCStats& Get(u32 id, bool is_64_bit) {
+        return (is_64_bit ? stats_64 : stats_32)[id];
+    }
+
+    /// Returns the statistics of every SVC that was called, most expensive first.
+    std::vector<SVCStatsSnapshot> Snapshot() const;
+
+    /// Serializes the statistics of every SVC that was called to JSON.
+    std::string ToJson() const;
+
+    /// Logs the SVCs that took the most time, up to max_entries of them.
+    void LogSummary(std::size_t max_entries) const;
+
+    /// Zeroes every statistic.
+    void Reset();
+
+private:
+    std::atomic<bool> is_enabled{false};
+    std::array<SVCStats, NUM_SVC_IDS> stats_32;
+    std::array<SVCStats, NUM_SVC_IDS> stats_64;
+};
+
+} // namespace Kernel
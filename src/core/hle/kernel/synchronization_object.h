@@ -75,14 +75,10 @@ private:
     std::vector<std::shared_ptr<Thread>> waiting_threads;
 };
 
-// Specialization of DynamicObjectCast for SynchronizationObjects
+// Any waitable object is a SynchronizationObject
 template <>
-inline std::shared_ptr<SynchronizationObject> DynamicObjectCast<SynchronizationObject>(
-    std::shared_ptr<Object> object) {
-    if (object != nullptr && object->IsWaitable()) {
-        return std::static_pointer_cast<SynchronizationObject>(object);
-    }
-    return nullptr;
+inline bool IsHandleTypeOf<SynchronizationObject>(HandleType type) {
+    return IsWaitableHandleType(type);
 }
 
 } // namespace Kernel
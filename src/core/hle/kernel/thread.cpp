@@ -49,6 +49,15 @@ void Thread::Stop() {
                                                              global_handle);
     kernel.GlobalHandleTable().Close(global_handle);
     global_handle = 0;
+
+    // The address arbiter and the condition variables do not hold references to the threads
+    // waiting on them
+    if (status == ThreadStatus::WaitArb) {
+        owner_process->GetAddressArbiter().HandleWakeupThread(this);
+    } else if (status == ThreadStatus::WaitCondVar) {
+        owner_process->RemoveConditionVariableThread(this);
+        condvar_wait_address = 0;
+    }
     SetStatus(ThreadStatus::Dead);
     Signal();
 
@@ -318,13 +327,13 @@ void Thread::UpdatePriority() {
     }
 
     if (GetStatus() == ThreadStatus::WaitCondVar) {
-        owner_process->RemoveConditionVariableThread(SharedFrom(this));
+        owner_process->RemoveConditionVariableThread(this);
     }
 
     SetCurrentPriority(new_priority);
 
     if (GetStatus() == ThreadStatus::WaitCondVar) {
-        owner_process->InsertConditionVariableThread(SharedFrom(this));
+        owner_process->InsertConditionVariableThread(this);
     }
 
     if (!lock_owner) {
@@ -4,12 +4,16 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <string>
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/intrusive_multi_level_queue.h"
+#include "common/intrusive_wait_table.h"
 #include "core/arm/arm_interface.h"
+#include "core/hardware_properties.h"
 #include "core/hle/kernel/object.h"
 #include "core/hle/kernel/synchronization_object.h"
 #include "core/hle/result.h"
@@ -466,6 +470,32 @@ public:
         return global_handle;
     }
 
+    using SchedulerQueueLink = Common::MultiLevelQueueLink<Thread>;
+
+    /// Links of this thread in the scheduled queue of the given core.
+    SchedulerQueueLink& GetScheduledQueueLink(std::size_t core) {
+        return scheduled_queue_links[core];
+    }
+
+    /// Links of this thread in the suggested queue of the given core.
+    SchedulerQueueLink& GetSuggestedQueueLink(std::size_t core) {
+        return suggested_queue_links[core];
+    }
+
+    using ArbiterQueueLink = Common::WaitTableLink<Thread>;
+
+    /// Links of this thread in the wait queue of its process' AddressArbiter.
+    ArbiterQueueLink& GetArbiterQueueLink() {
+        return arbiter_queue_link;
+    }
+
+    using CondVarQueueLink = Common::WaitTableLink<Thread>;
+
+    /// Links of this thread in the condition variable wait queue of its process.
+    CondVarQueueLink& GetCondVarQueueLink() {
+        return condvar_queue_link;
+    }
+
 private:
     void SetSchedulingStatus(ThreadSchedStatus new_status);
     void SetCurrentPriority(u32 new_priority);
@@ -499,6 +529,10 @@ private:
     u64 yield_count = 0;          ///< Number of redundant yields carried by this thread.
                                   ///< a redundant yield is one where no scheduling is changed
 
+    /// Links used by the global scheduler's queues, one per core.
+    std::array<SchedulerQueueLink, Core::Hardware::NUM_CPU_CORES> scheduled_queue_links{};
+    std::array<SchedulerQueueLink, Core::Hardware::NUM_CPU_CORES> suggested_queue_links{};
+
     s32 processor_id = 0;
 
     VAddr tls_address = 0; ///< Virtual address of the Thread Local Storage of the thread
@@ -527,6 +561,12 @@ private:
     /// If waiting for an AddressArbiter, this is the address being waited on.
     VAddr arb_wait_address{0};
 
+    /// Position of the thread in the wait queue of its process' AddressArbiter.
+    ArbiterQueueLink arbiter_queue_link{};
+
+    /// Position of the thread in the condition variable wait queue of its process.
+    CondVarQueueLink condvar_queue_link{};
+
     /// Handle used as userdata to reference this object when inserting into the CoreTiming queue.
     Handle global_handle = 0;
 
@@ -69,6 +69,8 @@ bool VirtualMemoryArea::CanBeMergedWith(const VirtualMemoryArea& next) const {
 }
 
 VMManager::VMManager(Core::System& system) : system{system} {
+    free_vma_nodes.reserve(MAX_FREE_VMA_NODES);
+
     // Default to assuming a 39-bit address space. This way we have a sane
     // starting point with executables that don't provide metadata.
     Reset(FileSys::ProgramAddressSpaceType::Is39Bit);
@@ -192,8 +194,7 @@ ResultVal<VMManager::VMAHandle> VMManager::MapMMIO(VAddr target, PAddr paddr, u6
     return MakeResult<VMAHandle>(MergeAdjacent(vma_handle));
 }
 
-VMManager::VMAIter VMManager::Unmap(VMAIter vma_handle) {
-    VirtualMemoryArea& vma = vma_handle->second;
+void VMManager::ResetToFree(VirtualMemoryArea& vma) {
     vma.type = VMAType::Free;
     vma.permissions = VMAPermission::None;
     vma.state = MemoryState::Unmapped;
@@ -203,7 +204,12 @@ VMManager::VMAIter VMManager::Unmap(VMAIter vma_handle) {
     vma.offset = 0;
     vma.backing_memory = nullptr;
     vma.paddr = 0;
+    vma.mmio_handler = nullptr;
+}
 
+VMManager::VMAIter VMManager::Unmap(VMAIter vma_handle) {
+    VirtualMemoryArea& vma = vma_handle->second;
+    ResetToFree(vma);
     UpdatePageTableForVMA(vma);
 
     return MergeAdjacent(vma_handle);
@@ -217,9 +223,13 @@ ResultCode VMManager::UnmapRange(VAddr target, u64 size) {
     // The comparison against the end of the range must be done using addresses since VMAs can be
     // merged during this process, causing invalidation of the iterators.
     while (vma != end && vma->second.base < target_end) {
-        vma = std::next(Unmap(vma));
+        ResetToFree(vma->second);
+        vma = std::next(MergeAdjacent(vma));
     }
 
+    // Free VMAs are only merged by size, so the page table can be updated once for the range.
+    system.Memory().UnmapRegion(page_table, target, size);
+
     ASSERT(FindVMA(target)->second.size >= size);
 
     return RESULT_SUCCESS;
@@ -228,9 +238,9 @@ ResultCode VMManager::UnmapRange(VAddr target, u64 size) {
 VMManager::VMAHandle VMManager::Reprotect(VMAHandle vma_handle, VMAPermission new_perms) {
     VMAIter iter = StripIterConstness(vma_handle);
 
-    VirtualMemoryArea& vma = iter->second;
-    vma.permissions = new_perms;
-    UpdatePageTableForVMA(vma);
+    // Permissions are not part of the page table, it only needs an update if merging changes the
+    // backing memory, which MergeAdjacentVMA takes care of.
+    iter->second.permissions = new_perms;
 
     return MergeAdjacent(iter);
 }
@@ -270,6 +280,7 @@ ResultVal<VAddr> VMManager::SetHeapSize(u64 size) {
     // If necessary, expand backing vector to cover new heap extents in
     // the case of allocating. Otherwise, shrink the backing memory,
     // if a smaller heap has been requested.
+    FlushMemoryBlockMappings(heap_memory.get());
     heap_memory->resize(size);
     heap_memory->shrink_to_fit();
     RefreshMemoryBlockMappings(heap_memory.get());
@@ -606,6 +617,16 @@ void VMManager::RefreshMemoryBlockMappings(const PhysicalMemory* block) {
     }
 }
 
+void VMManager::FlushMemoryBlockMappings(const PhysicalMemory* block) {
+    auto& memory = system.Memory();
+    for (const auto& p : vma_map) {
+        const VirtualMemoryArea& vma = p.second;
+        if (block == vma.backing_block.get()) {
+            memory.FlushRegionBeforeRemap(page_table, vma.base, vma.size);
+        }
+    }
+}
+
 void VMManager::LogLayout() const {
     for (const auto& p : vma_map) {
         const VirtualMemoryArea& vma = p.second;
@@ -717,21 +738,21 @@ VMManager::VMAIter VMManager::SplitVMA(VMAIter vma_handle, u64 offset_in_vma) {
 
     ASSERT(old_vma.CanBeMergedWith(new_vma));
 
-    return vma_map.emplace_hint(std::next(vma_handle), new_vma.base, new_vma);
+    return InsertVMA(vma_handle, std::move(new_vma));
 }
 
 VMManager::VMAIter VMManager::MergeAdjacent(VMAIter iter) {
     const VMAIter next_vma = std::next(iter);
     if (next_vma != vma_map.end() && iter->second.CanBeMergedWith(next_vma->second)) {
         MergeAdjacentVMA(iter->second, next_vma->second);
-        vma_map.erase(next_vma);
+        EraseVMA(next_vma);
     }
 
     if (iter != vma_map.begin()) {
         VMAIter prev_vma = std::prev(iter);
         if (prev_vma->second.CanBeMergedWith(iter->second)) {
             MergeAdjacentVMA(prev_vma->second, iter->second);
-            vma_map.erase(iter);
+            EraseVMA(iter);
             iter = prev_vma;
         }
     }
@@ -739,6 +760,30 @@ VMManager::VMAIter VMManager::MergeAdjacent(VMAIter iter) {
     return iter;
 }
 
+VMManager::VMAIter VMManager::InsertVMA(VMAIter hint, VirtualMemoryArea vma) {
+    if (free_vma_nodes.empty()) {
+        return vma_map.emplace_hint(std::next(hint), vma.base, std::move(vma));
+    }
+
+    VMAMap::node_type node = std::move(free_vma_nodes.back());
+    free_vma_nodes.pop_back();
+    node.key() = vma.base;
+    node.mapped() = std::move(vma);
+    return vma_map.insert(std::next(hint), std::move(node));
+}
+
+void VMManager::EraseVMA(VMAIter vma) {
+    if (free_vma_nodes.size() >= MAX_FREE_VMA_NODES) {
+        vma_map.erase(vma);
+        return;
+    }
+
+    VMAMap::node_type node = vma_map.extract(vma);
+    // Drop the references to backing memory right away.
+    node.mapped() = {};
+    free_vma_nodes.push_back(std::move(node));
+}
+
 void VMManager::MergeAdjacentVMA(VirtualMemoryArea& left, const VirtualMemoryArea& right) {
     ASSERT(left.CanBeMergedWith(right));
 
@@ -746,6 +791,10 @@ void VMManager::MergeAdjacentVMA(VirtualMemoryArea& left, const VirtualMemoryAre
     if (left.type == VMAType::AllocatedMemoryBlock &&
         (left.backing_block != right.backing_block || left.offset + left.size != right.offset)) {
 
+        // The backing memory of left is about to be reallocated or dropped, flush it while the
+        // page table still refers to it.
+        system.Memory().FlushRegionBeforeRemap(page_table, left.base, left.size);
+
         // Check if we can save work.
         if (left.offset == 0 && left.size == left.backing_block->size()) {
             // Fast case: left is an entire backing block.
@@ -882,10 +931,8 @@ void VMManager::ClearVMAMap() {
 }
 
 void VMManager::ClearPageTable() {
-    std::fill(page_table.pointers.begin(), page_table.pointers.end(), nullptr);
+    page_table.ClearPages(0, page_table.pointers.size());
     page_table.special_regions.clear();
-    std::fill(page_table.attributes.begin(), page_table.attributes.end(),
-              Common::PageType::Unmapped);
 }
 
 VMManager::CheckResults VMManager::CheckRangeState(VAddr address, u64 size, MemoryState state_mask,
@@ -552,6 +552,12 @@ public:
      */
     void RefreshMemoryBlockMappings(const PhysicalMemory* block);
 
+    /**
+     * Flushes the page table range of any VMA that uses the given vector as backing memory. This
+     * should be called before any operation that causes reallocation of the vector.
+     */
+    void FlushMemoryBlockMappings(const PhysicalMemory* block);
+
     /// Dumps the address space layout to the log, for debugging
     void LogLayout() const;
 
@@ -694,6 +700,9 @@ private:
     /// Unmaps the given VMA.
     VMAIter Unmap(VMAIter vma);
 
+    /// Turns the given VMA into a Free one, without updating the page table nor merging it.
+    static void ResetToFree(VirtualMemoryArea& vma);
+
     /**
      * Carves a VMA of a specific size at the specified address by splitting Free VMAs while doing
      * the appropriate error checking.
@@ -723,6 +732,12 @@ private:
      */
     void MergeAdjacentVMA(VirtualMemoryArea& left, const VirtualMemoryArea& right);
 
+    /// Inserts a VMA after the given hint, reusing a previously erased map node if possible.
+    VMAIter InsertVMA(VMAIter hint, VirtualMemoryArea vma);
+
+    /// Erases a VMA, keeping its map node around for InsertVMA.
+    void EraseVMA(VMAIter vma);
+
     /// Updates the pages corresponding to this VMA so they match the VMA's attributes.
     void UpdatePageTableForVMA(const VirtualMemoryArea& vma);
 
@@ -754,6 +769,13 @@ private:
      */
     VMAMap vma_map;
 
+    /// Maximum number of erased map nodes kept for reuse.
+    static constexpr std::size_t MAX_FREE_VMA_NODES = 64;
+
+    /// Map nodes erased by merges, reused by splits, so that remapping or reprotecting the same
+    /// ranges over and over does not go through the allocator.
+    std::vector<VMAMap::node_type> free_vma_nodes;
+
     u32 address_space_width = 0;
     VAddr address_space_base = 0;
     VAddr address_space_end = 0;
@@ -0,0 +1,59 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/logging/log.h"
+#include "core/hle/service/command_stats.h"
+
+namespace Service {
+
+CommandStatsRegistry::CommandStatsRegistry() = default;
+CommandStatsRegistry::~CommandStatsRegistry() = default;
+
+CommandStats& CommandStatsRegistry::Get(const std::string& service_name, u32 command_id,
+                                        const char* command_name) {
+    std::lock_guard lock{mutex};
+    auto& entry = entries[{service_name, command_id}];
+    if (!entry) {
+        entry = std::make_unique<Entry>();
+        entry->command_name = command_name;
+    }
+    return entry->stats;
+}
+
+std::vector<CommandStatsSnapshot> CommandStatsRegistry::Snapshot() const {
+    std::vector<CommandStatsSnapshot> snapshots;
+    {
+        std::lock_guard lock{mutex};
+        for (const auto& [key, entry] : entries) {
+            auto& snapshot = snapshots.emplace_back();
+            snapshot.service_name = key.first;
+            snapshot.command_name = entry->command_name;
+            snapshot.command_id = key.second;
+            snapshot.latency = entry->stats.latency.GetSnapshot();
+        }
+    }
+    Common::SortLatencySnapshots(snapshots);
+    return snapshots;
+}
+
+void CommandStatsRegistry::LogSummary(std::size_t max_entries) const {
+    const auto lines = Common::SummarizeLatencySnapshots(
+        Snapshot(), max_entries, "called service commands",
+        [](const CommandStatsSnapshot& snapshot) {
+            return fmt::format("{}::{} ({})", snapshot.service_name, snapshot.command_name,
+                               snapshot.command_id);
+        });
+    for (const auto& line : lines) {
+        LOG_INFO(Service, "{}", line);
+    }
+}
+
+void CommandStatsRegistry::Reset() {
+    std::lock_guard lock{mutex};
+    for (auto& [key, entry] : entries) {
+        entry->stats.latency.Reset();
+    }
+}
+
+} // namespace Service
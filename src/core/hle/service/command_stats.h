@@ -0,0 +1,72 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_types.h"
+#include "common/latency_histogram.h"
+
+namespace Service {
+
+/// Number of buckets of the latency histograms. Bucket i counts the calls that took less than
+/// 2^(i + 1) microseconds, the last bucket counts every call that took longer.
+constexpr std::size_t NUM_LATENCY_BUCKETS = 24;
+
+using CommandLatencyHistogram =
+    Common::LatencyHistogram<std::chrono::microseconds, NUM_LATENCY_BUCKETS>;
+
+/// Statistics of a service command, updated by the dispatcher on every call.
+struct CommandStats {
+    CommandLatencyHistogram latency;
+};
+
+/// Copy of the statistics of a service command.
+struct CommandStatsSnapshot {
+    std::string service_name;
+    std::string command_name;
+    u32 command_id;
+    CommandLatencyHistogram::Snapshot latency;
+};
+
+/**
+ * Collects the statistics of service commands, keyed by service and command id, so that every
+ * instance of an interface shares the same statistics. This is a debugging aid, it is only fed
+ * when Settings::values.record_service_stats is enabled.
+ */
+class CommandStatsRegistry {
+public:
+    CommandStatsRegistry();
+    ~CommandStatsRegistry();
+
+    /// Returns the statistics of a command, which stay valid for the lifetime of the registry.
+    CommandStats& Get(const std::string& service_name, u32 command_id, const char* command_name);
+
+    /// Returns the statistics of every command that was called, most expensive first.
+    std::vector<CommandStatsSnapshot> Snapshot() const;
+
+    /// Logs the commands that took the most time, up to max_entries of them.
+    void LogSummary(std::size_t max_entries) const;
+
+    /// Zeroes every statistic.
+    void Reset();
+
+private:
+    struct Entry {
+        std::string command_name;
+        CommandStats stats;
+    };
+
+    mutable std::mutex mutex;
+    std::map<std::pair<std::string, u32>, std::unique_ptr<Entry>> entries;
+};
+
+} // namespace Service
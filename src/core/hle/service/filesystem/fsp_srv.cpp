@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstring>
 #include <iterator>
@@ -23,6 +24,7 @@
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/system_archive/system_archive.h"
 #include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_readahead.h"
 #include "core/hle/ipc_helpers.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/service/filesystem/filesystem.h"
@@ -43,6 +45,21 @@ struct SizeGetter {
     }
 };
 
+/// Wraps read-only files large enough to be streamed, so that sequential reads are prefetched.
+/// The data of the file must not change while it is open.
+FileSys::VirtualFile WithReadahead(FileSys::VirtualFile file) {
+    if (file == nullptr || file->IsWritable() ||
+        file->GetSize() <= FileSys::ReadaheadVfsFile::DEFAULT_WINDOW_SIZE) {
+        return file;
+    }
+    // Files exposing their contents, like mapped host files, are already read with a plain copy.
+    // Prefetching them would only add a copy and a thread hop.
+    if (!file->GetSpan(file->GetSize(), 0).empty()) {
+        return file;
+    }
+    return std::make_shared<FileSys::ReadaheadVfsFile>(std::move(file));
+}
+
 enum class FileSystemType : u8 {
     Invalid0 = 0,
     Invalid1 = 1,
@@ -57,7 +74,7 @@ enum class FileSystemType : u8 {
 class IStorage final : public ServiceFramework<IStorage> {
 public:
     explicit IStorage(FileSys::VirtualFile backend_)
-        : ServiceFramework("IStorage"), backend(std::move(backend_)) {
+        : ServiceFramework("IStorage"), backend(WithReadahead(std::move(backend_))) {
         static const FunctionInfo functions[] = {
             {0, &IStorage::Read, "Read"},
             {1, nullptr, "Write"},
@@ -67,6 +84,7 @@ public:
             {5, nullptr, "OperateRange"},
         };
         RegisterHandlers(functions);
+        SetAsyncCommands({0});
     }
 
 private:
@@ -93,10 +111,9 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend straight into the output buffer
+        const auto output = ctx.WriteBufferSpan();
+        backend->Read(output.data(), std::min<std::size_t>(length, output.size()), offset);
 
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(RESULT_SUCCESS);
@@ -122,6 +139,7 @@ public:
             {4, &IFile::GetSize, "GetSize"}, {5, nullptr, "OperateRange"},
         };
         RegisterHandlers(functions);
+        SetAsyncCommands({0, 1});
     }
 
 private:
@@ -150,15 +168,14 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend straight into the output buffer
+        const auto output = ctx.WriteBufferSpan();
+        const std::size_t read =
+            backend->Read(output.data(), std::min<std::size_t>(length, output.size()), offset);
 
         IPC::ResponseBuilder rb{ctx, 4};
         rb.Push(RESULT_SUCCESS);
-        rb.Push(static_cast<u64>(output.size()));
+        rb.Push(static_cast<u64>(read));
     }
 
     void Write(Kernel::HLERequestContext& ctx) {
@@ -184,7 +201,7 @@ private:
             return;
         }
 
-        const std::vector<u8> data = ctx.ReadBuffer();
+        const auto data = ctx.ReadBufferSpan();
 
         ASSERT_MSG(
             static_cast<s64>(data.size()) <= length,
@@ -234,6 +251,10 @@ private:
     }
 };
 
+std::shared_ptr<ServiceFrameworkBase> CreateFileInterface(FileSys::VirtualFile backend) {
+    return std::make_shared<IFile>(std::move(backend));
+}
+
 template <typename T>
 static void BuildEntryIndex(std::vector<FileSys::Entry>& entries, const std::vector<T>& new_data,
                             FileSys::EntryType type) {
@@ -302,8 +323,9 @@ private:
 
 class IFileSystem final : public ServiceFramework<IFileSystem> {
 public:
-    explicit IFileSystem(FileSys::VirtualDir backend, SizeGetter size)
-        : ServiceFramework("IFileSystem"), backend(std::move(backend)), size(std::move(size)) {
+    explicit IFileSystem(FileSys::VirtualDir backend_, SizeGetter size)
+        : ServiceFramework("IFileSystem"), backend(backend_), size(std::move(size)),
+          is_read_only(!backend_->IsWritable()) {
         static const FunctionInfo functions[] = {
             {0, &IFileSystem::CreateFile, "CreateFile"},
             {1, &IFileSystem::DeleteFile, "DeleteFile"},
@@ -420,11 +442,14 @@ public:
             return;
         }
 
-        auto file = std::make_shared<IFile>(result.Unwrap());
+        // Files of writable filesystems may be written through another handle, which would leave
+        // the prefetched data stale.
+        auto file = CreateFileInterface(is_read_only ? WithReadahead(result.Unwrap())
+                                                     : result.Unwrap());
 
         IPC::ResponseBuilder rb{ctx, 2, 0, 1};
         rb.Push(RESULT_SUCCESS);
-        rb.PushIpcInterface<IFile>(std::move(file));
+        rb.PushIpcInterface(std::move(file));
     }
 
     void OpenDirectory(Kernel::HLERequestContext& ctx) {
@@ -496,6 +521,7 @@ public:
 private:
     VfsDirectoryServiceWrapper backend;
     SizeGetter size;
+    bool is_read_only;
 };
 
 class ISaveDataInfoReader final : public ServiceFramework<ISaveDataInfoReader> {
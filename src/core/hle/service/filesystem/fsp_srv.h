@@ -30,6 +30,9 @@ enum class LogMode : u32 {
     LogToSdCard = Log | RedirectToSdCard,
 };
 
+/// Creates the IFile interface through which guests access an opened file.
+std::shared_ptr<ServiceFrameworkBase> CreateFileInterface(FileSys::VirtualFile backend);
+
 class FSP_SRV final : public ServiceFramework<FSP_SRV> {
 public:
     explicit FSP_SRV(FileSystemController& fsc, const Core::Reporter& reporter);
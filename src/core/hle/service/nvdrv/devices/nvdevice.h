@@ -5,8 +5,10 @@
 #pragma once
 
 #include <vector>
+#include "common/assert.h"
 #include "common/bit_field.h"
 #include "common/common_types.h"
+#include "common/span.h"
 #include "common/swap.h"
 #include "core/hle/service/nvdrv/nvdata.h"
 #include "core/hle/service/service.h"
@@ -43,6 +45,27 @@ public:
                       std::vector<u8>& output, std::vector<u8>& output2, IoctlCtrl& ctrl,
                       IoctlVersion version) = 0;
 
+    /// Whether an ioctl can be handled by IoctlInPlace. Ioctls that may be delayed can not.
+    virtual bool HandlesInPlace(Ioctl command, IoctlVersion version) const {
+        return false;
+    }
+
+    /**
+     * Handles an ioctl request on views of the guest buffers, skipping the copies into vectors
+     * done for ioctl. Only called for commands HandlesInPlace accepts.
+     * @param command The ioctl command id.
+     * @param input A view of the input data for the ioctl.
+     * @param input2 A view of the inline data of version 2 ioctls, empty otherwise.
+     * @param output A view of the buffer where the output data will be written to.
+     * @returns The result code of the ioctl.
+     */
+    virtual u32 IoctlInPlace(Ioctl command, Common::Span<const u8> input,
+                             Common::Span<const u8> input2, Common::Span<u8> output,
+                             IoctlVersion version) {
+        UNREACHABLE_MSG("Ioctl 0x{:08X} can not be handled in place", command.raw);
+        return 0;
+    }
+
 protected:
     Core::System& system;
 };
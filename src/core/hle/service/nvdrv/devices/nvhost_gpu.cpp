@@ -63,6 +63,24 @@ u32 nvhost_gpu::ioctl(Ioctl command, const std::vector<u8>& input, const std::ve
     return 0;
 };
 
+bool nvhost_gpu::HandlesInPlace(Ioctl command, IoctlVersion version) const {
+    return command.group == NVGPU_IOCTL_MAGIC && version != IoctlVersion::Version3 &&
+           (command.cmd == NVGPU_IOCTL_CHANNEL_SUBMIT_GPFIFO ||
+            command.cmd == NVGPU_IOCTL_CHANNEL_KICKOFF_PB);
+}
+
+u32 nvhost_gpu::IoctlInPlace(Ioctl command, Common::Span<const u8> input,
+                             Common::Span<const u8> input2, Common::Span<u8> output,
+                             IoctlVersion version) {
+    LOG_DEBUG(Service_NVDRV, "called, command=0x{:08X}, input_size=0x{:X}, output_size=0x{:X}",
+              command.raw, input.size(), output.size());
+
+    if (command.cmd == NVGPU_IOCTL_CHANNEL_SUBMIT_GPFIFO) {
+        return SubmitGPFIFO(input, output);
+    }
+    return KickoffPB(input, output, input2, version);
+}
+
 u32 nvhost_gpu::SetNVMAPfd(const std::vector<u8>& input, std::vector<u8>& output) {
     IoctlSetNvmapFD params{};
     std::memcpy(&params, input.data(), input.size());
@@ -145,7 +163,7 @@ u32 nvhost_gpu::AllocateObjectContext(const std::vector<u8>& input, std::vector<
     return 0;
 }
 
-u32 nvhost_gpu::SubmitGPFIFO(const std::vector<u8>& input, std::vector<u8>& output) {
+u32 nvhost_gpu::SubmitGPFIFO(Common::Span<const u8> input, Common::Span<u8> output) {
     if (input.size() < sizeof(IoctlSubmitGpfifo)) {
         UNIMPLEMENTED();
     }
@@ -158,14 +176,14 @@ u32 nvhost_gpu::SubmitGPFIFO(const std::vector<u8>& input, std::vector<u8>& outp
                                    params.num_entries * sizeof(Tegra::CommandListHeader),
                "Incorrect input size");
 
-    Tegra::CommandList entries(params.num_entries);
-    std::memcpy(entries.data(), &input[sizeof(IoctlSubmitGpfifo)],
-                params.num_entries * sizeof(Tegra::CommandListHeader));
+    auto& gpu = system.GPU();
+    Tegra::CommandList entries = gpu.CommandLists().Acquire(
+        reinterpret_cast<const Tegra::CommandListHeader*>(input.data() + sizeof(IoctlSubmitGpfifo)),
+        params.num_entries);
 
     UNIMPLEMENTED_IF(params.flags.add_wait.Value() != 0);
     UNIMPLEMENTED_IF(params.flags.add_increment.Value() != 0);
 
-    auto& gpu = system.GPU();
     u32 current_syncpoint_value = gpu.GetSyncpointValue(params.fence_out.id);
     if (params.flags.increment.Value()) {
         params.fence_out.value += current_syncpoint_value;
@@ -178,8 +196,8 @@ u32 nvhost_gpu::SubmitGPFIFO(const std::vector<u8>& input, std::vector<u8>& outp
     return 0;
 }
 
-u32 nvhost_gpu::KickoffPB(const std::vector<u8>& input, std::vector<u8>& output,
-                          const std::vector<u8>& input2, IoctlVersion version) {
+u32 nvhost_gpu::KickoffPB(Common::Span<const u8> input, Common::Span<u8> output,
+                          Common::Span<const u8> input2, IoctlVersion version) {
     if (input.size() < sizeof(IoctlSubmitGpfifo)) {
         UNIMPLEMENTED();
     }
@@ -188,18 +206,23 @@ u32 nvhost_gpu::KickoffPB(const std::vector<u8>& input, std::vector<u8>& output,
     LOG_TRACE(Service_NVDRV, "called, gpfifo={:X}, num_entries={:X}, flags={:X}", params.address,
               params.num_entries, params.flags.raw);
 
-    Tegra::CommandList entries(params.num_entries);
-    if (version == IoctlVersion::Version2) {
-        std::memcpy(entries.data(), input2.data(),
-                    params.num_entries * sizeof(Tegra::CommandListHeader));
+    auto& gpu = system.GPU();
+    const std::size_t size = params.num_entries * sizeof(Tegra::CommandListHeader);
+    const u8* source = input2.data();
+    if (version != IoctlVersion::Version2) {
+        source = system.Memory().GetContiguousSpan(params.address, size);
+    }
+    Tegra::CommandList entries;
+    if (source != nullptr) {
+        entries = gpu.CommandLists().Acquire(
+            reinterpret_cast<const Tegra::CommandListHeader*>(source), params.num_entries);
     } else {
-        system.Memory().ReadBlock(params.address, entries.data(),
-                                  params.num_entries * sizeof(Tegra::CommandListHeader));
+        entries = gpu.CommandLists().Acquire(params.num_entries);
+        system.Memory().ReadBlock(params.address, entries.data(), size);
     }
     UNIMPLEMENTED_IF(params.flags.add_wait.Value() != 0);
     UNIMPLEMENTED_IF(params.flags.add_increment.Value() != 0);
 
-    auto& gpu = system.GPU();
     u32 current_syncpoint_value = gpu.GetSyncpointValue(params.fence_out.id);
     if (params.flags.increment.Value()) {
         params.fence_out.value += current_syncpoint_value;
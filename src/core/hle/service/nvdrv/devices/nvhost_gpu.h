@@ -28,6 +28,11 @@ public:
               std::vector<u8>& output, std::vector<u8>& output2, IoctlCtrl& ctrl,
               IoctlVersion version) override;
 
+    bool HandlesInPlace(Ioctl command, IoctlVersion version) const override;
+
+    u32 IoctlInPlace(Ioctl command, Common::Span<const u8> input, Common::Span<const u8> input2,
+                     Common::Span<u8> output, IoctlVersion version) override;
+
 private:
     enum class IoctlCommand : u32_le {
         IocSetNVMAPfdCommand = 0x40044801,
@@ -190,9 +195,9 @@ private:
     u32 SetChannelPriority(const std::vector<u8>& input, std::vector<u8>& output);
     u32 AllocGPFIFOEx2(const std::vector<u8>& input, std::vector<u8>& output);
     u32 AllocateObjectContext(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 SubmitGPFIFO(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 KickoffPB(const std::vector<u8>& input, std::vector<u8>& output,
-                  const std::vector<u8>& input2, IoctlVersion version);
+    u32 SubmitGPFIFO(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 KickoffPB(Common::Span<const u8> input, Common::Span<u8> output,
+                  Common::Span<const u8> input2, IoctlVersion version);
     u32 GetWaitbase(const std::vector<u8>& input, std::vector<u8>& output);
     u32 ChannelSetTimeout(const std::vector<u8>& input, std::vector<u8>& output);
     u32 ChannelSetTimeslice(const std::vector<u8>& input, std::vector<u8>& output);
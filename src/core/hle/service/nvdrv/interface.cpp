@@ -38,6 +38,20 @@ void NVDRV::IoctlBase(Kernel::HLERequestContext& ctx, IoctlVersion version) {
     u32 fd = rp.Pop<u32>();
     u32 command = rp.Pop<u32>();
 
+    // Hot ioctls, such as GPFIFO submissions, work straight on the guest buffers.
+    if (nvdrv->HandlesInPlace(fd, command, version)) {
+        const auto input = ctx.ReadBufferSpan(0);
+        const auto input2 =
+            version == IoctlVersion::Version2 ? ctx.ReadBufferSpan(1) : Common::Span<const u8>{};
+        const u32 result = nvdrv->IoctlInPlace(fd, command, input, input2,
+                                               ctx.WriteBufferSpan(0), version);
+
+        IPC::ResponseBuilder rb{ctx, 3};
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(result);
+        return;
+    }
+
     /// Ioctl 3 has 2 outputs, first in the input params, second is the result
     std::vector<u8> output(ctx.GetWriteBufferSize(0));
     std::vector<u8> output2;
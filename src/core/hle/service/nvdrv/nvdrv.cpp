@@ -80,6 +80,20 @@ u32 Module::Ioctl(u32 fd, u32 command, const std::vector<u8>& input, const std::
     return device->ioctl({command}, input, input2, output, output2, ctrl, version);
 }
 
+bool Module::HandlesInPlace(u32 fd, u32 command, IoctlVersion version) const {
+    const auto itr = open_files.find(fd);
+    return itr != open_files.end() && itr->second->HandlesInPlace({command}, version);
+}
+
+u32 Module::IoctlInPlace(u32 fd, u32 command, Common::Span<const u8> input,
+                         Common::Span<const u8> input2, Common::Span<u8> output,
+                         IoctlVersion version) {
+    auto itr = open_files.find(fd);
+    ASSERT_MSG(itr != open_files.end(), "Tried to talk to an invalid device");
+
+    return itr->second->IoctlInPlace({command}, input, input2, output, version);
+}
+
 ResultCode Module::Close(u32 fd) {
     auto itr = open_files.find(fd);
     ASSERT_MSG(itr != open_files.end(), "Tried to talk to an invalid device");
@@ -8,6 +8,7 @@
 #include <unordered_map>
 #include <vector>
 #include "common/common_types.h"
+#include "common/span.h"
 #include "core/hle/kernel/writable_event.h"
 #include "core/hle/service/nvdrv/nvdata.h"
 #include "core/hle/service/service.h"
@@ -109,6 +110,11 @@ public:
     u32 Ioctl(u32 fd, u32 command, const std::vector<u8>& input, const std::vector<u8>& input2,
               std::vector<u8>& output, std::vector<u8>& output2, IoctlCtrl& ctrl,
               IoctlVersion version);
+    /// Whether an ioctl to the specified file descriptor can be handled by IoctlInPlace.
+    bool HandlesInPlace(u32 fd, u32 command, IoctlVersion version) const;
+    /// Sends an ioctl command to the specified file descriptor, on views of the guest buffers.
+    u32 IoctlInPlace(u32 fd, u32 command, Common::Span<const u8> input,
+                     Common::Span<const u8> input2, Common::Span<u8> output, IoctlVersion version);
     /// Closes a device file descriptor and returns operation success.
     ResultCode Close(u32 fd);
 
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <chrono>
 #include <fmt/format.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -25,6 +26,7 @@
 #include "core/hle/service/btdrv/btdrv.h"
 #include "core/hle/service/btm/btm.h"
 #include "core/hle/service/caps/caps.h"
+#include "core/hle/service/command_stats.h"
 #include "core/hle/service/erpt/erpt.h"
 #include "core/hle/service/es/es.h"
 #include "core/hle/service/eupld/eupld.h"
@@ -69,6 +71,7 @@
 #include "core/hle/service/vi/vi.h"
 #include "core/hle/service/wlan/wlan.h"
 #include "core/reporter.h"
+#include "core/settings.h"
 
 namespace Service {
 
@@ -129,13 +132,54 @@ std::shared_ptr<Kernel::ClientPort> ServiceFrameworkBase::CreatePort() {
 }
 
 void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n) {
+    auto& command_stats = Core::System::GetInstance().GetServiceCommandStats();
+    const bool record_stats = Settings::values.record_service_stats;
+
     handlers.reserve(handlers.size() + n);
     for (std::size_t i = 0; i < n; ++i) {
+        const FunctionInfoBase& info = functions[i];
+        CommandStats* const stats =
+            record_stats ? &command_stats.Get(service_name, info.expected_header, info.name)
+                         : nullptr;
         // Usually this array is sorted by id already, so hint to insert at the end
-        handlers.emplace_hint(handlers.cend(), functions[i].expected_header, functions[i]);
+        handlers.emplace_hint(handlers.cend(), info.expected_header,
+                              HandlerEntry{info, stats, false});
+    }
+
+    // Most services use small command ids, dispatch those with a single indexed load. Indices are
+    // stored instead of pointers so that they survive the map reallocating.
+    dense_handlers.clear();
+    for (std::size_t i = 0; i < handlers.size(); ++i) {
+        const u32 command = handlers.nth(i)->first;
+        if (command >= MAX_DENSE_COMMAND_ID) {
+            break;
+        }
+        dense_handlers.resize(command + 1);
+        dense_handlers[command] = static_cast<u16>(i + 1);
+    }
+}
+
+void ServiceFrameworkBase::SetAsyncCommands(std::initializer_list<u32> commands) {
+    for (const u32 command : commands) {
+        const auto itr = handlers.find(command);
+        ASSERT_MSG(itr != handlers.end(), "Command {} of {} is not registered", command,
+                   service_name);
+        itr->second.is_async = true;
     }
 }
 
+const ServiceFrameworkBase::HandlerEntry* ServiceFrameworkBase::FindHandler(u32 command) const {
+    if (command < dense_handlers.size()) {
+        const u16 index = dense_handlers[command];
+        return index == 0 ? nullptr : &handlers.nth(index - 1)->second;
+    }
+    if (command < MAX_DENSE_COMMAND_ID) {
+        return nullptr;
+    }
+    const auto itr = handlers.find(command);
+    return itr == handlers.end() ? nullptr : &itr->second;
+}
+
 void ServiceFrameworkBase::ReportUnimplementedFunction(Kernel::HLERequestContext& ctx,
                                                        const FunctionInfoBase* info) {
     auto cmd_buf = ctx.CommandBuffer();
@@ -155,14 +199,37 @@ void ServiceFrameworkBase::ReportUnimplementedFunction(Kernel::HLERequestContext
 }
 
 void ServiceFrameworkBase::InvokeRequest(Kernel::HLERequestContext& ctx) {
-    auto itr = handlers.find(ctx.GetCommand());
-    const FunctionInfoBase* info = itr == handlers.end() ? nullptr : &itr->second;
-    if (info == nullptr || info->handler_callback == nullptr) {
-        return ReportUnimplementedFunction(ctx, info);
+    const HandlerEntry* const entry = FindHandler(ctx.GetCommand());
+    if (entry == nullptr || entry->info.handler_callback == nullptr) {
+        return ReportUnimplementedFunction(ctx, entry == nullptr ? nullptr : &entry->info);
+    }
+
+    const FunctionInfoBase& info = entry->info;
+    LOG_TRACE(Service, "{}", MakeFunctionString(info.name, GetServiceName(), ctx.CommandBuffer()));
+    if (entry->stats == nullptr) {
+        handler_invoker(this, info.handler_callback, ctx);
+        return;
     }
 
-    LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
-    handler_invoker(this, info->handler_callback, ctx);
+    const auto start = std::chrono::steady_clock::now();
+    handler_invoker(this, info.handler_callback, ctx);
+    entry->stats->latency.Record(std::chrono::steady_clock::now() - start);
+}
+
+bool ServiceFrameworkBase::CanHandleAsync(const Kernel::HLERequestContext& context) const {
+    switch (context.GetCommandType()) {
+    case IPC::CommandType::RequestWithContext:
+    case IPC::CommandType::Request: {
+        const HandlerEntry* const entry = FindHandler(context.GetCommand());
+        return entry != nullptr && entry->is_async && entry->info.handler_callback != nullptr;
+    }
+    default:
+        return false;
+    }
+}
+
+void ServiceFrameworkBase::HandleAsyncRequest(Kernel::HLERequestContext& context) {
+    InvokeRequest(context);
 }
 
 ResultCode ServiceFrameworkBase::HandleSyncRequest(Kernel::HLERequestContext& context) {
@@ -5,7 +5,9 @@
 #pragma once
 
 #include <cstddef>
+#include <initializer_list>
 #include <string>
+#include <vector>
 #include <boost/container/flat_map.hpp>
 #include "common/common_types.h"
 #include "core/hle/kernel/hle_ipc.h"
@@ -35,6 +37,8 @@ namespace SM {
 class ServiceManager;
 }
 
+struct CommandStats;
+
 static const int kMaxPortSize = 8; ///< Maximum size of a port name (8 characters)
 /// Arbitrary default number of maximum connections to an HLE service.
 static const u32 DefaultMaxSessions = 10;
@@ -70,12 +74,21 @@ public:
     void InvokeRequest(Kernel::HLERequestContext& ctx);
 
     ResultCode HandleSyncRequest(Kernel::HLERequestContext& context) override;
+    bool CanHandleAsync(const Kernel::HLERequestContext& context) const override;
+    void HandleAsyncRequest(Kernel::HLERequestContext& context) override;
 
 protected:
     /// Member-function pointer type of SyncRequest handlers.
     template <typename Self>
     using HandlerFnP = void (Self::*)(Kernel::HLERequestContext&);
 
+    /**
+     * Allows registered commands to be handled on the service threads, see
+     * SessionRequestHandler::CanHandleAsync. Their handlers must only touch state owned by this
+     * interface and guest memory through the request buffers.
+     */
+    void SetAsyncCommands(std::initializer_list<u32> commands);
+
 private:
     template <typename T>
     friend class ServiceFramework;
@@ -86,6 +99,17 @@ private:
         const char* name;
     };
 
+    struct HandlerEntry {
+        FunctionInfoBase info;
+        /// Statistics of the command, null when they are not being recorded.
+        CommandStats* stats;
+        /// Whether the command may be handled on the service threads.
+        bool is_async;
+    };
+
+    /// Commands with a lower id are dispatched through a table indexed by id.
+    static constexpr u32 MAX_DENSE_COMMAND_ID = 0x400;
+
     using InvokerFn = void(ServiceFrameworkBase* object, HandlerFnP<ServiceFrameworkBase> member,
                            Kernel::HLERequestContext& ctx);
 
@@ -93,6 +117,7 @@ private:
     ~ServiceFrameworkBase() override;
 
     void RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n);
+    const HandlerEntry* FindHandler(u32 command) const;
     void ReportUnimplementedFunction(Kernel::HLERequestContext& ctx, const FunctionInfoBase* info);
 
     /// Identifier string used to connect to the service.
@@ -106,7 +131,9 @@ private:
 
     /// Function used to safely up-cast pointers to the derived class before invoking a handler.
     InvokerFn* handler_invoker;
-    boost::container::flat_map<u32, FunctionInfoBase> handlers;
+    boost::container::flat_map<u32, HandlerEntry> handlers;
+    /// Indices plus one into handlers, indexed by command id, zero for unregistered commands.
+    std::vector<u16> dense_handlers;
 };
 
 /**
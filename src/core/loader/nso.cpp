@@ -35,17 +35,6 @@ struct MODHeader {
 };
 static_assert(sizeof(MODHeader) == 0x1c, "MODHeader has incorrect size.");
 
-std::vector<u8> DecompressSegment(const std::vector<u8>& compressed_data,
-                                  const NSOSegmentHeader& header) {
-    const std::vector<u8> uncompressed_data =
-        Common::Compression::DecompressDataLZ4(compressed_data, header.size);
-
-    ASSERT_MSG(uncompressed_data.size() == header.size, "{} != {}", header.size,
-               uncompressed_data.size());
-
-    return uncompressed_data;
-}
-
 constexpr u32 PageAlignSize(u32 size) {
     return (size + Memory::PAGE_MASK) & ~Memory::PAGE_MASK;
 }
@@ -92,18 +81,30 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::Process& process,
     Kernel::CodeSet codeset;
     Kernel::PhysicalMemory program_image;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data =
-            file.ReadBytes(nso_header.segments_compressed_size[i], nso_header.segments[i].offset);
-        if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
+        const auto& segment = nso_header.segments[i];
+
+        // Segments are copied or decompressed straight from the file when it exposes its
+        // contents, like mapped NSOs on the host filesystem do.
+        std::vector<u8> data;
+        auto source = file.GetSpan(nso_header.segments_compressed_size[i], segment.offset);
+        if (source.empty()) {
+            data = file.ReadBytes(nso_header.segments_compressed_size[i], segment.offset);
+            source = data;
+        }
+
+        const bool is_compressed = nso_header.IsSegmentCompressed(i);
+        const auto size = is_compressed ? segment.size : static_cast<u32>(source.size());
+        program_image.resize(segment.location + PageAlignSize(size));
+        if (is_compressed) {
+            const bool decompressed = Common::Compression::DecompressDataLZ4(
+                source.data(), source.size(), program_image.data() + segment.location, size);
+            ASSERT_MSG(decompressed, "Failed to decompress segment {}", i);
+        } else {
+            std::memcpy(program_image.data() + segment.location, source.data(), size);
         }
-        program_image.resize(nso_header.segments[i].location +
-                             PageAlignSize(static_cast<u32>(data.size())));
-        std::memcpy(program_image.data() + nso_header.segments[i].location, data.data(),
-                    data.size());
-        codeset.segments[i].addr = nso_header.segments[i].location;
-        codeset.segments[i].offset = nso_header.segments[i].location;
-        codeset.segments[i].size = PageAlignSize(static_cast<u32>(data.size()));
+        codeset.segments[i].addr = segment.location;
+        codeset.segments[i].offset = segment.location;
+        codeset.segments[i].size = PageAlignSize(size);
     }
 
     if (should_pass_arguments) {
@@ -6,6 +6,7 @@
 #include <cstring>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "common/assert.h"
 #include "common/common_types.h"
@@ -18,6 +19,8 @@
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/vm_manager.h"
 #include "core/memory.h"
+#include "core/memory/write_tracker.h"
+#include "core/settings.h"
 #include "video_core/gpu.h"
 
 namespace Memory {
@@ -31,6 +34,21 @@ struct Memory::Impl {
     void SetCurrentPageTable(Kernel::Process& process) {
         current_page_table = &process.VMManager().page_table;
 
+        // Write tracking defers the invalidation of memory written by the CPU until the GPU next
+        // reads guest memory, so it is only used when the GPU is not emulated accurately.
+        const bool use_write_tracking = Settings::values.use_write_tracking &&
+                                        !Settings::values.use_accurate_gpu_emulation &&
+                                        WriteTracker::IsSupported();
+        if (use_write_tracking) {
+            if (write_tracker) {
+                write_tracker->Clear();
+            } else {
+                write_tracker = std::make_unique<WriteTracker>();
+            }
+        } else {
+            write_tracker.reset();
+        }
+
         const std::size_t address_space_width = process.VMManager().GetAddressSpaceWidth();
 
         system.ArmInterface(0).PageTableChanged(*current_page_table, address_space_width);
@@ -211,50 +229,132 @@ struct Memory::Impl {
         return string;
     }
 
-    void ReadBlock(const Kernel::Process& process, const VAddr src_addr, void* dest_buffer,
-                   const std::size_t size) {
-        const auto& page_table = process.VMManager().page_table;
-
-        std::size_t remaining_size = size;
-        std::size_t page_index = src_addr >> PAGE_BITS;
-        std::size_t page_offset = src_addr & PAGE_MASK;
-
-        while (remaining_size > 0) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(PAGE_SIZE) - page_offset, remaining_size);
-            const auto current_vaddr = static_cast<VAddr>((page_index << PAGE_BITS) + page_offset);
-
-            switch (page_table.attributes[page_index]) {
-            case Common::PageType::Unmapped: {
-                LOG_ERROR(HW_Memory,
-                          "Unmapped ReadBlock @ 0x{:016X} (start address = 0x{:016X}, size = {})",
-                          current_vaddr, src_addr, size);
-                std::memset(dest_buffer, 0, copy_amount);
+    /**
+     * Walks the pages of a block of memory, calling the handler matching the page type once for
+     * every run of pages that share that type and are contiguous in host memory.
+     *
+     * @param page_table    The page table to walk.
+     * @param addr          The virtual address the block starts at.
+     * @param size          The size of the block in bytes.
+     * @param on_unmapped   Called as (block offset, run address, run size) for unmapped runs.
+     * @param on_memory     Called as (block offset, host pointer, run size) for memory runs.
+     * @param on_rasterizer Called as (block offset, host pointer, run size) for rasterizer cached
+     *                      memory runs.
+     */
+    template <typename OnUnmapped, typename OnMemory, typename OnRasterizer>
+    void WalkBlock(const Common::PageTable& page_table, const VAddr addr, const std::size_t size,
+                   OnUnmapped&& on_unmapped, OnMemory&& on_memory, OnRasterizer&& on_rasterizer) {
+        std::size_t offset = 0;
+        std::size_t page_index = addr >> PAGE_BITS;
+
+        while (offset < size) {
+            const Common::PageType type = page_table.attributes[page_index];
+            const VAddr run_vaddr = addr + offset;
+
+            // Page table entries are offset by their virtual address, so pages are contiguous in
+            // host memory exactly when their entries are equal.
+            u8* run_base = nullptr;
+            switch (type) {
+            case Common::PageType::Unmapped:
                 break;
-            }
-            case Common::PageType::Memory: {
+            case Common::PageType::Memory:
                 DEBUG_ASSERT(page_table.pointers[page_index]);
-
-                const u8* const src_ptr =
-                    page_table.pointers[page_index] + page_offset + (page_index << PAGE_BITS);
-                std::memcpy(dest_buffer, src_ptr, copy_amount);
+                run_base = page_table.pointers[page_index];
                 break;
-            }
-            case Common::PageType::RasterizerCachedMemory: {
-                const u8* const host_ptr = GetPointerFromVMA(process, current_vaddr);
-                system.GPU().FlushRegion(ToCacheAddr(host_ptr), copy_amount);
-                std::memcpy(dest_buffer, host_ptr, copy_amount);
+            case Common::PageType::RasterizerCachedMemory:
+                run_base = reinterpret_cast<u8*>(page_table.backing_addr[page_index]);
                 break;
+            default:
+                UNREACHABLE();
             }
+
+            std::size_t run_size =
+                std::min<std::size_t>(PAGE_SIZE - (run_vaddr & PAGE_MASK), size - offset);
+            ++page_index;
+            while (offset + run_size < size && page_table.attributes[page_index] == type &&
+                   IsSameRun(page_table, page_index, type, run_base)) {
+                run_size += std::min<std::size_t>(PAGE_SIZE, size - offset - run_size);
+                ++page_index;
+            }
+
+            switch (type) {
+            case Common::PageType::Unmapped:
+                on_unmapped(offset, run_vaddr, run_size);
+                break;
+            case Common::PageType::Memory:
+                on_memory(offset, run_base + run_vaddr, run_size);
+                break;
+            case Common::PageType::RasterizerCachedMemory:
+                on_rasterizer(offset, run_base + run_vaddr, run_size);
+                break;
             default:
                 UNREACHABLE();
             }
 
-            page_index++;
-            page_offset = 0;
-            dest_buffer = static_cast<u8*>(dest_buffer) + copy_amount;
-            remaining_size -= copy_amount;
+            offset += run_size;
+        }
+    }
+
+    /// Whether a page continues a run of the given type that started with the given entry.
+    static bool IsSameRun(const Common::PageTable& page_table, std::size_t page_index,
+                          Common::PageType type, const u8* run_base) {
+        switch (type) {
+        case Common::PageType::Memory:
+            return page_table.pointers[page_index] == run_base;
+        case Common::PageType::RasterizerCachedMemory:
+            return reinterpret_cast<const u8*>(page_table.backing_addr[page_index]) == run_base;
+        default:
+            return true;
+        }
+    }
+
+    u8* GetContiguousSpan(const Kernel::Process& process, const VAddr vaddr,
+                          const std::size_t size) {
+        if (size == 0) {
+            return nullptr;
+        }
+
+        const auto& page_table = process.VMManager().page_table;
+        const std::size_t first_page = vaddr >> PAGE_BITS;
+        const std::size_t last_page = (vaddr + size - 1) >> PAGE_BITS;
+        if (last_page >= page_table.pointers.size()) {
+            return nullptr;
+        }
+
+        u8* const base = page_table.pointers[first_page];
+        if (base == nullptr) {
+            return nullptr;
         }
+        for (std::size_t page = first_page + 1; page <= last_page; ++page) {
+            if (page_table.pointers[page] != base) {
+                return nullptr;
+            }
+        }
+        return base + vaddr;
+    }
+
+    u8* GetContiguousSpan(const VAddr vaddr, const std::size_t size) {
+        return GetContiguousSpan(*system.CurrentProcess(), vaddr, size);
+    }
+
+    void ReadBlock(const Kernel::Process& process, const VAddr src_addr, void* dest_buffer,
+                   const std::size_t size) {
+        u8* const dest = static_cast<u8*>(dest_buffer);
+        WalkBlock(
+            process.VMManager().page_table, src_addr, size,
+            [&](std::size_t offset, VAddr current_vaddr, std::size_t copy_amount) {
+                LOG_ERROR(HW_Memory,
+                          "Unmapped ReadBlock @ 0x{:016X} (start address = 0x{:016X}, size = {})",
+                          current_vaddr, src_addr, size);
+                std::memset(dest + offset, 0, copy_amount);
+            },
+            [&](std::size_t offset, const u8* src_ptr, std::size_t copy_amount) {
+                std::memcpy(dest + offset, src_ptr, copy_amount);
+            },
+            [&](std::size_t offset, const u8* host_ptr, std::size_t copy_amount) {
+                FlushRasterizerRegion(host_ptr, copy_amount);
+                std::memcpy(dest + offset, host_ptr, copy_amount);
+            });
     }
 
     void ReadBlock(const VAddr src_addr, void* dest_buffer, const std::size_t size) {
@@ -263,46 +363,21 @@ struct Memory::Impl {
 
     void WriteBlock(const Kernel::Process& process, const VAddr dest_addr, const void* src_buffer,
                     const std::size_t size) {
-        const auto& page_table = process.VMManager().page_table;
-        std::size_t remaining_size = size;
-        std::size_t page_index = dest_addr >> PAGE_BITS;
-        std::size_t page_offset = dest_addr & PAGE_MASK;
-
-        while (remaining_size > 0) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(PAGE_SIZE) - page_offset, remaining_size);
-            const auto current_vaddr = static_cast<VAddr>((page_index << PAGE_BITS) + page_offset);
-
-            switch (page_table.attributes[page_index]) {
-            case Common::PageType::Unmapped: {
+        const u8* const src = static_cast<const u8*>(src_buffer);
+        WalkBlock(
+            process.VMManager().page_table, dest_addr, size,
+            [&](std::size_t, VAddr current_vaddr, std::size_t) {
                 LOG_ERROR(HW_Memory,
                           "Unmapped WriteBlock @ 0x{:016X} (start address = 0x{:016X}, size = {})",
                           current_vaddr, dest_addr, size);
-                break;
-            }
-            case Common::PageType::Memory: {
-                DEBUG_ASSERT(page_table.pointers[page_index]);
-
-                u8* const dest_ptr =
-                    page_table.pointers[page_index] + page_offset + (page_index << PAGE_BITS);
-                std::memcpy(dest_ptr, src_buffer, copy_amount);
-                break;
-            }
-            case Common::PageType::RasterizerCachedMemory: {
-                u8* const host_ptr = GetPointerFromVMA(process, current_vaddr);
-                system.GPU().InvalidateRegion(ToCacheAddr(host_ptr), copy_amount);
-                std::memcpy(host_ptr, src_buffer, copy_amount);
-                break;
-            }
-            default:
-                UNREACHABLE();
-            }
-
-            page_index++;
-            page_offset = 0;
-            src_buffer = static_cast<const u8*>(src_buffer) + copy_amount;
-            remaining_size -= copy_amount;
-        }
+            },
+            [&](std::size_t offset, u8* dest_ptr, std::size_t copy_amount) {
+                std::memcpy(dest_ptr, src + offset, copy_amount);
+            },
+            [&](std::size_t offset, u8* host_ptr, std::size_t copy_amount) {
+                InvalidateRasterizerRegion(host_ptr, copy_amount);
+                std::memcpy(host_ptr, src + offset, copy_amount);
+            });
     }
 
     void WriteBlock(const VAddr dest_addr, const void* src_buffer, const std::size_t size) {
@@ -310,45 +385,20 @@ struct Memory::Impl {
     }
 
     void ZeroBlock(const Kernel::Process& process, const VAddr dest_addr, const std::size_t size) {
-        const auto& page_table = process.VMManager().page_table;
-        std::size_t remaining_size = size;
-        std::size_t page_index = dest_addr >> PAGE_BITS;
-        std::size_t page_offset = dest_addr & PAGE_MASK;
-
-        while (remaining_size > 0) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(PAGE_SIZE) - page_offset, remaining_size);
-            const auto current_vaddr = static_cast<VAddr>((page_index << PAGE_BITS) + page_offset);
-
-            switch (page_table.attributes[page_index]) {
-            case Common::PageType::Unmapped: {
+        WalkBlock(
+            process.VMManager().page_table, dest_addr, size,
+            [&](std::size_t, VAddr current_vaddr, std::size_t) {
                 LOG_ERROR(HW_Memory,
                           "Unmapped ZeroBlock @ 0x{:016X} (start address = 0x{:016X}, size = {})",
                           current_vaddr, dest_addr, size);
-                break;
-            }
-            case Common::PageType::Memory: {
-                DEBUG_ASSERT(page_table.pointers[page_index]);
-
-                u8* dest_ptr =
-                    page_table.pointers[page_index] + page_offset + (page_index << PAGE_BITS);
+            },
+            [&](std::size_t, u8* dest_ptr, std::size_t copy_amount) {
                 std::memset(dest_ptr, 0, copy_amount);
-                break;
-            }
-            case Common::PageType::RasterizerCachedMemory: {
-                u8* const host_ptr = GetPointerFromVMA(process, current_vaddr);
-                system.GPU().InvalidateRegion(ToCacheAddr(host_ptr), copy_amount);
+            },
+            [&](std::size_t, u8* host_ptr, std::size_t copy_amount) {
+                InvalidateRasterizerRegion(host_ptr, copy_amount);
                 std::memset(host_ptr, 0, copy_amount);
-                break;
-            }
-            default:
-                UNREACHABLE();
-            }
-
-            page_index++;
-            page_offset = 0;
-            remaining_size -= copy_amount;
-        }
+            });
     }
 
     void ZeroBlock(const VAddr dest_addr, const std::size_t size) {
@@ -357,47 +407,21 @@ struct Memory::Impl {
 
     void CopyBlock(const Kernel::Process& process, VAddr dest_addr, VAddr src_addr,
                    const std::size_t size) {
-        const auto& page_table = process.VMManager().page_table;
-        std::size_t remaining_size = size;
-        std::size_t page_index = src_addr >> PAGE_BITS;
-        std::size_t page_offset = src_addr & PAGE_MASK;
-
-        while (remaining_size > 0) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(PAGE_SIZE) - page_offset, remaining_size);
-            const auto current_vaddr = static_cast<VAddr>((page_index << PAGE_BITS) + page_offset);
-
-            switch (page_table.attributes[page_index]) {
-            case Common::PageType::Unmapped: {
+        WalkBlock(
+            process.VMManager().page_table, src_addr, size,
+            [&](std::size_t offset, VAddr current_vaddr, std::size_t copy_amount) {
                 LOG_ERROR(HW_Memory,
                           "Unmapped CopyBlock @ 0x{:016X} (start address = 0x{:016X}, size = {})",
                           current_vaddr, src_addr, size);
-                ZeroBlock(process, dest_addr, copy_amount);
-                break;
-            }
-            case Common::PageType::Memory: {
-                DEBUG_ASSERT(page_table.pointers[page_index]);
-                const u8* src_ptr =
-                    page_table.pointers[page_index] + page_offset + (page_index << PAGE_BITS);
-                WriteBlock(process, dest_addr, src_ptr, copy_amount);
-                break;
-            }
-            case Common::PageType::RasterizerCachedMemory: {
-                const u8* const host_ptr = GetPointerFromVMA(process, current_vaddr);
-                system.GPU().FlushRegion(ToCacheAddr(host_ptr), copy_amount);
-                WriteBlock(process, dest_addr, host_ptr, copy_amount);
-                break;
-            }
-            default:
-                UNREACHABLE();
-            }
-
-            page_index++;
-            page_offset = 0;
-            dest_addr += static_cast<VAddr>(copy_amount);
-            src_addr += static_cast<VAddr>(copy_amount);
-            remaining_size -= copy_amount;
-        }
+                ZeroBlock(process, dest_addr + offset, copy_amount);
+            },
+            [&](std::size_t offset, const u8* src_ptr, std::size_t copy_amount) {
+                WriteBlock(process, dest_addr + offset, src_ptr, copy_amount);
+            },
+            [&](std::size_t offset, const u8* host_ptr, std::size_t copy_amount) {
+                FlushRasterizerRegion(host_ptr, copy_amount);
+                WriteBlock(process, dest_addr + offset, host_ptr, copy_amount);
+            });
     }
 
     void CopyBlock(VAddr dest_addr, VAddr src_addr, std::size_t size) {
@@ -415,6 +439,7 @@ struct Memory::Impl {
         // is different). This assumes the specified GPU address region is contiguous as well.
 
         u64 num_pages = ((vaddr + size - 1) >> PAGE_BITS) - (vaddr >> PAGE_BITS) + 1;
+
         for (unsigned i = 0; i < num_pages; ++i, vaddr += PAGE_SIZE) {
             Common::PageType& page_type = current_page_table->attributes[vaddr >> PAGE_BITS];
 
@@ -427,6 +452,10 @@ struct Memory::Impl {
                     break;
                 case Common::PageType::Memory:
                     page_type = Common::PageType::RasterizerCachedMemory;
+                    if (write_tracker) {
+                        u8* const pointer = current_page_table->pointers[vaddr >> PAGE_BITS];
+                        write_tracker->Track(vaddr & ~PAGE_MASK, pointer + (vaddr & ~PAGE_MASK));
+                    }
                     current_page_table->pointers[vaddr >> PAGE_BITS] = nullptr;
                     break;
                 case Common::PageType::RasterizerCachedMemory:
@@ -448,6 +477,9 @@ struct Memory::Impl {
                     // that this area is already unmarked as cached.
                     break;
                 case Common::PageType::RasterizerCachedMemory: {
+                    if (write_tracker) {
+                        write_tracker->Untrack(vaddr & ~PAGE_MASK);
+                    }
                     u8* pointer = GetPointerFromVMA(vaddr & ~PAGE_MASK);
                     if (pointer == nullptr) {
                         // It's possible that this function has been called while updating the
@@ -468,6 +500,84 @@ struct Memory::Impl {
         }
     }
 
+    void ConsumeRasterizerDirtyPages(const std::function<void(u8*, std::size_t)>& func) {
+        if (write_tracker) {
+            write_tracker->ConsumeDirtyPages(func);
+        }
+    }
+
+    /**
+     * Flushes rasterizer cached memory about to be read by the CPU.
+     *
+     * @param host_ptr The host memory backing the range.
+     * @param size     The size of the range in bytes.
+     */
+    void FlushRasterizerRegion(const u8* host_ptr, std::size_t size) {
+        auto& gpu = system.GPU();
+        if (write_tracker) {
+            // CPU writes still waiting to be invalidated have to win over the cached GPU copy.
+            write_tracker->ConsumeDirtyPages([&gpu](u8* dirty_ptr, std::size_t dirty_size) {
+                gpu.InvalidateRegion(ToCacheAddr(dirty_ptr), dirty_size);
+            });
+        }
+        gpu.FlushRegion(ToCacheAddr(host_ptr), size);
+    }
+
+    /**
+     * Invalidates rasterizer cached memory about to be written by the CPU. Writes to pages with
+     * tracked writes are left to the write tracker, which batches their invalidation.
+     *
+     * @param host_ptr The host memory backing the range.
+     * @param size     The size of the range in bytes.
+     */
+    void InvalidateRasterizerRegion(u8* host_ptr, std::size_t size) {
+        if (write_tracker && write_tracker->IsTracked(host_ptr, size)) {
+            return;
+        }
+        system.GPU().InvalidateRegion(ToCacheAddr(host_ptr), size);
+    }
+
+    void FlushRegionBeforeRemap(Common::PageTable& page_table, VAddr base, u64 size) {
+        ASSERT_MSG((size & PAGE_MASK) == 0, "non-page aligned size: {:016X}", size);
+        ASSERT_MSG((base & PAGE_MASK) == 0, "non-page aligned base: {:016X}", base);
+        FlushPagesBeforeRemap(page_table, base / PAGE_SIZE, size / PAGE_SIZE);
+    }
+
+    /**
+     * Flushes the rasterizer cached pages of a region and stops tracking writes to them.
+     *
+     * @param page_table The page table to use to perform the flush.
+     * @param base       The first page of the region.
+     * @param size       The number of pages of the region.
+     */
+    void FlushPagesBeforeRemap(Common::PageTable& page_table, VAddr base, u64 size) {
+        // During boot, current_page_table might not be set yet, in which case we need not flush
+        if (!system.IsPoweredOn()) {
+            return;
+        }
+
+        // The rasterizer may untrack the pages after they have been remapped, so stop tracking
+        // them here while they still refer to the old backing memory.
+        std::vector<std::pair<VAddr, u8*>> tracked_pages;
+        if (write_tracker) {
+            tracked_pages = write_tracker->UntrackRange(base << PAGE_BITS, size << PAGE_BITS);
+        }
+
+        auto& gpu = system.GPU();
+        auto tracked_it = tracked_pages.begin();
+        for (u64 i = 0; i < size; i++) {
+            const auto page = base + i;
+            if (tracked_it != tracked_pages.end() && tracked_it->first == page << PAGE_BITS) {
+                gpu.FlushAndInvalidateRegion(ToCacheAddr(tracked_it->second), PAGE_SIZE);
+                ++tracked_it;
+                continue;
+            }
+            if (page_table.attributes[page] == Common::PageType::RasterizerCachedMemory) {
+                gpu.FlushAndInvalidateRegion(page << PAGE_BITS, PAGE_SIZE);
+            }
+        }
+    }
+
     /**
      * Maps a region of pages as a specific type.
      *
@@ -482,29 +592,29 @@ struct Memory::Impl {
         LOG_DEBUG(HW_Memory, "Mapping {} onto {:016X}-{:016X}", fmt::ptr(memory), base * PAGE_SIZE,
                   (base + size) * PAGE_SIZE);
 
-        // During boot, current_page_table might not be set yet, in which case we need not flush
-        if (system.IsPoweredOn()) {
-            auto& gpu = system.GPU();
-            for (u64 i = 0; i < size; i++) {
-                const auto page = base + i;
-                if (page_table.attributes[page] == Common::PageType::RasterizerCachedMemory) {
-                    gpu.FlushAndInvalidateRegion(page << PAGE_BITS, PAGE_SIZE);
-                }
-            }
-        }
+        FlushPagesBeforeRemap(page_table, base, size);
 
         const VAddr end = base + size;
         ASSERT_MSG(end <= page_table.pointers.size(), "out of range mapping at {:016X}",
                    base + page_table.pointers.size());
 
+        if (type == Common::PageType::Unmapped) {
+            // Unmapping can cover huge ranges, avoid committing table memory for them.
+            page_table.ClearPages(base, size);
+            return;
+        }
+
         std::fill(page_table.attributes.begin() + base, page_table.attributes.begin() + end, type);
 
         if (memory == nullptr) {
             std::fill(page_table.pointers.begin() + base, page_table.pointers.begin() + end,
                       memory);
+            std::fill(page_table.backing_addr.begin() + base,
+                      page_table.backing_addr.begin() + end, 0);
         } else {
             while (base != end) {
                 page_table.pointers[base] = memory - (base << PAGE_BITS);
+                page_table.backing_addr[base] = reinterpret_cast<u64>(page_table.pointers[base]);
                 ASSERT_MSG(page_table.pointers[base],
                            "memory mapping base yield a nullptr within the table");
 
@@ -545,7 +655,7 @@ struct Memory::Impl {
             break;
         case Common::PageType::RasterizerCachedMemory: {
             const u8* const host_ptr = GetPointerFromVMA(vaddr);
-            system.GPU().FlushRegion(ToCacheAddr(host_ptr), sizeof(T));
+            FlushRasterizerRegion(host_ptr, sizeof(T));
             T value;
             std::memcpy(&value, host_ptr, sizeof(T));
             return value;
@@ -587,7 +697,7 @@ struct Memory::Impl {
             break;
         case Common::PageType::RasterizerCachedMemory: {
             u8* const host_ptr{GetPointerFromVMA(vaddr)};
-            system.GPU().InvalidateRegion(ToCacheAddr(host_ptr), sizeof(T));
+            InvalidateRasterizerRegion(host_ptr, sizeof(T));
             std::memcpy(host_ptr, &data, sizeof(T));
             break;
         }
@@ -597,6 +707,7 @@ struct Memory::Impl {
     }
 
     Common::PageTable* current_page_table = nullptr;
+    std::unique_ptr<WriteTracker> write_tracker;
     Core::System& system;
 };
 
@@ -625,6 +736,10 @@ void Memory::UnmapRegion(Common::PageTable& page_table, VAddr base, u64 size) {
     impl->UnmapRegion(page_table, base, size);
 }
 
+void Memory::FlushRegionBeforeRemap(Common::PageTable& page_table, VAddr base, u64 size) {
+    impl->FlushRegionBeforeRemap(page_table, base, size);
+}
+
 void Memory::AddDebugHook(Common::PageTable& page_table, VAddr base, u64 size,
                           Common::MemoryHookPointer hook) {
     impl->AddDebugHook(page_table, base, size, std::move(hook));
@@ -651,6 +766,14 @@ const u8* Memory::GetPointer(VAddr vaddr) const {
     return impl->GetPointer(vaddr);
 }
 
+u8* Memory::GetContiguousSpan(const Kernel::Process& process, VAddr vaddr, std::size_t size) {
+    return impl->GetContiguousSpan(process, vaddr, size);
+}
+
+u8* Memory::GetContiguousSpan(VAddr vaddr, std::size_t size) {
+    return impl->GetContiguousSpan(vaddr, size);
+}
+
 u8 Memory::Read8(const VAddr addr) {
     return impl->Read8(addr);
 }
@@ -726,6 +849,10 @@ void Memory::RasterizerMarkRegionCached(VAddr vaddr, u64 size, bool cached) {
     impl->RasterizerMarkRegionCached(vaddr, size, cached);
 }
 
+void Memory::ConsumeRasterizerDirtyPages(const std::function<void(u8*, std::size_t)>& func) {
+    impl->ConsumeRasterizerDirtyPages(func);
+}
+
 bool IsKernelVirtualAddress(const VAddr vaddr) {
     return KERNEL_REGION_VADDR <= vaddr && vaddr < KERNEL_REGION_END;
 }
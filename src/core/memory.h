@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include "common/common_types.h"
@@ -110,6 +111,17 @@ public:
      */
     void UnmapRegion(Common::PageTable& page_table, VAddr base, u64 size);
 
+    /**
+     * Flushes the rasterizer cached pages of a region and stops tracking CPU writes to them. Must
+     * be called before the memory backing the region is reallocated, as the old backing memory is
+     * no longer reachable afterwards.
+     *
+     * @param page_table The page table of the emulated process.
+     * @param base       The address the region starts at. Must be page-aligned.
+     * @param size       The amount of bytes in the region. Must be page-aligned.
+     */
+    void FlushRegionBeforeRemap(Common::PageTable& page_table, VAddr base, u64 size);
+
     /**
      * Adds a memory hook to intercept reads and writes to given region of memory.
      *
@@ -173,6 +185,35 @@ public:
      */
     const u8* GetPointer(VAddr vaddr) const;
 
+    /**
+     * Gets a pointer to a range of a process' address space, if the whole range is backed by
+     * regular memory that is contiguous in host memory. This allows reading and writing large
+     * buffers in place, without copying them.
+     *
+     * @param process The process to look the range up in.
+     * @param vaddr   The virtual address the range starts at.
+     * @param size    The size of the range in bytes.
+     *
+     * @returns A pointer to the first byte of the range, valid for `size` bytes, or nullptr if
+     *          the range is not entirely backed by contiguous regular memory.
+     *
+     * @note Ranges containing rasterizer cached memory are rejected, as accessing them requires
+     *       flushing or invalidating GPU caches. Use ReadBlock/WriteBlock for those.
+     */
+    u8* GetContiguousSpan(const Kernel::Process& process, VAddr vaddr, std::size_t size);
+
+    /**
+     * Gets a pointer to a range of the current process' address space, if the whole range is
+     * backed by regular memory that is contiguous in host memory.
+     *
+     * @param vaddr The virtual address the range starts at.
+     * @param size  The size of the range in bytes.
+     *
+     * @returns A pointer to the first byte of the range, valid for `size` bytes, or nullptr if
+     *          the range is not entirely backed by contiguous regular memory.
+     */
+    u8* GetContiguousSpan(VAddr vaddr, std::size_t size);
+
     /**
      * Reads an 8-bit unsigned value from the current process' address space
      * at the given virtual address.
@@ -417,6 +458,15 @@ public:
      */
     void RasterizerMarkRegionCached(VAddr vaddr, u64 size, bool cached);
 
+    /**
+     * Hands out the host memory of cached pages written by the CPU since the last call. Only
+     * produces pages when write tracking is in use, otherwise writes to cached pages are reported
+     * to the GPU as they happen.
+     *
+     * @param func Function called with the start and size of each written host memory run.
+     */
+    void ConsumeRasterizerDirtyPages(const std::function<void(u8*, std::size_t)>& func);
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl;
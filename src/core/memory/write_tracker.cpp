@@ -0,0 +1,229 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/assert.h"
+#include "common/bit_util.h"
+#include "common/host_memory.h"
+#include "common/logging/log.h"
+#include "core/memory/write_tracker.h"
+
+namespace Memory {
+
+namespace {
+constexpr u64 PageBit(std::size_t index) {
+    return u64{1} << (index % 64);
+}
+} // Anonymous namespace
+
+WriteTracker::WriteTracker() : leaves{std::make_unique<std::atomic<Leaf*>[]>(NUM_LEAVES)} {
+    fault_handler_id = Common::RegisterFaultHandler(
+        [this](u8* address, bool is_write) { return is_write && HandleFault(address); });
+}
+
+WriteTracker::~WriteTracker() {
+    Clear();
+    // Waits for faults still being resolved, after which the bitmaps can go.
+    Common::UnregisterFaultHandler(fault_handler_id);
+}
+
+bool WriteTracker::IsSupported() {
+    // Host pages have to match guest pages, otherwise protecting a guest page would also affect
+    // its neighbours.
+    return Common::GetHostPageSize() == PAGE_SIZE;
+}
+
+bool WriteTracker::Track(VAddr vaddr, u8* host_page) {
+    const std::uintptr_t page_number = reinterpret_cast<std::uintptr_t>(host_page) >> PAGE_BITS;
+    const std::size_t leaf_index = page_number >> LEAF_BITS;
+    if (leaf_index >= NUM_LEAVES) {
+        LOG_WARNING(HW_Memory, "Host page {} is out of the tracked range", fmt::ptr(host_page));
+        return false;
+    }
+
+    std::lock_guard lock{mutex};
+
+    const auto [it, inserted] = tracked_pages.emplace(vaddr, host_page);
+    if (!inserted) {
+        return it->second == host_page;
+    }
+    if (track_counts[host_page]++ != 0) {
+        return true;
+    }
+
+    Leaf* leaf = leaves[leaf_index].load();
+    if (leaf == nullptr) {
+        leaf = allocated_leaves.emplace(leaf_index, std::make_unique<Leaf>()).first->second.get();
+        leaves[leaf_index].store(leaf);
+    }
+
+    // Publish the page before protecting it, so that the fault handler finds it.
+    const std::size_t index = page_number % LEAF_PAGES;
+    const u64 previous = leaf->tracked[index / 64].fetch_or(PageBit(index));
+    ASSERT((previous & PageBit(index)) == 0);
+    if ((leaf->dirty[index / 64].load() & PageBit(index)) == 0) {
+        // Dirty pages are protected again once consumed.
+        Common::ProtectHostMemory(host_page, PAGE_SIZE, true, false);
+    }
+    return true;
+}
+
+u8* WriteTracker::Untrack(VAddr vaddr) {
+    std::lock_guard lock{mutex};
+
+    const auto it = tracked_pages.find(vaddr);
+    if (it == tracked_pages.end()) {
+        return nullptr;
+    }
+    u8* const host_page = it->second;
+    UntrackLocked(it);
+    return host_page;
+}
+
+std::vector<std::pair<VAddr, u8*>> WriteTracker::UntrackRange(VAddr vaddr, u64 size) {
+    std::vector<std::pair<VAddr, u8*>> pages;
+    std::lock_guard lock{mutex};
+
+    auto it = tracked_pages.lower_bound(vaddr);
+    while (it != tracked_pages.end() && it->first - vaddr < size) {
+        pages.push_back(*it);
+        UntrackLocked(it++);
+    }
+    return pages;
+}
+
+bool WriteTracker::IsTracked(const u8* host_pointer, std::size_t size) const {
+    if (size == 0) {
+        return true;
+    }
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(host_pointer) >> PAGE_BITS;
+    const std::uintptr_t last =
+        (reinterpret_cast<std::uintptr_t>(host_pointer) + size - 1) >> PAGE_BITS;
+    for (std::uintptr_t page_number = first; page_number <= last; ++page_number) {
+        const Leaf* const leaf = FindLeaf(page_number);
+        const std::size_t index = page_number % LEAF_PAGES;
+        if (leaf == nullptr || (leaf->tracked[index / 64].load() & PageBit(index)) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WriteTracker::ConsumeDirtyPages(
+    const std::function<void(u8* host_pointer, std::size_t size)>& func) {
+    if (!has_dirty_pages.exchange(false)) {
+        return;
+    }
+
+    std::vector<u8*> pages;
+    {
+        std::lock_guard lock{mutex};
+        for (const auto& [leaf_index, leaf] : allocated_leaves) {
+            for (std::size_t i = 0; i < leaf->dirty_words.size(); ++i) {
+                for (u64 words = leaf->dirty_words[i].exchange(0); words != 0;
+                     words &= words - 1) {
+                    const std::size_t word = i * 64 + Common::CountTrailingZeroes64(words);
+                    for (u64 bits = leaf->dirty[word].exchange(0); bits != 0; bits &= bits - 1) {
+                        const std::size_t index = word * 64 + Common::CountTrailingZeroes64(bits);
+                        const std::uintptr_t page_number = (leaf_index << LEAF_BITS) + index;
+                        u8* const host_page = reinterpret_cast<u8*>(page_number << PAGE_BITS);
+                        if ((leaf->tracked[word].load() & PageBit(index)) != 0) {
+                            Common::ProtectHostMemory(host_page, PAGE_SIZE, true, false);
+                        }
+                        pages.push_back(host_page);
+                    }
+                }
+            }
+        }
+    }
+
+    // Leaves are visited in address order, so the pages are already sorted.
+    std::size_t run_begin = 0;
+    for (std::size_t i = 1; i <= pages.size(); ++i) {
+        if (i != pages.size() && pages[i] == pages[i - 1] + PAGE_SIZE) {
+            continue;
+        }
+        func(pages[run_begin], (i - run_begin) * PAGE_SIZE);
+        run_begin = i;
+    }
+}
+
+void WriteTracker::Clear() {
+    std::lock_guard lock{mutex};
+
+    for (const auto& [host_page, count] : track_counts) {
+        Common::ProtectHostMemory(host_page, PAGE_SIZE, true, true);
+    }
+    tracked_pages.clear();
+    track_counts.clear();
+
+    for (const auto& [leaf_index, leaf] : allocated_leaves) {
+        for (std::size_t i = 0; i < LEAF_WORDS; ++i) {
+            leaf->tracked[i].store(0);
+            leaf->dirty[i].store(0);
+        }
+        for (auto& words : leaf->dirty_words) {
+            words.store(0);
+        }
+    }
+    has_dirty_pages.store(false);
+}
+
+void WriteTracker::UntrackLocked(std::map<VAddr, u8*>::iterator it) {
+    u8* const host_page = it->second;
+    tracked_pages.erase(it);
+
+    const auto count_it = track_counts.find(host_page);
+    ASSERT(count_it != track_counts.end());
+    if (--count_it->second != 0) {
+        return;
+    }
+    track_counts.erase(count_it);
+
+    // Lift the protection before dropping the page, a write faulting in between is retried.
+    const std::uintptr_t page_number = reinterpret_cast<std::uintptr_t>(host_page) >> PAGE_BITS;
+    Leaf* const leaf = FindLeaf(page_number);
+    const std::size_t index = page_number % LEAF_PAGES;
+    Common::ProtectHostMemory(host_page, PAGE_SIZE, true, true);
+    leaf->tracked[index / 64].fetch_and(~PageBit(index));
+}
+
+WriteTracker::Leaf* WriteTracker::FindLeaf(std::uintptr_t page_number) const {
+    const std::size_t leaf_index = page_number >> LEAF_BITS;
+    return leaf_index < NUM_LEAVES ? leaves[leaf_index].load() : nullptr;
+}
+
+bool WriteTracker::HandleFault(u8* address) {
+    // Runs in the signal handler of the faulting thread. Only touches the bitmaps, which are
+    // preallocated and lock-free.
+    const std::uintptr_t page_number = reinterpret_cast<std::uintptr_t>(address) >> PAGE_BITS;
+    Leaf* const leaf = FindLeaf(page_number);
+    if (leaf == nullptr) {
+        return false;
+    }
+    const std::size_t index = page_number % LEAF_PAGES;
+    const std::size_t word = index / 64;
+    u8* const host_page = reinterpret_cast<u8*>(page_number << PAGE_BITS);
+
+    // Last page retried on this thread after it was found untracked.
+    thread_local u8* retried_page = nullptr;
+    if ((leaf->tracked[word].load() & PageBit(index)) == 0) {
+        // The page may have been untracked after the write faulted, in which case its protection
+        // is lifted already. Retry the write once, a second fault on it is not ours.
+        if (retried_page == host_page) {
+            retried_page = nullptr;
+            return false;
+        }
+        retried_page = host_page;
+        return true;
+    }
+    retried_page = nullptr;
+
+    // The dirty bit goes first, the consumer checks the summary words before the bitmap.
+    leaf->dirty[word].fetch_or(PageBit(index));
+    leaf->dirty_words[word / 64].fetch_or(PageBit(word));
+    has_dirty_pages.store(true);
+    return Common::ProtectHostMemory(host_page, PAGE_SIZE, true, true);
+}
+
+} // namespace Memory
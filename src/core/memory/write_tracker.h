@@ -0,0 +1,140 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "common/common_types.h"
+#include "core/memory.h"
+
+namespace Memory {
+
+/**
+ * Tracks CPU writes to host pages backing rasterizer cached memory by write-protecting them.
+ *
+ * The first write to a tracked page faults, which marks the page as dirty and lifts the
+ * protection. Dirty pages are handed out in batches, after which the ones that are still tracked
+ * get protected again.
+ *
+ * Tracking is keyed by guest page, as that is how the rasterizer marks memory as cached, while
+ * protection and dirtiness are per host page, since guest pages may alias the same host memory.
+ *
+ * Faults are resolved from the signal handler of the faulting thread, so the state they touch is
+ * kept in preallocated bitmaps of host pages which are only accessed through lock-free atomics.
+ */
+class WriteTracker {
+public:
+    WriteTracker();
+    ~WriteTracker();
+
+    WriteTracker(const WriteTracker&) = delete;
+    WriteTracker& operator=(const WriteTracker&) = delete;
+
+    WriteTracker(WriteTracker&&) = delete;
+    WriteTracker& operator=(WriteTracker&&) = delete;
+
+    /// Returns whether write tracking through page protection is usable on this host.
+    static bool IsSupported();
+
+    /**
+     * Starts tracking writes to a guest page.
+     *
+     * @param vaddr     The page-aligned guest address of the page.
+     * @param host_page The host memory backing the guest page.
+     *
+     * @returns false if the host page is out of the range the tracker covers, in which case writes
+     *          to it are not tracked.
+     */
+    bool Track(VAddr vaddr, u8* host_page);
+
+    /**
+     * Stops tracking writes to a guest page.
+     *
+     * @param vaddr The page-aligned guest address of the page.
+     *
+     * @returns The host page that was tracked for the guest page, or nullptr if it was not tracked.
+     */
+    u8* Untrack(VAddr vaddr);
+
+    /**
+     * Stops tracking writes to every guest page of a range.
+     *
+     * @param vaddr The page-aligned guest address of the range.
+     * @param size  The size of the range in bytes.
+     *
+     * @returns The guest pages of the range that were tracked and their host pages, in address
+     *          order.
+     */
+    std::vector<std::pair<VAddr, u8*>> UntrackRange(VAddr vaddr, u64 size);
+
+    /// Returns whether writes to every host page overlapping the given range are tracked.
+    bool IsTracked(const u8* host_pointer, std::size_t size) const;
+
+    /**
+     * Hands out every page written since the last call, coalesced into host-contiguous runs,
+     * and protects the pages that are still tracked again.
+     *
+     * @param func Function called with the start and size of each dirty run. It is called without
+     *             any lock held, so it may untrack pages.
+     */
+    void ConsumeDirtyPages(const std::function<void(u8* host_pointer, std::size_t size)>& func);
+
+    /// Stops tracking every page, lifting all protections.
+    void Clear();
+
+private:
+    /// Number of bits of the host addresses covered by the tracker.
+    static constexpr std::size_t HOST_ADDRESS_BITS = 48;
+    /// Number of bits of the host page numbers covered by each leaf of the page bitmaps.
+    static constexpr std::size_t LEAF_BITS = 18;
+    static constexpr std::size_t LEAF_PAGES = std::size_t{1} << LEAF_BITS;
+    static constexpr std::size_t LEAF_WORDS = LEAF_PAGES / 64;
+    static constexpr std::size_t NUM_LEAVES = std::size_t{1}
+                                              << (HOST_ADDRESS_BITS - PAGE_BITS - LEAF_BITS);
+
+    /// Page bitmaps covering a naturally aligned range of LEAF_PAGES host pages.
+    struct Leaf {
+        /// Pages that are currently tracked.
+        std::array<std::atomic<u64>, LEAF_WORDS> tracked{};
+        /// Pages written since the last consumption.
+        std::array<std::atomic<u64>, LEAF_WORDS> dirty{};
+        /// Words of the dirty bitmap that may have bits set.
+        std::array<std::atomic<u64>, LEAF_WORDS / 64> dirty_words{};
+    };
+
+    /// Returns the leaf covering a host page number, or nullptr if it was never allocated.
+    Leaf* FindLeaf(std::uintptr_t page_number) const;
+
+    bool HandleFault(u8* address);
+
+    /// Stops tracking a guest page, with the mutex held.
+    void UntrackLocked(std::map<VAddr, u8*>::iterator it);
+
+    std::mutex mutex;
+    /// Host page tracked for each guest page, ordered so that ranges can be untracked at once.
+    std::map<VAddr, u8*> tracked_pages;
+    /// Number of guest pages tracking each host page.
+    std::unordered_map<u8*, u32> track_counts;
+
+    /// Root of the page bitmaps, leaves are allocated on demand and kept until destruction.
+    std::unique_ptr<std::atomic<Leaf*>[]> leaves;
+    /// Owner of the allocated leaves, by index.
+    std::map<std::size_t, std::unique_ptr<Leaf>> allocated_leaves;
+    /// Set by the fault handler whenever a page becomes dirty.
+    std::atomic<bool> has_dirty_pages{false};
+
+    int fault_handler_id = -1;
+};
+
+} // namespace Memory
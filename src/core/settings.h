@@ -412,6 +412,9 @@ struct Values {
 
     // Core
     bool use_multi_core;
+    bool use_async_services;
+    bool use_huge_pages;
+    bool use_host_timing;
 
     // Data Storage
     bool use_virtual_sd;
@@ -435,6 +438,7 @@ struct Values {
     u16 frame_limit;
     bool use_disk_shader_cache;
     bool use_accurate_gpu_emulation;
+    bool use_write_tracking;
     bool use_asynchronous_gpu_emulation;
     bool use_vsync;
     bool force_30fps_mode;
@@ -461,6 +465,8 @@ struct Values {
     bool dump_exefs;
     bool dump_nso;
     bool reporting_services;
+    bool record_service_stats;
+    bool record_svc_stats;
     bool quest_flag;
 
     // BCAT
@@ -0,0 +1,88 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include "common/arena.h"
+#include "common/common_types.h"
+
+namespace Common {
+
+TEST_CASE("Arena: Allocations are aligned and distinct", "[common]") {
+    Arena arena{64};
+
+    void* const a = arena.Allocate(3, 1);
+    void* const b = arena.Allocate(8, 8);
+    void* const c = arena.Allocate(16, 16);
+    REQUIRE(a != b);
+    REQUIRE(b != c);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 8 == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(c) % 16 == 0);
+    REQUIRE(arena.LiveAllocations() == 3);
+
+    arena.Deallocate(a, 3);
+    arena.Deallocate(b, 8);
+    arena.Deallocate(c, 16);
+    REQUIRE(arena.LiveAllocations() == 0);
+}
+
+TEST_CASE("Arena: Reset waits for every allocation to be released", "[common]") {
+    Arena arena{64};
+
+    void* const first = arena.Allocate(16, 8);
+    REQUIRE(!arena.Reset());
+    arena.Deallocate(first, 16);
+    REQUIRE(arena.Reset());
+
+    // Memory is reused after a reset.
+    void* const second = arena.Allocate(16, 8);
+    REQUIRE(second == first);
+    arena.Deallocate(second, 16);
+}
+
+TEST_CASE("Arena: Overflowing rounds are merged into a single block", "[common]") {
+    Arena arena{64};
+
+    std::array<void*, 8> pointers{};
+    for (auto& pointer : pointers) {
+        pointer = arena.Allocate(32, 8);
+    }
+    const std::size_t capacity = arena.Capacity();
+    REQUIRE(capacity >= 8 * 32);
+    for (void* pointer : pointers) {
+        arena.Deallocate(pointer, 32);
+    }
+    REQUIRE(arena.Reset());
+    REQUIRE(arena.Capacity() == capacity);
+
+    // The same round now fits in the merged block, contiguously.
+    u8* const base = static_cast<u8*>(arena.Allocate(32, 8));
+    for (std::size_t i = 1; i < pointers.size(); ++i) {
+        REQUIRE(arena.Allocate(32, 8) == base + i * 32);
+    }
+    REQUIRE(arena.Capacity() == capacity);
+    for (std::size_t i = 0; i < pointers.size(); ++i) {
+        arena.Deallocate(base + i * 32, 32);
+    }
+}
+
+TEST_CASE("ArenaAllocator: Copies are heap backed", "[common]") {
+    Arena arena;
+    {
+        ArenaVector<u32> vector{ArenaAllocator<u32>{&arena}};
+        vector.assign({1, 2, 3, 4});
+        REQUIRE(arena.LiveAllocations() == 1);
+
+        const ArenaVector<u32> copy{vector};
+        REQUIRE(copy.get_allocator().GetArena() == nullptr);
+        REQUIRE(copy == vector);
+        REQUIRE(arena.LiveAllocations() == 1);
+    }
+    REQUIRE(arena.LiveAllocations() == 0);
+    REQUIRE(arena.Reset());
+}
+
+} // namespace Common
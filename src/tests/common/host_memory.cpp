@@ -0,0 +1,75 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+#include "common/common_types.h"
+#include "common/host_memory.h"
+
+namespace Common {
+
+namespace {
+
+u64 GetLargeAllocatedBytes() {
+    const auto stats = GetHugePageStats();
+    return stats.reserved_bytes + stats.transparent_bytes + stats.advised_bytes +
+           stats.regular_bytes;
+}
+
+bool IsZeroFilled(const u8* pointer, std::size_t size) {
+    return std::all_of(pointer, pointer + size, [](u8 value) { return value == 0; });
+}
+
+} // Anonymous namespace
+
+TEST_CASE("HostMemory: Large allocations are aligned to huge pages", "[common]") {
+    constexpr std::size_t size = 3 * HUGE_PAGE_SIZE + 0x1000;
+    SetHugePagesEnabled(true);
+    const u64 bytes_before = GetLargeAllocatedBytes();
+
+    auto* const pointer = static_cast<u8*>(AllocateHostMemory(size));
+    REQUIRE(reinterpret_cast<std::uintptr_t>(pointer) % HUGE_PAGE_SIZE == 0);
+    REQUIRE(IsZeroFilled(pointer, size));
+    pointer[size - 1] = 0xFF;
+
+    // Whatever backs it, the whole allocation is accounted for.
+    REQUIRE(GetLargeAllocatedBytes() - bytes_before == 4 * HUGE_PAGE_SIZE);
+
+    FreeHostMemory(pointer, size);
+    REQUIRE(GetLargeAllocatedBytes() == bytes_before);
+    SetHugePagesEnabled(false);
+}
+
+TEST_CASE("HostMemory: Disabled huge pages leave allocations on regular pages", "[common]") {
+    constexpr std::size_t size = 2 * HUGE_PAGE_SIZE + 0x1000;
+    SetHugePagesEnabled(false);
+    const auto stats_before = GetHugePageStats();
+
+    auto* const pointer = static_cast<u8*>(AllocateHostMemory(size));
+    REQUIRE(IsZeroFilled(pointer, size));
+    const auto stats = GetHugePageStats();
+    REQUIRE(stats.regular_bytes - stats_before.regular_bytes == size);
+    REQUIRE(stats.HugePageCount() == stats_before.HugePageCount());
+
+    FreeHostMemory(pointer, size);
+    REQUIRE(GetHugePageStats().regular_bytes == stats_before.regular_bytes);
+}
+
+TEST_CASE("HostMemory: Small allocations are not tracked", "[common]") {
+    constexpr std::size_t size = HUGE_PAGE_SIZE - 0x1000;
+    SetHugePagesEnabled(true);
+    const u64 bytes_before = GetLargeAllocatedBytes();
+
+    auto* const pointer = static_cast<u8*>(AllocateHostMemory(size));
+    REQUIRE(IsZeroFilled(pointer, size));
+    REQUIRE(GetLargeAllocatedBytes() == bytes_before);
+
+    FreeHostMemory(pointer, size);
+    SetHugePagesEnabled(false);
+}
+
+} // namespace Common
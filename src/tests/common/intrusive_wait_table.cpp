@@ -0,0 +1,195 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/intrusive_wait_table.h"
+
+namespace Common {
+
+namespace {
+
+struct Waiter {
+    u64 key = 0;
+    u32 priority = 0;
+    WaitTableLink<Waiter> link{};
+};
+
+struct WaiterTraits {
+    static WaitTableLink<Waiter>& GetLink(Waiter& waiter) {
+        return waiter.link;
+    }
+    static u64 GetKey(const Waiter& waiter) {
+        return waiter.key;
+    }
+    static u32 GetPriority(const Waiter& waiter) {
+        return waiter.priority;
+    }
+    static constexpr auto TIE_BREAK = WaitTableTieBreak::LastInFirstOut;
+};
+
+struct FifoWaiterTraits : WaiterTraits {
+    static constexpr auto TIE_BREAK = WaitTableTieBreak::FirstInFirstOut;
+};
+
+// Few buckets, so that keys share them.
+using WaitTable = IntrusiveWaitTable<Waiter, 4, WaiterTraits>;
+using FifoWaitTable = IntrusiveWaitTable<Waiter, 4, FifoWaiterTraits>;
+
+template <typename Table>
+std::vector<Waiter*> WakeAll(Table& table, u64 key) {
+    std::vector<Waiter*> woken;
+    table.wake(key, std::numeric_limits<std::size_t>::max(),
+               [&woken](Waiter* waiter) { woken.push_back(waiter); });
+    return woken;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("IntrusiveWaitTable: Waiters are woken by priority", "[common]") {
+    std::array<Waiter, 5> waiters{
+        {{0x1000, 30}, {0x1000, 10}, {0x2000, 0}, {0x1000, 30}, {0x1000, 20}}};
+    WaitTable table;
+    for (auto& waiter : waiters) {
+        table.insert(&waiter);
+    }
+
+    REQUIRE(table.count(0x1000, 16) == 4);
+    REQUIRE(table.count(0x1000, 2) == 2);
+    REQUIRE(table.count(0x3000, 16) == 0);
+    REQUIRE(table.front(0x2000) == &waiters[2]);
+
+    // Waiters of equal priority are woken last in, first out.
+    REQUIRE(WakeAll(table, 0x1000) ==
+            std::vector<Waiter*>{&waiters[1], &waiters[4], &waiters[3], &waiters[0]});
+    REQUIRE(table.front(0x1000) == nullptr);
+    REQUIRE(table.contains(&waiters[2]));
+    REQUIRE(!table.contains(&waiters[0]));
+}
+
+TEST_CASE("IntrusiveWaitTable: First in, first out among equal priorities", "[common]") {
+    std::array<Waiter, 6> waiters{{{0x1000, 30},
+                                   {0x1000, 10},
+                                   {0x2000, 30},
+                                   {0x1000, 30},
+                                   {0x1000, 10},
+                                   {0x1000, 30}}};
+    FifoWaitTable table;
+    for (auto& waiter : waiters) {
+        table.insert(&waiter);
+    }
+
+    // Waiters of equal priority are woken in the order they were queued.
+    REQUIRE(WakeAll(table, 0x1000) == std::vector<Waiter*>{&waiters[1], &waiters[4], &waiters[0],
+                                                           &waiters[3], &waiters[5]});
+
+    // Removing a waiter keeps the order of the others.
+    for (auto& waiter : waiters) {
+        if (!table.contains(&waiter)) {
+            table.insert(&waiter);
+        }
+    }
+    table.remove(&waiters[3]);
+    REQUIRE(table.front(0x1000) == &waiters[1]);
+    std::vector<Waiter*> woken;
+    table.wake(0x1000, 3, [&woken](Waiter* waiter) { woken.push_back(waiter); });
+    REQUIRE(woken == std::vector<Waiter*>{&waiters[1], &waiters[4], &waiters[0]});
+    REQUIRE(WakeAll(table, 0x1000) == std::vector<Waiter*>{&waiters[5]});
+    REQUIRE(WakeAll(table, 0x2000) == std::vector<Waiter*>{&waiters[2]});
+}
+
+TEST_CASE("IntrusiveWaitTable: Wakeups are limited by count", "[common]") {
+    std::array<Waiter, 3> waiters{{{0x1000, 1}, {0x1000, 2}, {0x1000, 3}}};
+    WaitTable table;
+    for (auto& waiter : waiters) {
+        table.insert(&waiter);
+    }
+
+    std::vector<Waiter*> woken;
+    REQUIRE(table.wake(0x1000, 2, [&woken](Waiter* waiter) { woken.push_back(waiter); }) == 2);
+    REQUIRE(woken == std::vector<Waiter*>{&waiters[0], &waiters[1]});
+    REQUIRE(table.front(0x1000) == &waiters[2]);
+
+    table.remove(&waiters[2]);
+    REQUIRE(table.front(0x1000) == nullptr);
+    REQUIRE(table.wake(0x1000, 2, [](Waiter*) {}) == 0);
+}
+
+TEST_CASE("IntrusiveWaitTable: Stress with hundreds of waiters", "[common]") {
+    constexpr std::size_t num_waiters = 512;
+    constexpr u64 num_keys = 16;
+
+    std::mt19937 rng{12345};
+    std::vector<Waiter> waiters(num_waiters);
+    WaitTable table;
+    // Reference model, keeping each key's waiters in wakeup order.
+    std::map<u64, std::vector<Waiter*>> expected;
+
+    const auto insert = [&](Waiter& waiter) {
+        waiter.key = 0x80000000 + (rng() % num_keys) * 4;
+        waiter.priority = rng() % 64;
+        table.insert(&waiter);
+        auto& queue = expected[waiter.key];
+        queue.insert(std::find_if(queue.begin(), queue.end(),
+                                  [&waiter](const Waiter* other) {
+                                      return other->priority >= waiter.priority;
+                                  }),
+                     &waiter);
+    };
+
+    for (auto& waiter : waiters) {
+        insert(waiter);
+    }
+
+    for (int round = 0; round < 64; ++round) {
+        // Some waiters time out.
+        for (int i = 0; i < 8; ++i) {
+            Waiter& waiter = waiters[rng() % num_waiters];
+            if (!table.contains(&waiter)) {
+                continue;
+            }
+            auto& queue = expected[waiter.key];
+            queue.erase(std::find(queue.begin(), queue.end(), &waiter));
+            table.remove(&waiter);
+        }
+
+        // Others are signaled.
+        const u64 key = 0x80000000 + (rng() % num_keys) * 4;
+        const std::size_t max_count = rng() % 8;
+        auto& queue = expected[key];
+        REQUIRE(table.count(key, num_waiters) == queue.size());
+
+        std::vector<Waiter*> woken;
+        table.wake(key, max_count, [&](Waiter* waiter) {
+            REQUIRE(!table.contains(waiter));
+            woken.push_back(waiter);
+        });
+        const std::size_t num_woken = std::min(max_count, queue.size());
+        REQUIRE(woken == std::vector<Waiter*>(queue.begin(), queue.begin() + num_woken));
+        queue.erase(queue.begin(), queue.begin() + num_woken);
+
+        // And wait again.
+        for (Waiter* waiter : woken) {
+            insert(*waiter);
+        }
+    }
+
+    for (auto& [key, queue] : expected) {
+        REQUIRE(WakeAll(table, key) == queue);
+    }
+    for (const auto& waiter : waiters) {
+        REQUIRE(!table.contains(&waiter));
+    }
+}
+
+} // namespace Common
@@ -0,0 +1,102 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "common/latency_histogram.h"
+
+namespace Common {
+
+using namespace std::chrono_literals;
+
+TEST_CASE("LatencyHistogram: Latencies are bucketed by power of two", "[common]") {
+    LatencyHistogram<std::chrono::nanoseconds, 32> histogram;
+    histogram.Record(1ns);
+    histogram.Record(3ns);
+    histogram.Record(1000ns);
+    histogram.Record(10s);
+
+    const auto snapshot = histogram.GetSnapshot();
+    REQUIRE(snapshot.calls == 4);
+    REQUIRE(snapshot.total_time == 10'000'001'004ns);
+    REQUIRE(snapshot.buckets[0] == 1);
+    REQUIRE(snapshot.buckets[1] == 1);
+    REQUIRE(snapshot.buckets[9] == 1);
+    REQUIRE(snapshot.buckets[31] == 1);
+}
+
+TEST_CASE("LatencyHistogram: Buckets are counted in the given unit", "[common]") {
+    LatencyHistogram<std::chrono::microseconds, 24> histogram;
+    histogram.Record(500ns);
+    histogram.Record(3us);
+    histogram.Record(1000us);
+    histogram.Record(1h);
+
+    const auto snapshot = histogram.GetSnapshot();
+    REQUIRE(snapshot.calls == 4);
+    REQUIRE(snapshot.buckets[0] == 1);
+    REQUIRE(snapshot.buckets[1] == 1);
+    REQUIRE(snapshot.buckets[9] == 1);
+    REQUIRE(snapshot.buckets[23] == 1);
+    REQUIRE(decltype(histogram)::BucketBound(9) == 1024us);
+}
+
+TEST_CASE("LatencyHistogram: The median is reported as a bucket bound", "[common]") {
+    LatencyHistogram<std::chrono::nanoseconds, 32> histogram;
+    REQUIRE(histogram.GetSnapshot().Median() == 2ns);
+
+    for (int i = 0; i < 3; ++i) {
+        histogram.Record(100ns);
+    }
+    histogram.Record(1ms);
+    histogram.Record(1ms);
+    REQUIRE(histogram.GetSnapshot().Median() == 128ns);
+
+    histogram.Reset();
+    const auto snapshot = histogram.GetSnapshot();
+    REQUIRE(snapshot.calls == 0);
+    REQUIRE(snapshot.total_time == 0ns);
+    REQUIRE(snapshot.Median() == 2ns);
+}
+
+TEST_CASE("LatencyHistogram: Snapshots are summarized by total time", "[common]") {
+    using Histogram = LatencyHistogram<std::chrono::microseconds, 24>;
+    struct Entry {
+        std::string name;
+        Histogram::Snapshot latency;
+    };
+
+    Histogram idle;
+    Histogram cheap;
+    Histogram expensive;
+    cheap.Record(3us);
+    expensive.Record(100us);
+    expensive.Record(100us);
+
+    std::vector<Entry> entries{
+        {"cheap", cheap.GetSnapshot()},
+        {"idle", idle.GetSnapshot()},
+        {"expensive", expensive.GetSnapshot()},
+    };
+    SortLatencySnapshots(entries);
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[0].name == "expensive");
+    REQUIRE(entries[1].name == "cheap");
+
+    const auto lines = SummarizeLatencySnapshots(entries, 1, "entries",
+                                                 [](const Entry& entry) { return entry.name; });
+    REQUIRE(lines == std::vector<std::string>{
+                         "Top 1 of 2 entries by total time:",
+                         "  expensive: 2 calls, 200 us total, median < 128 us",
+                     });
+    REQUIRE(SummarizeLatencySnapshots(std::vector<Entry>{}, 1, "entries",
+                                      [](const Entry& entry) { return entry.name; })
+                .empty());
+}
+
+} // namespace Common
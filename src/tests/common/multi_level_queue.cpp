@@ -3,8 +3,13 @@
 // Refer to the license.txt file included.
 
 #include <catch2/catch.hpp>
+#include <array>
+#include <chrono>
 #include <math.h>
+#include <random>
+#include <vector>
 #include "common/common_types.h"
+#include "common/intrusive_multi_level_queue.h"
 #include "common/multi_level_queue.h"
 
 namespace Common {
@@ -52,4 +57,164 @@ TEST_CASE("MultiLevelQueue", "[common]") {
     REQUIRE(mlq.empty(1));
 }
 
+namespace {
+
+struct Node {
+    f32 value;
+    std::array<MultiLevelQueueLink<Node>, 2> links{};
+};
+
+struct NodeLinks {
+    MultiLevelQueueLink<Node>& operator()(Node& node, std::size_t queue_index) const {
+        return node.links[queue_index];
+    }
+};
+
+using IntrusiveQueue = IntrusiveMultiLevelQueue<Node, 64, NodeLinks>;
+
+} // Anonymous namespace
+
+TEST_CASE("IntrusiveMultiLevelQueue", "[common]") {
+    std::array<Node, 8> nodes{{{0.0}, {5.0}, {1.0}, {9.0}, {8.0}, {2.0}, {6.0}, {7.0}}};
+    IntrusiveQueue mlq;
+    REQUIRE(mlq.empty());
+    mlq.add(&nodes[2], 2);
+    mlq.add(&nodes[7], 7);
+    mlq.add(&nodes[3], 3);
+    mlq.add(&nodes[4], 4);
+    mlq.add(&nodes[0], 0);
+    mlq.add(&nodes[5], 5);
+    mlq.add(&nodes[6], 6);
+    mlq.add(&nodes[1], 1);
+    u32 index = 0;
+    bool all_set = true;
+    for (Node* node : mlq) {
+        all_set &= (node == &nodes[index]);
+        index++;
+    }
+    REQUIRE(all_set);
+    REQUIRE(index == nodes.size());
+    REQUIRE(mlq.size() == nodes.size());
+
+    Node back{8.0};
+    Node front{-7.0};
+    mlq.add(&back, 2);
+    mlq.add(&front, 2, false);
+    REQUIRE(mlq.front(2) == &front);
+    mlq.yield(2);
+    REQUIRE(mlq.front(2) == &nodes[2]);
+    REQUIRE(mlq.back(2) == &front);
+    REQUIRE(mlq.size(2) == 3);
+
+    // Removal from the middle of a level only touches the neighbours.
+    mlq.remove(&back, 2);
+    REQUIRE(!mlq.contains(&back));
+    REQUIRE(mlq.front(2) == &nodes[2]);
+    REQUIRE(mlq.back(2) == &front);
+
+    REQUIRE(mlq.empty(8));
+    Node adjusted{10.0};
+    mlq.add(&adjusted, 8);
+    mlq.adjust(&adjusted, 8, 9);
+    REQUIRE(mlq.front(9) == &adjusted);
+    REQUIRE(mlq.empty(8));
+    REQUIRE(!mlq.empty(9));
+    mlq.adjust(&nodes[0], 0, 9);
+    REQUIRE(mlq.highest_priority_set() == 1);
+    REQUIRE(mlq.lowest_priority_set() == 9);
+    mlq.remove(&nodes[1], 1);
+    REQUIRE(mlq.highest_priority_set() == 2);
+    REQUIRE(mlq.empty(1));
+
+    // Iteration can be restricted to a range of priorities.
+    std::vector<Node*> level_nine;
+    for (auto it = mlq.begin(9); it != mlq.end(9); ++it) {
+        level_nine.push_back(*it);
+    }
+    REQUIRE(level_nine == std::vector<Node*>{&adjusted, &nodes[0]});
+
+    // Adding a node that is already in the queue moves it.
+    mlq.add(&adjusted, 9);
+    REQUIRE(mlq.size(9) == 2);
+    REQUIRE(mlq.front(9) == &nodes[0]);
+    REQUIRE(mlq.back(9) == &adjusted);
+    mlq.add(&adjusted, 3, false);
+    REQUIRE(mlq.size(9) == 1);
+    REQUIRE(mlq.front(3) == &adjusted);
+    mlq.remove(&adjusted, 3);
+    REQUIRE(!mlq.contains(&adjusted));
+
+    // The same node can be in a second queue through its other link.
+    IntrusiveQueue other{1};
+    other.add(&nodes[2], 30);
+    REQUIRE(other.front() == &nodes[2]);
+    REQUIRE(mlq.front(2) == &nodes[2]);
+
+    mlq.clear();
+    REQUIRE(mlq.empty());
+    REQUIRE(!mlq.contains(&nodes[2]));
+    REQUIRE(other.contains(&nodes[2]));
+}
+
+namespace {
+
+/// Replays a scheduler-like workload: threads become runnable, yield, change priority and stop.
+template <typename AddFunc, typename RemoveFunc, typename YieldFunc>
+void RunQueueWorkload(std::size_t num_ops, AddFunc&& add, RemoveFunc&& remove, YieldFunc&& yield) {
+    constexpr std::size_t num_nodes = 64;
+    std::mt19937 rng{1234};
+    std::array<u32, num_nodes> priorities{};
+    std::array<bool, num_nodes> queued{};
+
+    for (std::size_t op = 0; op < num_ops; ++op) {
+        const std::size_t node = rng() % num_nodes;
+        if (!queued[node]) {
+            priorities[node] = rng() % 64;
+            add(node, priorities[node]);
+            queued[node] = true;
+        } else if (rng() % 4 != 0) {
+            yield(priorities[node]);
+        } else {
+            remove(node, priorities[node]);
+            queued[node] = false;
+        }
+    }
+}
+
+} // Anonymous namespace
+
+// Hidden by default, run with: tests "[benchmark]"
+TEST_CASE("MultiLevelQueue[Throughput]", "[.][benchmark]") {
+    constexpr std::size_t num_ops = 4000000;
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<Node> nodes(64);
+    std::vector<Node*> pointers;
+    for (auto& node : nodes) {
+        pointers.push_back(&node);
+    }
+
+    MultiLevelQueue<Node*, 64> list_queue;
+    auto start = Clock::now();
+    RunQueueWorkload(
+        num_ops, [&](std::size_t node, u32 priority) { list_queue.add(pointers[node], priority); },
+        [&](std::size_t node, u32 priority) { list_queue.remove(pointers[node], priority); },
+        [&](u32 priority) { list_queue.yield(priority); });
+    const std::chrono::duration<double> list_seconds = Clock::now() - start;
+
+    IntrusiveQueue intrusive_queue;
+    start = Clock::now();
+    RunQueueWorkload(
+        num_ops,
+        [&](std::size_t node, u32 priority) { intrusive_queue.add(pointers[node], priority); },
+        [&](std::size_t node, u32 priority) { intrusive_queue.remove(pointers[node], priority); },
+        [&](u32 priority) { intrusive_queue.yield(priority); });
+    const std::chrono::duration<double> intrusive_seconds = Clock::now() - start;
+
+    REQUIRE(list_queue.size() == intrusive_queue.size());
+    WARN("Ran " << num_ops << " queue operations in " << list_seconds.count()
+                << " s with std::list levels, " << intrusive_seconds.count()
+                << " s with intrusive levels");
+}
+
 } // namespace Common
@@ -0,0 +1,44 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/spin_lock.h"
+
+namespace Common {
+
+TEST_CASE("SpinLock: TryLock", "[common]") {
+    SpinLock lock;
+    REQUIRE(lock.try_lock());
+    REQUIRE(!lock.try_lock());
+    lock.unlock();
+    REQUIRE(lock.try_lock());
+    lock.unlock();
+}
+
+TEST_CASE("SpinLock: Mutual exclusion", "[common]") {
+    constexpr std::size_t num_threads = 4;
+    constexpr std::size_t increments_per_thread = 100000;
+
+    SpinLock lock;
+    std::size_t counter = 0;
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&] {
+            for (std::size_t j = 0; j < increments_per_thread; ++j) {
+                std::lock_guard guard{lock};
+                ++counter;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(counter == num_threads * increments_per_thread);
+}
+
+} // namespace Common
@@ -0,0 +1,105 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/arm/arm_interface.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/physical_core.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+
+#ifdef ARCHITECTURE_x86_64
+
+namespace {
+
+constexpr std::size_t NUM_CORES = 4;
+constexpr VAddr CODE_ADDRESS = 0x1000'0000;
+constexpr VAddr COUNTER_ADDRESS = CODE_ADDRESS + Memory::PAGE_SIZE;
+
+// Increments the counter at x0 with exclusive accesses, x1 times, then spins.
+constexpr std::array<u32, 7> INCREMENT_LOOP{
+    0xC85FFC02, // loop: ldaxr x2, [x0]
+    0x91000442, //       add   x2, x2, #1
+    0xC803FC02, //       stlxr w3, x2, [x0]
+    0x35FFFFA3, //       cbnz  w3, loop
+    0xF1000421, //       subs  x1, x1, #1
+    0x54FFFF61, //       b.ne  loop
+    0x14000000, //       b     .
+};
+
+} // Anonymous namespace
+
+TEST_CASE("Multicore[SharedMemory]", "[core]") {
+    constexpr u64 increments_per_core = 100000;
+
+    auto& system = Core::System::GetInstance();
+    auto& core_timing = system.CoreTiming();
+    auto& kernel = system.Kernel();
+
+    // The JITs must not account ticks to CoreTiming concurrently.
+    core_timing.SetHostTiming(true);
+    core_timing.Initialize();
+    kernel.Initialize();
+
+    std::vector<u8> memory(2 * Memory::PAGE_SIZE);
+    std::memcpy(memory.data(), INCREMENT_LOOP.data(), sizeof(INCREMENT_LOOP));
+
+    auto process = Kernel::Process::Create(system, "", Kernel::Process::ProcessType::Userland);
+    auto& page_table = process->VMManager().page_table;
+    system.Memory().MapMemoryRegion(page_table, CODE_ADDRESS, memory.size(), memory.data());
+    kernel.MakeCurrentProcess(process.get());
+
+    std::atomic<std::size_t> cores_done{0};
+    std::vector<std::thread> threads;
+    for (std::size_t core = 0; core < NUM_CORES; ++core) {
+        auto& arm_interface = kernel.PhysicalCore(core).ArmInterface();
+        arm_interface.SetPC(CODE_ADDRESS);
+        arm_interface.SetReg(0, COUNTER_ADDRESS);
+        arm_interface.SetReg(1, increments_per_core);
+        threads.emplace_back([&arm_interface, &cores_done] {
+            arm_interface.Run();
+            ++cores_done;
+        });
+    }
+
+    const auto read_counter = [&] {
+        u64 value;
+        std::memcpy(&value, memory.data() + Memory::PAGE_SIZE, sizeof(value));
+        return value;
+    };
+    while (read_counter() != NUM_CORES * increments_per_core) {
+        std::this_thread::yield();
+    }
+    while (cores_done != NUM_CORES) {
+        for (std::size_t core = 0; core < NUM_CORES; ++core) {
+            kernel.PhysicalCore(core).ArmInterface().PrepareReschedule();
+        }
+        std::this_thread::yield();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(read_counter() == NUM_CORES * increments_per_core);
+    for (std::size_t core = 0; core < NUM_CORES; ++core) {
+        REQUIRE(kernel.PhysicalCore(core).ArmInterface().GetReg(1) == 0);
+    }
+
+    system.Memory().UnmapRegion(page_table, CODE_ADDRESS, memory.size());
+    kernel.Shutdown();
+    core_timing.Shutdown();
+    core_timing.SetHostTiming(false);
+}
+
+#endif
@@ -0,0 +1,117 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/arm/reservation_table.h"
+
+namespace {
+
+constexpr std::size_t NUM_THREADS = 4;
+constexpr VAddr COUNTER_ADDRESS = 0x8000'0040;
+
+/// Increments a shared counter from several threads through LDXR/STXR-like retry loops.
+/// Returns the number of failed exclusive stores.
+u64 RunContendedIncrements(Core::ReservationTable& table, std::atomic<u64>& counter,
+                           std::size_t increments_per_thread) {
+    std::atomic<bool> start{false};
+    std::atomic<u64> failures{0};
+    std::vector<std::thread> threads;
+
+    for (std::size_t core = 0; core < NUM_THREADS; ++core) {
+        threads.emplace_back([&, core] {
+            while (!start.load()) {
+            }
+            u64 local_failures = 0;
+            for (std::size_t i = 0; i < increments_per_thread; ++i) {
+                for (;;) {
+                    table.Mark(core, COUNTER_ADDRESS);
+                    const u64 value = counter.load(std::memory_order_relaxed);
+                    if (table.DoExclusiveOperation(core, COUNTER_ADDRESS, [&] {
+                            counter.store(value + 1, std::memory_order_relaxed);
+                        })) {
+                        break;
+                    }
+                    ++local_failures;
+                }
+            }
+            failures += local_failures;
+        });
+    }
+
+    start = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return failures;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ReservationTable[SingleCore]", "[core][arm]") {
+    Core::ReservationTable table{NUM_THREADS};
+    bool stored = false;
+
+    // Stores without a reservation fail.
+    REQUIRE(!table.DoExclusiveOperation(0, COUNTER_ADDRESS, [&] { stored = true; }));
+    REQUIRE(!stored);
+
+    // Reservations cover the whole cache line and are consumed by the store.
+    table.Mark(0, COUNTER_ADDRESS);
+    REQUIRE(table.DoExclusiveOperation(0, COUNTER_ADDRESS + 8, [&] { stored = true; }));
+    REQUIRE(stored);
+    REQUIRE(!table.DoExclusiveOperation(0, COUNTER_ADDRESS, [] {}));
+
+    // Reservations are dropped when clearing.
+    table.Mark(0, COUNTER_ADDRESS);
+    table.ClearAll();
+    REQUIRE(!table.DoExclusiveOperation(0, COUNTER_ADDRESS, [] {}));
+}
+
+TEST_CASE("ReservationTable[StoreBreaksOtherReservations]", "[core][arm]") {
+    Core::ReservationTable table{NUM_THREADS};
+
+    table.Mark(0, COUNTER_ADDRESS);
+    table.Mark(1, COUNTER_ADDRESS + 4);
+    table.Mark(2, COUNTER_ADDRESS + 0x1000);
+
+    REQUIRE(table.DoExclusiveOperation(1, COUNTER_ADDRESS + 4, [] {}));
+    REQUIRE(!table.DoExclusiveOperation(0, COUNTER_ADDRESS, [] {}));
+    REQUIRE(table.DoExclusiveOperation(2, COUNTER_ADDRESS + 0x1000, [] {}));
+}
+
+TEST_CASE("ReservationTable[Contended]", "[core][arm]") {
+    constexpr std::size_t INCREMENTS_PER_THREAD = 10000;
+
+    Core::ReservationTable table{NUM_THREADS};
+    std::atomic<u64> counter{0};
+    RunContendedIncrements(table, counter, INCREMENTS_PER_THREAD);
+
+    REQUIRE(counter == NUM_THREADS * INCREMENTS_PER_THREAD);
+}
+
+// Hidden by default, run with: tests "[benchmark]"
+TEST_CASE("ReservationTable[ContendedThroughput]", "[.][benchmark]") {
+    constexpr std::size_t INCREMENTS_PER_THREAD = 1'000'000;
+
+    Core::ReservationTable table{NUM_THREADS};
+    std::atomic<u64> counter{0};
+
+    const auto start = std::chrono::steady_clock::now();
+    const u64 failures = RunContendedIncrements(table, counter, INCREMENTS_PER_THREAD);
+    const auto end = std::chrono::steady_clock::now();
+
+    REQUIRE(counter == NUM_THREADS * INCREMENTS_PER_THREAD);
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    WARN(NUM_THREADS << " threads: " << static_cast<u64>(counter.load() / seconds)
+                     << " successful exclusive stores/s, " << failures << " failed stores");
+}
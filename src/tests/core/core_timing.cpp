@@ -5,14 +5,19 @@
 #include <catch2/catch.hpp>
 
 #include <array>
+#include <atomic>
 #include <bitset>
+#include <chrono>
 #include <cstdlib>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "common/file_util.h"
 #include "core/core.h"
 #include "core/core_timing.h"
+#include "core/core_timing_util.h"
 
 // Numbers are chosen randomly to make sure the correct one is given.
 static constexpr std::array<u64, 5> CB_IDS{{42, 144, 93, 1026, UINT64_C(0xFFFF7FFFF7FFFF)}};
@@ -154,3 +159,163 @@ TEST_CASE("Core::Timing[PredictableLateness]", "[core]") {
     AdvanceAndCheck(core_timing, 0, 0, 10, -10); // (100 - 10)
     AdvanceAndCheck(core_timing, 1, 1, 50, -50);
 }
+
+namespace {
+
+struct StressState {
+    u64 callbacks = 0;
+    s64 last_time = 0;
+    bool in_order = true;
+};
+
+StressState stress_state;
+
+void StressCallback(u64 userdata, s64 cycles_late) {
+    // Events carry their scheduled time as userdata, with bit 0 marking the ones to cancel.
+    const s64 time = static_cast<s64>(userdata >> 1);
+    stress_state.in_order &= time >= stress_state.last_time;
+    stress_state.in_order &= (userdata & 1) == 0;
+    stress_state.last_time = time;
+    ++stress_state.callbacks;
+}
+
+/// Schedules events from several threads at once, cancels half of them and runs them all.
+/// Returns the number of events expected to fire.
+u64 RunStress(Core::Timing::CoreTiming& core_timing, u64 events_per_thread) {
+    constexpr std::size_t NUM_THREADS = 4;
+    // Spread events over roughly a minute of emulated time, so every wheel level gets exercised.
+    constexpr u64 MAX_TIME = 1ULL << 36;
+
+    std::shared_ptr<Core::Timing::EventType> event_type =
+        Core::Timing::CreateEvent("stress", StressCallback);
+    stress_state = {};
+    core_timing.ResetRun();
+
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 0; thread < NUM_THREADS; ++thread) {
+        threads.emplace_back([&, thread] {
+            u64 seed = thread + 1;
+            for (u64 i = 0; i < events_per_thread; ++i) {
+                // xorshift64
+                seed ^= seed << 13;
+                seed ^= seed >> 7;
+                seed ^= seed << 17;
+                const u64 time = seed % MAX_TIME;
+                const u64 cancel = i & 1;
+                core_timing.ScheduleEvent(static_cast<s64>(time), event_type, time << 1 | cancel);
+                if (cancel != 0) {
+                    core_timing.UnscheduleEvent(event_type, time << 1 | cancel);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Advance in large steps, an event cycle at a time would take forever.
+    const u64 start = core_timing.GetTicks();
+    while (core_timing.GetTicks() < start + MAX_TIME) {
+        core_timing.AddTicks(MAX_TIME / 1024);
+        core_timing.Advance();
+    }
+    return NUM_THREADS * (events_per_thread - events_per_thread / 2);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CoreTiming[Stress]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    const u64 expected_callbacks = RunStress(core_timing, 50000);
+
+    REQUIRE(stress_state.in_order);
+    REQUIRE(stress_state.callbacks == expected_callbacks);
+}
+
+// Hidden by default, run with: tests "[benchmark]"
+TEST_CASE("CoreTiming[StressThroughput]", "[.][benchmark]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    const auto start = std::chrono::steady_clock::now();
+    const u64 expected_callbacks = RunStress(core_timing, 1000000);
+    const auto end = std::chrono::steady_clock::now();
+
+    REQUIRE(stress_state.in_order);
+    REQUIRE(stress_state.callbacks == expected_callbacks);
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    WARN("Scheduled 4000000 events, cancelled half of them and ran the rest in "
+         << seconds << " s");
+}
+
+TEST_CASE("CoreTiming[HostTiming]", "[core]") {
+    Core::Timing::CoreTiming core_timing;
+    core_timing.SetHostTiming(true);
+    core_timing.Initialize();
+
+    std::atomic<bool> interrupted{false};
+    core_timing.SetInterruptHandler([&interrupted] { interrupted = true; });
+
+    bool callback_ran = false;
+    std::shared_ptr<Core::Timing::EventType> event_type =
+        Core::Timing::CreateEvent("host", [&callback_ran](u64, s64) { callback_ran = true; });
+
+    core_timing.ResetRun();
+
+    // Idling sleeps until the event is due.
+    const s64 idle_delay = Core::Timing::usToCycles(std::chrono::microseconds{200});
+    u64 start = core_timing.GetTicks();
+    core_timing.ScheduleEvent(idle_delay, event_type);
+    core_timing.Idle();
+    core_timing.Advance();
+    REQUIRE(callback_ran);
+    REQUIRE(core_timing.GetTicks() - start >= static_cast<u64>(idle_delay));
+
+    // Running code is interrupted at slice ends and when the event is due.
+    callback_ran = false;
+    const s64 run_delay = Core::Timing::msToCycles(std::chrono::milliseconds{2});
+    start = core_timing.GetTicks();
+    core_timing.ScheduleEvent(run_delay, event_type);
+    while (!callback_ran) {
+        if (!core_timing.CanCurrentContextRun()) {
+            core_timing.ResetRun();
+        }
+        while (!interrupted) {
+            std::this_thread::yield();
+        }
+        interrupted = false;
+        core_timing.Advance();
+    }
+    REQUIRE(core_timing.GetTicks() - start >= static_cast<u64>(run_delay));
+
+    core_timing.Shutdown();
+}
+
+TEST_CASE("CoreTiming[Multicore]", "[core]") {
+    Core::Timing::CoreTiming core_timing;
+    core_timing.SetMulticore(true);
+    core_timing.Initialize();
+    REQUIRE(core_timing.IsHostTiming());
+
+    // Events are dispatched from the timer thread, without any core advancing time.
+    core_timing.SetInterruptHandler([&core_timing] { core_timing.DispatchHostEvents(); });
+
+    std::atomic<int> callbacks_ran{0};
+    std::shared_ptr<Core::Timing::EventType> event_type = Core::Timing::CreateEvent(
+        "multicore", [&callbacks_ran](u64, s64) { ++callbacks_ran; });
+
+    const s64 delay = Core::Timing::usToCycles(std::chrono::microseconds{500});
+    const u64 start = core_timing.GetTicks();
+    core_timing.ScheduleEvent(delay * 2, event_type, 1);
+    core_timing.ScheduleEvent(delay, event_type, 0);
+    while (callbacks_ran != 2) {
+        std::this_thread::yield();
+    }
+    REQUIRE(core_timing.GetTicks() - start >= static_cast<u64>(delay * 2));
+
+    core_timing.SetInterruptHandler(nullptr);
+    core_timing.Shutdown();
+}
@@ -0,0 +1,171 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/hex_util.h"
+#include "core/crypto/aes_ni.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/key_manager.h"
+
+namespace Core::Crypto {
+
+namespace {
+
+// NIST SP 800-38A, F.5.1 CTR-AES128.Encrypt
+constexpr char CTR_KEY[] = "2b7e151628aed2a6abf7158809cf4f3c";
+constexpr char CTR_COUNTER[] = "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+constexpr char CTR_PLAINTEXT[] =
+    "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+    "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+constexpr char CTR_CIPHERTEXT[] =
+    "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+    "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee";
+
+// IEEE 1619-2007, XTS-AES-128 vector 2
+constexpr char XTS_KEY[] = "1111111111111111111111111111111122222222222222222222222222222222";
+constexpr char XTS_TWEAK[] = "33333333330000000000000000000000";
+constexpr char XTS_PLAINTEXT[] =
+    "4444444444444444444444444444444444444444444444444444444444444444";
+constexpr char XTS_CIPHERTEXT[] =
+    "c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0";
+
+template <std::size_t Size>
+std::array<u8, Size> ToArray(const char* hex) {
+    return Common::HexStringToArray<Size>(hex);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("AESCipher: CTR matches the reference vectors", "[core]") {
+    AESCipher<Key128> cipher(ToArray<0x10>(CTR_KEY), Mode::CTR);
+    const auto counter = Common::HexStringToVector(CTR_COUNTER, false);
+    const auto plaintext = Common::HexStringToVector(CTR_PLAINTEXT, false);
+
+    std::vector<u8> ciphertext(plaintext.size());
+    cipher.SetIV(counter);
+    cipher.Transcode(plaintext.data(), plaintext.size(), ciphertext.data(), Op::Encrypt);
+    REQUIRE(ciphertext == Common::HexStringToVector(CTR_CIPHERTEXT, false));
+
+    // Decrypting a block at a time continues the counter.
+    std::vector<u8> decrypted(plaintext.size());
+    cipher.SetIV(counter);
+    for (std::size_t offset = 0; offset < ciphertext.size(); offset += 0x10) {
+        cipher.Transcode(ciphertext.data() + offset, 0x10, decrypted.data() + offset, Op::Decrypt);
+    }
+    REQUIRE(decrypted == plaintext);
+}
+
+TEST_CASE("AESCipher: XTS matches the reference vectors", "[core]") {
+    AESCipher<Key256> cipher(ToArray<0x20>(XTS_KEY), Mode::XTS);
+    const auto plaintext = Common::HexStringToVector(XTS_PLAINTEXT, false);
+
+    std::vector<u8> ciphertext(plaintext.size());
+    cipher.SetIV(Common::HexStringToVector(XTS_TWEAK, false));
+    cipher.Transcode(plaintext.data(), plaintext.size(), ciphertext.data(), Op::Encrypt);
+    REQUIRE(ciphertext == Common::HexStringToVector(XTS_CIPHERTEXT, false));
+
+    std::vector<u8> decrypted(plaintext.size());
+    cipher.Transcode(ciphertext.data(), ciphertext.size(), decrypted.data(), Op::Decrypt);
+    REQUIRE(decrypted == plaintext);
+}
+
+TEST_CASE("AESNI: CTR handles pipelined and partial blocks", "[core]") {
+    if (!AESNI::IsSupported()) {
+        return;
+    }
+    AESNI::KeySchedule schedule;
+    AESNI::ExpandKey(ToArray<0x10>(CTR_KEY).data(), schedule);
+    const auto plaintext = Common::HexStringToVector(CTR_PLAINTEXT, false);
+    const auto expected = Common::HexStringToVector(CTR_CIPHERTEXT, false);
+
+    // Twelve copies of the vector span a pipelined run and single blocks. The counter carries
+    // into the upper half on the way.
+    std::vector<u8> long_plaintext;
+    for (int i = 0; i < 12; ++i) {
+        long_plaintext.insert(long_plaintext.end(), plaintext.begin(), plaintext.end());
+    }
+    AESNI::Block counter = ToArray<0x10>("0000000000000000fffffffffffffffa");
+    std::vector<u8> long_ciphertext(long_plaintext.size());
+    AESNI::CTRTranscode(schedule, counter, long_plaintext.data(), long_plaintext.size(),
+                        long_ciphertext.data());
+    REQUIRE(counter == ToArray<0x10>("0000000000000001000000000000002a"));
+
+    // Block by block, with a partial block in between, yields the same stream.
+    counter = ToArray<0x10>("0000000000000000fffffffffffffffa");
+    std::vector<u8> stepped(long_plaintext.size());
+    AESNI::CTRTranscode(schedule, counter, long_plaintext.data(), 0x10, stepped.data());
+    AESNI::CTRTranscode(schedule, counter, long_plaintext.data() + 0x10, 0x7,
+                        stepped.data() + 0x10);
+    REQUIRE(counter == ToArray<0x10>("0000000000000000fffffffffffffffc"));
+    AESNI::CTRTranscode(schedule, counter, long_plaintext.data() + 0x20, stepped.size() - 0x20,
+                        stepped.data() + 0x20);
+    REQUIRE(std::equal(stepped.begin(), stepped.begin() + 0x17, long_ciphertext.begin()));
+    REQUIRE(std::equal(stepped.begin() + 0x20, stepped.end(), long_ciphertext.begin() + 0x20));
+
+    counter = ToArray<0x10>(CTR_COUNTER);
+    std::vector<u8> ciphertext(plaintext.size());
+    AESNI::CTRTranscode(schedule, counter, plaintext.data(), plaintext.size(), ciphertext.data());
+    REQUIRE(ciphertext == expected);
+}
+
+TEST_CASE("AESNI: XTS round trips pipelined data units", "[core]") {
+    if (!AESNI::IsSupported()) {
+        return;
+    }
+    const auto key = ToArray<0x20>(XTS_KEY);
+    AESNI::KeySchedule data_key;
+    AESNI::KeySchedule tweak_key;
+    AESNI::ExpandKey(key.data(), data_key);
+    AESNI::ExpandKey(key.data() + 0x10, tweak_key);
+    const auto tweak = ToArray<0x10>(XTS_TWEAK);
+
+    const auto plaintext = Common::HexStringToVector(XTS_PLAINTEXT, false);
+    std::vector<u8> ciphertext(plaintext.size());
+    AESNI::XTSTranscode(data_key, tweak_key, tweak, plaintext.data(), plaintext.size(),
+                        ciphertext.data(), Op::Encrypt);
+    REQUIRE(ciphertext == Common::HexStringToVector(XTS_CIPHERTEXT, false));
+
+    std::vector<u8> sector(0x200);
+    for (std::size_t i = 0; i < sector.size(); ++i) {
+        sector[i] = static_cast<u8>(i);
+    }
+    std::vector<u8> encrypted(sector.size());
+    std::vector<u8> decrypted(sector.size());
+    AESNI::XTSTranscode(data_key, tweak_key, tweak, sector.data(), sector.size(),
+                        encrypted.data(), Op::Encrypt);
+    AESNI::XTSTranscode(data_key, tweak_key, tweak, encrypted.data(), encrypted.size(),
+                        decrypted.data(), Op::Decrypt);
+    REQUIRE(encrypted != sector);
+    REQUIRE(decrypted == sector);
+}
+
+// Hidden by default, run with: tests "[benchmark]"
+TEST_CASE("AESCipher[Throughput]", "[.][benchmark]") {
+    constexpr std::size_t size = 64 * 1024 * 1024;
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<u8> data(size);
+    AESCipher<Key128> ctr_cipher(ToArray<0x10>(CTR_KEY), Mode::CTR);
+    ctr_cipher.SetIV(Common::HexStringToVector(CTR_COUNTER, false));
+    auto start = Clock::now();
+    ctr_cipher.Transcode(data.data(), data.size(), data.data(), Op::Decrypt);
+    const std::chrono::duration<double> ctr_seconds = Clock::now() - start;
+
+    AESCipher<Key256> xts_cipher(ToArray<0x20>(XTS_KEY), Mode::XTS);
+    start = Clock::now();
+    xts_cipher.XTSTranscode(data.data(), data.size(), data.data(), 0, 0x4000, Op::Decrypt);
+    const std::chrono::duration<double> xts_seconds = Clock::now() - start;
+
+    WARN("Decrypted " << size / (1024 * 1024) << " MiB in " << ctr_seconds.count()
+                      << " s with CTR and " << xts_seconds.count() << " s with XTS, AES-NI "
+                      << (AESNI::IsSupported() ? "enabled" : "unavailable"));
+}
+
+} // namespace Core::Crypto
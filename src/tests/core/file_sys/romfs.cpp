@@ -0,0 +1,96 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/fsmitm_romfsbuild.h"
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace FileSys {
+
+namespace {
+
+VirtualFile MakeFile(std::string name, std::size_t size, u8 value) {
+    return std::make_shared<VectorVfsFile>(std::vector<u8>(size, value), std::move(name));
+}
+
+/// Builds a small tree, with nested directories and files of various sizes.
+VirtualDir MakeTree() {
+    auto textures = std::make_shared<VectorVfsDirectory>(
+        std::vector<VirtualFile>{MakeFile("a.tex", 0x123, 1), MakeFile("b.tex", 0x40, 2)},
+        std::vector<VirtualDir>{}, "textures");
+    auto empty = std::make_shared<VectorVfsDirectory>(std::vector<VirtualFile>{},
+                                                      std::vector<VirtualDir>{}, "empty");
+    return std::make_shared<VectorVfsDirectory>(
+        std::vector<VirtualFile>{MakeFile("main.bin", 0x1000, 3), MakeFile("small.bin", 0x3, 4)},
+        std::vector<VirtualDir>{textures, empty}, "root");
+}
+
+} // Anonymous namespace
+
+TEST_CASE("RomFS: Built images extract back to the same tree", "[core]") {
+    const auto romfs = CreateRomFS(MakeTree());
+    REQUIRE(romfs != nullptr);
+
+    const auto extracted = ExtractRomFS(romfs, RomFSExtractionType::Full);
+    REQUIRE(extracted != nullptr);
+    const auto file = extracted->GetFileRelative("textures/a.tex");
+    REQUIRE(file != nullptr);
+    REQUIRE(file->ReadAllBytes() == std::vector<u8>(0x123, 1));
+    REQUIRE(extracted->GetFileRelative("main.bin")->GetSize() == 0x1000);
+    REQUIRE(extracted->GetSubdirectory("empty") != nullptr);
+}
+
+TEST_CASE("RomFS: Cached layouts rebuild identical images", "[core]") {
+    constexpr u64 key = 0x0123456789ABCDEF;
+    const auto tree = MakeTree();
+    const auto expected = CreateRomFS(tree)->ReadAllBytes();
+
+    RomFSBuildContext ctx{tree};
+    const auto data = SerializeRomFSLayout(ctx.Build(), key);
+    REQUIRE(!DeserializeRomFSLayout(data, key + 1));
+    REQUIRE(!DeserializeRomFSLayout({data.begin(), data.end() - 1}, key));
+
+    auto layout = DeserializeRomFSLayout(data, key);
+    REQUIRE(layout);
+    REQUIRE(layout->files.size() == 4);
+    for (const auto& file : layout->files) {
+        REQUIRE(file.source == nullptr);
+    }
+
+    // The files of the cached layout are opened in the tree.
+    REQUIRE(OpenRomFSLayoutSources(*layout, tree, nullptr));
+    const auto romfs = CreateRomFS(std::move(*layout), tree, nullptr, "root");
+    REQUIRE(romfs->ReadAllBytes() == expected);
+}
+
+TEST_CASE("RomFS: Stale cached layouts are built again", "[core]") {
+    constexpr u64 key = 0x0123456789ABCDEF;
+    const auto tree = MakeTree();
+
+    RomFSBuildContext ctx{tree};
+    const auto data = SerializeRomFSLayout(ctx.Build(), key);
+
+    // A file changed size after the layout was cached.
+    const auto main = tree->GetFile("main.bin");
+    REQUIRE(main->Resize(0x800));
+    const auto expected = CreateRomFS(tree)->ReadAllBytes();
+
+    auto layout = DeserializeRomFSLayout(data, key);
+    REQUIRE(layout);
+    REQUIRE(!OpenRomFSLayoutSources(*layout, tree, nullptr));
+
+    const auto romfs = CreateRomFS(std::move(*layout), tree, nullptr, "root");
+    REQUIRE(romfs->ReadAllBytes() == expected);
+    const auto extracted = ExtractRomFS(romfs, RomFSExtractionType::Full);
+    REQUIRE(extracted->GetFileRelative("main.bin")->GetSize() == 0x800);
+}
+
+} // namespace FileSys
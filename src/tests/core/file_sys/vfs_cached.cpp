@@ -0,0 +1,135 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs_cached.h"
+#include "core/file_sys/vfs_vector.h"
+#include "tests/core/file_sys/vfs_test_common.h"
+
+namespace FileSys {
+
+using VfsTests::MakeData;
+
+namespace {
+
+/// Counts the reads reaching the wrapped file.
+class CountingVfsFile : public VectorVfsFile {
+public:
+    using VectorVfsFile::VectorVfsFile;
+
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override {
+        ++num_reads;
+        return VectorVfsFile::Read(data, length, offset);
+    }
+
+    mutable std::atomic<std::size_t> num_reads{};
+};
+
+} // Anonymous namespace
+
+TEST_CASE("CachedVfsFile: Repeated reads hit the cache", "[core]") {
+    const auto data = MakeData(0x2800);
+    const auto base = std::make_shared<CountingVfsFile>(data);
+    const CachedVfsFile cached{base, 0x1000, 0x10000};
+    const auto total_stats = CachedVfsFile::GetTotalStats();
+
+    // Spans three blocks, the last one being shorter than the others.
+    std::vector<u8> out(0x1F00);
+    REQUIRE(cached.Read(out.data(), out.size(), 0x900) == 0x1F00);
+    REQUIRE(std::equal(out.begin(), out.end(), data.begin() + 0x900));
+    REQUIRE(base->num_reads == 3);
+
+    REQUIRE(cached.Read(out.data(), 0x10, 0x2000) == 0x10);
+    REQUIRE(std::equal(out.begin(), out.begin() + 0x10, data.begin() + 0x2000));
+    REQUIRE(base->num_reads == 3);
+    REQUIRE(cached.GetStats().hits == 1);
+    REQUIRE(cached.GetStats().misses == 3);
+
+    // Every file also adds to the totals reported at shutdown.
+    REQUIRE(CachedVfsFile::GetTotalStats().hits - total_stats.hits == 1);
+    REQUIRE(CachedVfsFile::GetTotalStats().misses - total_stats.misses == 3);
+
+    // Reads are trimmed to the end of the file.
+    REQUIRE(cached.Read(out.data(), 0x100, 0x2780) == 0x80);
+    REQUIRE(cached.Read(out.data(), 0x100, 0x2800) == 0);
+}
+
+TEST_CASE("CachedVfsFile: Least recently used blocks are evicted", "[core]") {
+    const auto data = MakeData(0x40000);
+    const auto base = std::make_shared<CountingVfsFile>(data);
+    // A single block per shard, blocks 0 and 8 share a shard.
+    const CachedVfsFile cached{base, 0x1000, 0x8000};
+
+    u8 byte{};
+    cached.Read(&byte, 1, 0);
+    cached.Read(&byte, 1, 0x8000);
+    REQUIRE(base->num_reads == 2);
+    cached.Read(&byte, 1, 0x8000);
+    REQUIRE(base->num_reads == 2);
+    cached.Read(&byte, 1, 0);
+    REQUIRE(base->num_reads == 3);
+    REQUIRE(byte == data[0]);
+
+    // Large reads are not cached.
+    std::vector<u8> out(0x4000);
+    REQUIRE(cached.Read(out.data(), out.size(), 0x10000) == out.size());
+    REQUIRE(std::equal(out.begin(), out.end(), data.begin() + 0x10000));
+    REQUIRE(cached.GetStats().bypassed_reads == 1);
+    cached.Read(&byte, 1, 0);
+    REQUIRE(base->num_reads == 4);
+}
+
+TEST_CASE("CachedVfsFile: Bypassed threads do not fill the cache", "[core]") {
+    const auto data = MakeData(0x4000);
+    const auto base = std::make_shared<CountingVfsFile>(data);
+    const CachedVfsFile cached{base, 0x1000, 0x10000};
+
+    u8 byte{};
+    std::thread{[&cached, &byte] {
+        CachedVfsFile::SetBypassedOnCurrentThread(true);
+        cached.Read(&byte, 1, 0x1234);
+    }}.join();
+    REQUIRE(byte == data[0x1234]);
+    REQUIRE(cached.GetStats().bypassed_reads == 1);
+    REQUIRE(cached.GetStats().misses == 0);
+
+    // Other threads still use the cache.
+    cached.Read(&byte, 1, 0x1234);
+    cached.Read(&byte, 1, 0x1235);
+    REQUIRE(base->num_reads == 2);
+    REQUIRE(cached.GetStats().hits == 1);
+}
+
+TEST_CASE("CachedVfsFile: Concurrent reads return the file contents", "[core]") {
+    const auto data = MakeData(0x100000);
+    const CachedVfsFile cached{std::make_shared<CountingVfsFile>(data), 0x1000, 0x20000};
+
+    std::atomic<bool> mismatch{};
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i] {
+            std::vector<u8> out(0x300);
+            for (std::size_t offset = i * 0x123; offset < data.size(); offset += 0x777) {
+                const std::size_t read = cached.Read(out.data(), out.size(), offset);
+                if (!std::equal(out.begin(), out.begin() + read, data.begin() + offset)) {
+                    mismatch = true;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(!mismatch);
+}
+
+} // namespace FileSys
@@ -0,0 +1,118 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/scope_exit.h"
+#include "core/file_sys/vfs_readahead.h"
+#include "core/file_sys/vfs_vector.h"
+#include "tests/core/file_sys/vfs_test_common.h"
+
+namespace FileSys {
+
+using VfsTests::MakeData;
+
+namespace {
+
+/// Blocks the reads of every thread but the one that created it, until released.
+class BlockingVfsFile : public VectorVfsFile {
+public:
+    explicit BlockingVfsFile(std::vector<u8> data)
+        : VectorVfsFile{std::move(data)}, owner{std::this_thread::get_id()},
+          released{release.get_future().share()} {}
+
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override {
+        if (std::this_thread::get_id() != owner) {
+            released.wait();
+        }
+        return VectorVfsFile::Read(data, length, offset);
+    }
+
+    void Release() {
+        release.set_value();
+    }
+
+private:
+    const std::thread::id owner;
+    std::promise<void> release;
+    const std::shared_future<void> released;
+};
+
+/// Waits until the prefetches of a file read the given number of bytes.
+void WaitForPrefetchedBytes(const ReadaheadVfsFile& file, u64 bytes) {
+    while (file.GetStats().prefetched_bytes < bytes) {
+        std::this_thread::yield();
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ReadaheadVfsFile: Sequential reads are served from prefetched windows", "[core]") {
+    const auto data = MakeData(0x40000);
+    const ReadaheadVfsFile file{std::make_shared<VectorVfsFile>(data), 0x4000, 2};
+
+    std::vector<u8> out(0x1000);
+    for (std::size_t offset = 0; offset < 0x10000; offset += out.size()) {
+        if (offset >= 0x2000) {
+            // Windows still queued are read directly, wait for the prefetch of this one.
+            WaitForPrefetchedBytes(file, (offset / 0x4000 + 1) * 0x4000);
+        }
+        REQUIRE(file.Read(out.data(), out.size(), offset) == out.size());
+        REQUIRE(std::equal(out.begin(), out.end(), data.begin() + offset));
+    }
+
+    // Prefetching starts once the reader was seen reading sequentially.
+    const auto stats = file.GetStats();
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.hits == 14);
+    REQUIRE(stats.prefetched_bytes >= 0x10000);
+
+    // Reads are trimmed to the end of the file.
+    REQUIRE(file.Read(out.data(), out.size(), 0x3FF80) == 0x80);
+    REQUIRE(std::equal(out.begin(), out.begin() + 0x80, data.begin() + 0x3FF80));
+}
+
+TEST_CASE("ReadaheadVfsFile: Random reads are not prefetched", "[core]") {
+    const auto data = MakeData(0x40000);
+    const ReadaheadVfsFile file{std::make_shared<VectorVfsFile>(data), 0x4000, 2};
+
+    std::vector<u8> out(0x100);
+    for (const std::size_t offset : {0x8000, 0x1000, 0x20000, 0x300}) {
+        REQUIRE(file.Read(out.data(), out.size(), offset) == out.size());
+        REQUIRE(std::equal(out.begin(), out.end(), data.begin() + offset));
+    }
+
+    const auto stats = file.GetStats();
+    REQUIRE(stats.misses == 4);
+    REQUIRE(stats.prefetched_bytes == 0);
+}
+
+TEST_CASE("ReadaheadVfsFile: Reads do not wait on queued prefetches", "[core]") {
+    const auto data = MakeData(0x40000);
+    std::vector<u8> out(0x1000);
+
+    // Keeps the prefetch worker busy with a window of another file.
+    const auto blocking = std::make_shared<BlockingVfsFile>(data);
+    SCOPE_EXIT({ blocking->Release(); });
+    const ReadaheadVfsFile blocked{blocking, 0x4000, 1};
+    REQUIRE(blocked.Read(out.data(), out.size(), 0) == out.size());
+    REQUIRE(blocked.Read(out.data(), out.size(), 0x1000) == out.size());
+
+    // The windows of this file are queued behind it, so it reads them itself.
+    const ReadaheadVfsFile file{std::make_shared<VectorVfsFile>(data), 0x4000, 2};
+    for (std::size_t offset = 0; offset < 0x3000; offset += out.size()) {
+        REQUIRE(file.Read(out.data(), out.size(), offset) == out.size());
+        REQUIRE(std::equal(out.begin(), out.end(), data.begin() + offset));
+    }
+    REQUIRE(file.GetStats().misses == 3);
+}
+
+} // namespace FileSys
@@ -0,0 +1,125 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "core/file_sys/mode.h"
+#include "core/file_sys/vfs_concat.h"
+#include "core/file_sys/vfs_offset.h"
+#include "core/file_sys/vfs_real.h"
+#include "tests/core/file_sys/vfs_test_common.h"
+
+namespace FileSys {
+
+using VfsTests::MakeData;
+
+namespace {
+
+/// Writes a file to the temporary directory and removes it once the test is done.
+class TemporaryFile {
+public:
+    explicit TemporaryFile(const std::vector<u8>& data) : path{MakeUniquePath()} {
+        FileUtil::IOFile file{path, "wb"};
+        file.WriteBytes(data.data(), data.size());
+    }
+
+    ~TemporaryFile() {
+        FileUtil::Delete(path);
+    }
+
+    const std::string path;
+
+private:
+    /// Names the file uniquely, so that concurrent test runs do not share it.
+    static std::string MakeUniquePath() {
+        static std::atomic<u32> next_id{};
+        std::random_device device;
+        const auto name = fmt::format("yuzu_vfs_real_test_{:08x}{:08x}_{}.bin", device(),
+                                      device(), next_id++);
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+};
+
+} // Anonymous namespace
+
+TEST_CASE("RealVfsFile: Read-only files expose their contents", "[core]") {
+    const auto data = MakeData(0x3000);
+    const TemporaryFile temporary{data};
+    RealVfsFilesystem filesystem;
+    const auto file = filesystem.OpenFile(temporary.path, Mode::Read);
+    REQUIRE(file != nullptr);
+
+    const auto span = file->GetSpan(0x100, 0x1F00);
+    REQUIRE(span.size() == 0x100);
+    REQUIRE(std::equal(span.begin(), span.end(), data.begin() + 0x1F00));
+    REQUIRE(file->GetSpan(0x100, 0x2F80).empty());
+
+    std::vector<u8> out(0x200);
+    REQUIRE(file->Read(out.data(), out.size(), 0x123) == out.size());
+    REQUIRE(std::equal(out.begin(), out.end(), data.begin() + 0x123));
+    REQUIRE(file->ReadAllBytes() == data);
+    // Reads past the end of the file are trimmed.
+    REQUIRE(file->Read(out.data(), out.size(), 0x2F00) == 0x100);
+}
+
+TEST_CASE("RealVfsFile: Spans propagate through offset and concatenated files", "[core]") {
+    const auto data = MakeData(0x3000);
+    const TemporaryFile temporary{data};
+    RealVfsFilesystem filesystem;
+    const auto file = filesystem.OpenFile(temporary.path, Mode::Read);
+
+    const auto first = std::make_shared<OffsetVfsFile>(file, 0x1000, 0x800);
+    const auto second = std::make_shared<OffsetVfsFile>(file, 0x1000, 0x2000);
+    REQUIRE(first->GetSpan(0x10, 0x10).data() == file->GetSpan(0x10, 0x810).data());
+    REQUIRE(first->GetSpan(0x10, 0xFF8).empty());
+
+    const auto concatenated =
+        ConcatenatedVfsFile::MakeConcatenatedFile({first, second}, "concatenated");
+    REQUIRE(concatenated->GetSpan(0x10, 0x1008).data() == file->GetSpan(0x10, 0x2008).data());
+    // Ranges spanning both files are not contiguous.
+    REQUIRE(concatenated->GetSpan(0x10, 0xFF8).empty());
+}
+
+TEST_CASE("RealVfsFile: Mapped files can be moved and deleted", "[core]") {
+    const auto data = MakeData(0x2000);
+    const TemporaryFile temporary{data};
+    const std::string moved_path = temporary.path + ".moved";
+    RealVfsFilesystem filesystem;
+    const auto file = filesystem.OpenFile(temporary.path, Mode::Read);
+    REQUIRE(!file->GetSpan(0x10, 0).empty());
+
+    // Moving drops the mapping, the file is then read from its new location.
+    REQUIRE(filesystem.MoveFile(temporary.path, moved_path) != nullptr);
+    REQUIRE(file->GetSpan(0x10, 0).empty());
+    REQUIRE(file->ReadBytes(0x100, 0x80) == std::vector<u8>(data.begin() + 0x80,
+                                                            data.begin() + 0x180));
+
+    REQUIRE(filesystem.DeleteFile(moved_path));
+    REQUIRE(!FileUtil::Exists(moved_path));
+}
+
+TEST_CASE("RealVfsFile: Writable files are not mapped", "[core]") {
+    const TemporaryFile temporary{MakeData(0x1000)};
+    RealVfsFilesystem filesystem;
+    const auto file = filesystem.OpenFile(temporary.path, Mode::ReadWrite);
+    REQUIRE(file->GetSpan(0x10, 0).empty());
+
+    const std::vector<u8> written(0x10, 0xFF);
+    REQUIRE(file->WriteBytes(written, 0x20) == written.size());
+    REQUIRE(file->ReadBytes(0x10, 0x20) == written);
+}
+
+} // namespace FileSys
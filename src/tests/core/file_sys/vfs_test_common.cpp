@@ -0,0 +1,17 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <numeric>
+
+#include "tests/core/file_sys/vfs_test_common.h"
+
+namespace VfsTests {
+
+std::vector<u8> MakeData(std::size_t size) {
+    std::vector<u8> data(size);
+    std::iota(data.begin(), data.end(), u8{0});
+    return data;
+}
+
+} // namespace VfsTests
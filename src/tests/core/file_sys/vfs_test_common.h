@@ -0,0 +1,17 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace VfsTests {
+
+/// Returns size bytes counting up from zero, so a byte's value reveals its offset.
+std::vector<u8> MakeData(std::size_t size);
+
+} // namespace VfsTests
@@ -0,0 +1,172 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <optional>
+
+#include "common/arena.h"
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/hle/ipc.h"
+#include "core/hle/ipc_helpers.h"
+#include "core/hle/kernel/handle_table.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/server_session.h"
+#include "core/hle/result.h"
+
+namespace {
+
+constexpr u32 COMMAND_ID = 7;
+
+/// Service echoing a parameter along with the size of the buffers it was handed.
+class SyntheticService final : public Kernel::SessionRequestHandler {
+public:
+    ResultCode HandleSyncRequest(Kernel::HLERequestContext& ctx) override {
+        IPC::RequestParser rp{ctx};
+        const u64 value = rp.Pop<u64>();
+        const u64 sizes = ctx.BufferDescriptorX()[0].Size() + ctx.BufferDescriptorA()[0].Size() +
+                          ctx.BufferDescriptorB()[0].Size() + ctx.BufferDescriptorC()[0].Size();
+
+        IPC::ResponseBuilder rb{ctx, 4};
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(value + sizes);
+        return RESULT_SUCCESS;
+    }
+};
+
+/// Writes a request with one buffer of each kind and a u64 parameter.
+void WriteRequest(std::array<u32, IPC::COMMAND_BUFFER_LENGTH>& cmd_buf, u64 value) {
+    cmd_buf.fill(0);
+
+    IPC::CommandHeader header{};
+    header.type.Assign(IPC::CommandType::Request);
+    header.num_buf_x_descriptors.Assign(1);
+    header.num_buf_a_descriptors.Assign(1);
+    header.num_buf_b_descriptors.Assign(1);
+    // Padding, payload header, command id and parameter.
+    header.data_size.Assign(4 + 2 + 2 + 2);
+    header.buf_c_descriptor_flags.Assign(IPC::CommandHeader::BufferDescriptorCFlag::OneDescriptor);
+    std::memcpy(&cmd_buf[0], &header, sizeof(header));
+
+    IPC::BufferDescriptorX x{};
+    x.size.Assign(0x10);
+    std::memcpy(&cmd_buf[2], &x, sizeof(x));
+
+    IPC::BufferDescriptorABW a{};
+    a.size_bits_0_31 = 0x20;
+    std::memcpy(&cmd_buf[4], &a, sizeof(a));
+
+    IPC::BufferDescriptorABW b{};
+    b.size_bits_0_31 = 0x40;
+    std::memcpy(&cmd_buf[7], &b, sizeof(b));
+
+    // The data payload is aligned to 4 words.
+    cmd_buf[12] = Common::MakeMagic('S', 'F', 'C', 'I');
+    cmd_buf[14] = COMMAND_ID;
+    cmd_buf[16] = static_cast<u32>(value);
+    cmd_buf[17] = static_cast<u32>(value >> 32);
+
+    IPC::BufferDescriptorC c{};
+    c.size.Assign(0x80);
+    std::memcpy(&cmd_buf[20], &c, sizeof(c));
+}
+
+/**
+ * Performs a request the way ServerSession does, returning the value echoed by the service, or
+ * nothing if the request failed, left the arena in use or kept some of its state on the heap.
+ */
+std::optional<u64> RoundTrip(Common::Arena& arena,
+                             const std::shared_ptr<Kernel::ServerSession>& session,
+                             const Kernel::HandleTable& handle_table,
+                             Kernel::SessionRequestHandler& service,
+                             std::array<u32, IPC::COMMAND_BUFFER_LENGTH>& cmd_buf) {
+    {
+        auto context = std::allocate_shared<Kernel::HLERequestContext>(
+            Common::ArenaAllocator<Kernel::HLERequestContext>{&arena}, session, nullptr, &arena);
+        context->PopulateFromIncomingCommandBuffer(handle_table, cmd_buf.data());
+        if (context->BufferDescriptorX().get_allocator().GetArena() != &arena ||
+            context->BufferDescriptorC().get_allocator().GetArena() != &arena) {
+            return std::nullopt;
+        }
+        service.HandleSyncRequest(*context);
+        std::memcpy(cmd_buf.data(), context->CommandBuffer(), sizeof(cmd_buf));
+    }
+    if (!arena.Reset()) {
+        return std::nullopt;
+    }
+
+    // Header, padding and payload header come before the result and the echoed value.
+    if (ResultCode{cmd_buf[6]} != RESULT_SUCCESS) {
+        return std::nullopt;
+    }
+    return cmd_buf[8] | (u64{cmd_buf[9]} << 32);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("HLERequestContext: Arena backed requests reuse the arena", "[core]") {
+    Kernel::KernelCore kernel{Core::System::GetInstance()};
+    auto session = Kernel::ServerSession::Create(kernel, nullptr, "Synthetic").Unwrap();
+    Kernel::HandleTable handle_table;
+    SyntheticService service;
+    Common::Arena arena;
+    std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf{};
+
+    // Warm up, the first round sizes the arena.
+    WriteRequest(cmd_buf, 1);
+    REQUIRE(RoundTrip(arena, session, handle_table, service, cmd_buf) == 1 + 0xF0);
+
+    // Once sized, the arena serves every request without reserving more memory from the heap.
+    bool all_echoed = true;
+    const std::size_t capacity = arena.Capacity();
+    for (u64 i = 0; i < 100; ++i) {
+        WriteRequest(cmd_buf, i);
+        all_echoed &= RoundTrip(arena, session, handle_table, service, cmd_buf) == i + 0xF0;
+    }
+
+    REQUIRE(all_echoed);
+    REQUIRE(arena.Capacity() == capacity);
+    REQUIRE(arena.LiveAllocations() == 0);
+}
+
+// Hidden by default, run with: tests "[benchmark]"
+TEST_CASE("HLERequestContext[Throughput]", "[.][benchmark]") {
+    constexpr u64 num_requests = 1000000;
+    using Clock = std::chrono::steady_clock;
+
+    Kernel::KernelCore kernel{Core::System::GetInstance()};
+    auto session = Kernel::ServerSession::Create(kernel, nullptr, "Synthetic").Unwrap();
+    Kernel::HandleTable handle_table;
+    SyntheticService service;
+    std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf{};
+
+    auto start = Clock::now();
+    for (u64 i = 0; i < num_requests; ++i) {
+        WriteRequest(cmd_buf, i);
+        auto context = std::make_shared<Kernel::HLERequestContext>(session, nullptr);
+        context->PopulateFromIncomingCommandBuffer(handle_table, cmd_buf.data());
+        service.HandleSyncRequest(*context);
+    }
+    const std::chrono::duration<double> heap_seconds = Clock::now() - start;
+
+    Common::Arena arena;
+    bool all_echoed = true;
+    start = Clock::now();
+    for (u64 i = 0; i < num_requests; ++i) {
+        WriteRequest(cmd_buf, i);
+        all_echoed &= RoundTrip(arena, session, handle_table, service, cmd_buf) == i + 0xF0;
+    }
+    const std::chrono::duration<double> arena_seconds = Clock::now() - start;
+
+    REQUIRE(all_echoed);
+    WARN("Ran " << num_requests << " requests in " << heap_seconds.count() << " s on the heap, "
+                << arena_seconds.count() << " s using an arena");
+}
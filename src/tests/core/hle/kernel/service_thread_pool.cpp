@@ -0,0 +1,41 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include "core/core.h"
+#include "core/hardware_properties.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/service_thread_pool.h"
+
+TEST_CASE("ServiceThreadPool: Queued work is run before destruction", "[core]") {
+    Kernel::KernelCore kernel{Core::System::GetInstance()};
+    std::atomic<int> runs{0};
+    {
+        Kernel::ServiceThreadPool pool{kernel, 2};
+        for (int i = 0; i < 64; ++i) {
+            pool.QueueWork([&runs] { ++runs; });
+        }
+    }
+    REQUIRE(runs == 64);
+}
+
+TEST_CASE("ServiceThreadPool: Work runs on registered host threads", "[core]") {
+    Kernel::KernelCore kernel{Core::System::GetInstance()};
+    const auto main_thread_id = std::this_thread::get_id();
+    std::atomic<bool> off_main_thread{false};
+    std::atomic<u32> host_thread_id{Core::INVALID_HOST_THREAD_ID};
+    {
+        Kernel::ServiceThreadPool pool{kernel, 1};
+        pool.QueueWork([&] {
+            off_main_thread = std::this_thread::get_id() != main_thread_id;
+            host_thread_id = kernel.GetCurrentHostThreadID();
+        });
+    }
+    REQUIRE(off_main_thread);
+    REQUIRE(host_thread_id != Core::INVALID_HOST_THREAD_ID);
+}
@@ -0,0 +1,38 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <string>
+
+#include "common/common_types.h"
+#include "core/hle/kernel/svc_stats.h"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("SVCStatsRegistry: Snapshots are sorted by total time", "[core]") {
+    Kernel::SVCStatsRegistry registry;
+    registry.Get(0x21, true).latency.Record(50us);
+    registry.Get(0x21, true).latency.Record(50us);
+    registry.Get(0x18, true).latency.Record(20us);
+    registry.Get(0x21, false).latency.Record(200us);
+
+    const auto snapshots = registry.Snapshot();
+    REQUIRE(snapshots.size() == 3);
+    REQUIRE(snapshots[0].name == "SendSyncRequest32");
+    REQUIRE(!snapshots[0].is_64_bit);
+    REQUIRE(snapshots[1].name == "SendSyncRequest");
+    REQUIRE(snapshots[1].id == 0x21);
+    REQUIRE(snapshots[1].latency.calls == 2);
+    REQUIRE(snapshots[1].latency.total_time == 100us);
+    REQUIRE(snapshots[2].name == "WaitSynchronization");
+
+    const std::string json = registry.ToJson();
+    REQUIRE(json.find("\"name\": \"WaitSynchronization\"") != std::string::npos);
+    REQUIRE(json.find("\"total_ns\": 100000") != std::string::npos);
+
+    registry.Reset();
+    REQUIRE(registry.Snapshot().empty());
+}
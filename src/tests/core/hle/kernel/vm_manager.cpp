@@ -0,0 +1,178 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/page_table.h"
+#include "core/core.h"
+#include "core/hle/kernel/physical_memory.h"
+#include "core/hle/kernel/vm_manager.h"
+#include "core/memory.h"
+
+namespace {
+
+/// Maps a fresh block of the given number of pages at the start of the map region.
+VAddr MapPages(Kernel::VMManager& vm_manager, u64 num_pages) {
+    const VAddr base = vm_manager.GetMapRegionBaseAddress();
+    const u64 size = num_pages * Memory::PAGE_SIZE;
+    const auto result =
+        vm_manager.MapMemoryBlock(base, std::make_shared<Kernel::PhysicalMemory>(size), 0, size,
+                                  Kernel::MemoryState::Heap, Kernel::VMAPermission::ReadWrite);
+    REQUIRE(result.Succeeded());
+    return base;
+}
+
+enum class TraceOp { Map, Reprotect, Unmap };
+
+struct TraceEntry {
+    TraceOp op;
+    u64 page;
+    u64 num_pages;
+    Kernel::VMAPermission permissions;
+};
+
+/**
+ * Builds a trace in the shape of the memory SVCs issued by JIT-style engines: code pages are
+ * mapped read-write, flipped to read-execute once written, sometimes patched and eventually
+ * released.
+ */
+std::vector<TraceEntry> MakeJitTrace(std::size_t num_entries, u64 num_slots) {
+    std::mt19937 rng{0x5EED};
+    std::vector<bool> mapped(num_slots);
+    std::vector<TraceEntry> trace;
+    trace.reserve(num_entries);
+    while (trace.size() < num_entries) {
+        const u64 slot = rng() % num_slots;
+        // Slots are four pages wide, with a guard page after them.
+        const u64 page = slot * 5;
+        if (!mapped[slot]) {
+            trace.push_back({TraceOp::Map, page, 4, Kernel::VMAPermission::ReadWrite});
+            trace.push_back({TraceOp::Reprotect, page, 4, Kernel::VMAPermission::ReadExecute});
+            mapped[slot] = true;
+        } else if (rng() % 4 != 0) {
+            const u64 patched_page = page + rng() % 4;
+            trace.push_back(
+                {TraceOp::Reprotect, patched_page, 1, Kernel::VMAPermission::ReadWrite});
+            trace.push_back(
+                {TraceOp::Reprotect, patched_page, 1, Kernel::VMAPermission::ReadExecute});
+        } else {
+            trace.push_back({TraceOp::Unmap, page, 4, Kernel::VMAPermission::None});
+            mapped[slot] = false;
+        }
+    }
+    return trace;
+}
+
+void ReplayTrace(Kernel::VMManager& vm_manager, const std::vector<TraceEntry>& trace) {
+    const VAddr base = vm_manager.GetMapRegionBaseAddress();
+    for (const auto& entry : trace) {
+        const VAddr address = base + entry.page * Memory::PAGE_SIZE;
+        const u64 size = entry.num_pages * Memory::PAGE_SIZE;
+        switch (entry.op) {
+        case TraceOp::Map:
+            vm_manager.MapMemoryBlock(address, std::make_shared<Kernel::PhysicalMemory>(size), 0,
+                                      size, Kernel::MemoryState::Heap, entry.permissions);
+            break;
+        case TraceOp::Reprotect:
+            vm_manager.ReprotectRange(address, size, entry.permissions);
+            break;
+        case TraceOp::Unmap:
+            vm_manager.UnmapRange(address, size);
+            break;
+        }
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("VMManager: Reprotecting a range splits and merges VMAs", "[core]") {
+    Kernel::VMManager vm_manager{Core::System::GetInstance()};
+    const VAddr base = MapPages(vm_manager, 16);
+
+    REQUIRE(vm_manager.ReprotectRange(base + 4 * Memory::PAGE_SIZE, 4 * Memory::PAGE_SIZE,
+                                      Kernel::VMAPermission::Read) == RESULT_SUCCESS);
+    const auto middle = vm_manager.QueryMemory(base + 4 * Memory::PAGE_SIZE);
+    REQUIRE(middle.base_address == base + 4 * Memory::PAGE_SIZE);
+    REQUIRE(middle.size == 4 * Memory::PAGE_SIZE);
+    REQUIRE(middle.permission == static_cast<u32>(Kernel::VMAPermission::Read));
+    REQUIRE(vm_manager.QueryMemory(base).size == 4 * Memory::PAGE_SIZE);
+
+    // Reprotecting does not touch the mappings.
+    const auto& page_table = vm_manager.page_table;
+    const u64 page = (base >> Memory::PAGE_BITS) + 5;
+    REQUIRE(page_table.attributes[page] == Common::PageType::Memory);
+    REQUIRE(page_table.pointers[page] != nullptr);
+
+    REQUIRE(vm_manager.ReprotectRange(base + 4 * Memory::PAGE_SIZE, 4 * Memory::PAGE_SIZE,
+                                      Kernel::VMAPermission::ReadWrite) == RESULT_SUCCESS);
+    const auto merged = vm_manager.QueryMemory(base + 4 * Memory::PAGE_SIZE);
+    REQUIRE(merged.base_address == base);
+    REQUIRE(merged.size == 16 * Memory::PAGE_SIZE);
+}
+
+TEST_CASE("VMManager: Unmapping a range updates the page table", "[core]") {
+    Kernel::VMManager vm_manager{Core::System::GetInstance()};
+    const VAddr base = MapPages(vm_manager, 16);
+
+    // Split the range into several VMAs, so that unmapping goes through all of them.
+    vm_manager.ReprotectRange(base + 2 * Memory::PAGE_SIZE, Memory::PAGE_SIZE,
+                              Kernel::VMAPermission::Read);
+    vm_manager.ReprotectRange(base + 6 * Memory::PAGE_SIZE, Memory::PAGE_SIZE,
+                              Kernel::VMAPermission::Read);
+    REQUIRE(vm_manager.UnmapRange(base + 2 * Memory::PAGE_SIZE, 8 * Memory::PAGE_SIZE) ==
+            RESULT_SUCCESS);
+
+    const auto unmapped = vm_manager.QueryMemory(base + 2 * Memory::PAGE_SIZE);
+    REQUIRE(unmapped.base_address == base + 2 * Memory::PAGE_SIZE);
+    REQUIRE(unmapped.size == 8 * Memory::PAGE_SIZE);
+    REQUIRE(unmapped.state == static_cast<u32>(Kernel::MemoryState::Unmapped));
+
+    const auto& page_table = vm_manager.page_table;
+    const u64 first_page = base >> Memory::PAGE_BITS;
+    for (u64 page = 0; page < 16; ++page) {
+        const bool is_mapped = page < 2 || page >= 10;
+        REQUIRE((page_table.attributes[first_page + page] == Common::PageType::Memory) ==
+                is_mapped);
+        REQUIRE((page_table.pointers[first_page + page] != nullptr) == is_mapped);
+    }
+}
+
+TEST_CASE("VMManager: Replayed traces leave a consistent layout", "[core]") {
+    constexpr u64 num_slots = 64;
+    Kernel::VMManager vm_manager{Core::System::GetInstance()};
+    ReplayTrace(vm_manager, MakeJitTrace(4096, num_slots));
+
+    // Every slot is either fully mapped read-execute or fully unmapped, and guard pages are free.
+    const VAddr base = vm_manager.GetMapRegionBaseAddress();
+    for (u64 slot = 0; slot < num_slots; ++slot) {
+        const auto info = vm_manager.QueryMemory(base + slot * 5 * Memory::PAGE_SIZE);
+        if (info.state == static_cast<u32>(Kernel::MemoryState::Unmapped)) {
+            continue;
+        }
+        REQUIRE(info.base_address == base + slot * 5 * Memory::PAGE_SIZE);
+        REQUIRE(info.size == 4 * Memory::PAGE_SIZE);
+        REQUIRE(info.permission == static_cast<u32>(Kernel::VMAPermission::ReadExecute));
+    }
+}
+
+// Hidden by default, run with: tests "[benchmark]"
+TEST_CASE("VMManager[Throughput]", "[.][benchmark]") {
+    constexpr std::size_t num_entries = 1000000;
+    using Clock = std::chrono::steady_clock;
+
+    const auto trace = MakeJitTrace(num_entries, 1024);
+    Kernel::VMManager vm_manager{Core::System::GetInstance()};
+
+    const auto start = Clock::now();
+    ReplayTrace(vm_manager, trace);
+    const std::chrono::duration<double> seconds = Clock::now() - start;
+
+    WARN("Replayed " << trace.size() << " memory operations in " << seconds.count() << " s");
+}
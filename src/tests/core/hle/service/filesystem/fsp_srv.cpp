@@ -0,0 +1,107 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/file_sys/vfs_vector.h"
+#include "core/hle/ipc.h"
+#include "core/hle/kernel/handle_table.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/server_session.h"
+#include "core/hle/kernel/service_thread_pool.h"
+#include "core/hle/result.h"
+#include "core/hle/service/filesystem/fsp_srv.h"
+#include "core/memory.h"
+
+namespace {
+
+constexpr VAddr BUFFER_ADDRESS = 0x1000'0000;
+constexpr u32 BUFFER_SIZE = 0x100;
+constexpr u8 BUFFER_FILL = 0xCC;
+
+/// Writes an IFile Read request with a B buffer at BUFFER_ADDRESS.
+void WriteReadRequest(std::array<u32, IPC::COMMAND_BUFFER_LENGTH>& cmd_buf, u64 offset,
+                      u64 length) {
+    cmd_buf.fill(0);
+
+    IPC::CommandHeader header{};
+    header.type.Assign(IPC::CommandType::Request);
+    header.num_buf_b_descriptors.Assign(1);
+    // Padding, payload header, command id, option, offset and length.
+    header.data_size.Assign(4 + 2 + 2 + 2 + 2 + 2);
+    std::memcpy(&cmd_buf[0], &header, sizeof(header));
+
+    IPC::BufferDescriptorABW b{};
+    b.size_bits_0_31 = BUFFER_SIZE;
+    b.address_bits_0_31 = static_cast<u32>(BUFFER_ADDRESS);
+    std::memcpy(&cmd_buf[2], &b, sizeof(b));
+
+    // The data payload is aligned to 4 words.
+    cmd_buf[8] = Common::MakeMagic('S', 'F', 'C', 'I');
+    cmd_buf[10] = 0; // Read
+    cmd_buf[14] = static_cast<u32>(offset);
+    cmd_buf[15] = static_cast<u32>(offset >> 32);
+    cmd_buf[16] = static_cast<u32>(length);
+    cmd_buf[17] = static_cast<u32>(length >> 32);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("IFile: Async reads only access guest memory from the emulated core", "[core]") {
+    auto& system = Core::System::GetInstance();
+    Kernel::KernelCore kernel{system};
+
+    std::vector<u8> guest_memory(Memory::PAGE_SIZE, BUFFER_FILL);
+    auto process = Kernel::Process::Create(system, "", Kernel::Process::ProcessType::Userland);
+    auto& page_table = process->VMManager().page_table;
+    system.Memory().MapMemoryRegion(page_table, BUFFER_ADDRESS, guest_memory.size(),
+                                    guest_memory.data());
+
+    std::vector<u8> data(0x1000);
+    std::iota(data.begin(), data.end(), u8{0});
+    const auto file = Service::FileSystem::CreateFileInterface(
+        std::make_shared<FileSys::VectorVfsFile>(data, "file"));
+    auto session = Kernel::ServerSession::Create(kernel, nullptr, "IFile").Unwrap();
+
+    std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
+    WriteReadRequest(cmd_buf, 0x10, 0x80);
+    auto context = std::make_shared<Kernel::HLERequestContext>(session, nullptr);
+    context->PopulateFromIncomingCommandBuffer(Kernel::HandleTable{}, cmd_buf.data());
+    REQUIRE(file->CanHandleAsync(*context));
+
+    // This is the split ServerSession uses: buffers are copied on the emulated core, the service
+    // thread only sees the copies.
+    context->DetachBuffers(*process);
+    {
+        Kernel::ServiceThreadPool pool{kernel, 1};
+        pool.QueueWork([&file, &context] { file->HandleAsyncRequest(*context); });
+    }
+    REQUIRE(std::all_of(guest_memory.begin(), guest_memory.end(),
+                        [](u8 value) { return value == BUFFER_FILL; }));
+
+    // Header, padding and payload header come before the result and the number of bytes read.
+    const u32* const response = context->CommandBuffer();
+    REQUIRE(ResultCode{response[6]} == RESULT_SUCCESS);
+    REQUIRE((response[8] | (u64{response[9]} << 32)) == 0x80);
+
+    // Parts of the buffer the read did not cover keep their contents.
+    context->WriteBackBuffers(*process);
+    REQUIRE(std::equal(guest_memory.begin(), guest_memory.begin() + 0x80, data.begin() + 0x10));
+    REQUIRE(std::all_of(guest_memory.begin() + 0x80, guest_memory.end(),
+                        [](u8 value) { return value == BUFFER_FILL; }));
+
+    system.Memory().UnmapRegion(page_table, BUFFER_ADDRESS, guest_memory.size());
+}
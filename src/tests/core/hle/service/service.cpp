@@ -0,0 +1,119 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <numeric>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/hle/ipc.h"
+#include "core/hle/kernel/handle_table.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/server_session.h"
+#include "core/hle/service/command_stats.h"
+#include "core/hle/service/service.h"
+#include "core/settings.h"
+
+namespace {
+
+class TestService final : public Service::ServiceFramework<TestService> {
+public:
+    TestService() : ServiceFramework{"test:svc"} {
+        // clang-format off
+        static const FunctionInfo functions[] = {
+            {0, &TestService::Record<0>, "Zero"},
+            {5, &TestService::Record<5>, "Five"},
+            {0x3FF, &TestService::Record<0x3FF>, "LastDense"},
+            {10100, &TestService::Record<10100>, "Sparse"},
+        };
+        // clang-format on
+        RegisterHandlers(functions);
+    }
+
+    u32 last_command = 0xFFFFFFFF;
+
+private:
+    template <u32 command>
+    void Record(Kernel::HLERequestContext& ctx) {
+        last_command = command;
+    }
+};
+
+/// Builds a context for a request without buffers nor parameters.
+std::shared_ptr<Kernel::HLERequestContext> MakeRequest(
+    const std::shared_ptr<Kernel::ServerSession>& session, u32 command) {
+    std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf{};
+
+    IPC::CommandHeader header{};
+    header.type.Assign(IPC::CommandType::Request);
+    // Padding, payload header and command id.
+    header.data_size.Assign(4 + 2 + 2);
+    std::memcpy(&cmd_buf[0], &header, sizeof(header));
+    cmd_buf[4] = Common::MakeMagic('S', 'F', 'C', 'I');
+    cmd_buf[6] = command;
+
+    auto context = std::make_shared<Kernel::HLERequestContext>(session, nullptr);
+    context->PopulateFromIncomingCommandBuffer(Kernel::HandleTable{}, cmd_buf.data());
+    return context;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ServiceFramework: Commands are dispatched by id", "[core]") {
+    Kernel::KernelCore kernel{Core::System::GetInstance()};
+    auto session = Kernel::ServerSession::Create(kernel, nullptr, "test:svc").Unwrap();
+    TestService service;
+
+    for (const u32 command : {0U, 5U, 0x3FFU, 10100U}) {
+        service.InvokeRequest(*MakeRequest(session, command));
+        REQUIRE(service.last_command == command);
+    }
+}
+
+TEST_CASE("ServiceFramework: Command statistics are recorded", "[core]") {
+    const bool record_service_stats = Settings::values.record_service_stats;
+    Settings::values.record_service_stats = true;
+
+    auto& command_stats = Core::System::GetInstance().GetServiceCommandStats();
+    command_stats.Reset();
+
+    Kernel::KernelCore kernel{Core::System::GetInstance()};
+    auto session = Kernel::ServerSession::Create(kernel, nullptr, "test:svc").Unwrap();
+    TestService first;
+    TestService second;
+
+    // Instances of a service share their statistics.
+    first.InvokeRequest(*MakeRequest(session, 5));
+    second.InvokeRequest(*MakeRequest(session, 5));
+    first.InvokeRequest(*MakeRequest(session, 10100));
+
+    const auto snapshots = command_stats.Snapshot();
+    u64 five_calls = 0;
+    u64 sparse_calls = 0;
+    for (const auto& snapshot : snapshots) {
+        if (snapshot.service_name != "test:svc") {
+            continue;
+        }
+        REQUIRE(std::accumulate(snapshot.latency.buckets.begin(), snapshot.latency.buckets.end(),
+                                u64{0}) == snapshot.latency.calls);
+        if (snapshot.command_id == 5) {
+            REQUIRE(snapshot.command_name == "Five");
+            five_calls = snapshot.latency.calls;
+        } else if (snapshot.command_id == 10100) {
+            REQUIRE(snapshot.command_name == "Sparse");
+            sparse_calls = snapshot.latency.calls;
+        }
+    }
+    REQUIRE(five_calls == 2);
+    REQUIRE(sparse_calls == 1);
+
+    command_stats.Reset();
+    Settings::values.record_service_stats = record_service_stats;
+}
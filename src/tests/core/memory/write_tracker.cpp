@@ -0,0 +1,85 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/host_memory.h"
+#include "core/memory/write_tracker.h"
+
+namespace Memory {
+
+namespace {
+
+using Runs = std::vector<std::pair<u8*, std::size_t>>;
+
+Runs ConsumeRuns(WriteTracker& tracker) {
+    Runs runs;
+    tracker.ConsumeDirtyPages(
+        [&runs](u8* host_pointer, std::size_t size) { runs.emplace_back(host_pointer, size); });
+    return runs;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("WriteTracker: Writes to tracked pages are caught", "[core]") {
+    if (!WriteTracker::IsSupported()) {
+        return;
+    }
+    constexpr std::size_t size = 4 * PAGE_SIZE;
+    auto* const memory = static_cast<u8*>(Common::AllocateHostMemory(size));
+    WriteTracker tracker;
+
+    REQUIRE(tracker.Track(0x1000, memory));
+    REQUIRE(tracker.Track(0x2000, memory + PAGE_SIZE));
+    // Guest pages may alias host memory.
+    REQUIRE(tracker.Track(0x8000, memory + PAGE_SIZE));
+    REQUIRE(tracker.IsTracked(memory, 2 * PAGE_SIZE));
+    REQUIRE(!tracker.IsTracked(memory, 2 * PAGE_SIZE + 1));
+
+    memory[0x10] = 1;
+    memory[PAGE_SIZE + 0x10] = 2;
+    memory[3 * PAGE_SIZE] = 3;
+    REQUIRE(ConsumeRuns(tracker) == Runs{{memory, 2 * PAGE_SIZE}});
+    REQUIRE(ConsumeRuns(tracker).empty());
+
+    // Consumed pages are protected again.
+    memory[PAGE_SIZE] = 4;
+    REQUIRE(ConsumeRuns(tracker) == Runs{{memory + PAGE_SIZE, PAGE_SIZE}});
+
+    // The host page stays tracked until every guest page aliasing it is untracked.
+    REQUIRE(tracker.Untrack(0x2000) == memory + PAGE_SIZE);
+    REQUIRE(tracker.IsTracked(memory + PAGE_SIZE, PAGE_SIZE));
+    REQUIRE(tracker.Untrack(0x8000) == memory + PAGE_SIZE);
+    REQUIRE(!tracker.IsTracked(memory + PAGE_SIZE, PAGE_SIZE));
+    REQUIRE(tracker.Untrack(0x8000) == nullptr);
+
+    memory[PAGE_SIZE] = 5;
+    REQUIRE(ConsumeRuns(tracker).empty());
+
+    // Ranges are untracked at once, skipping the pages that are not tracked.
+    REQUIRE(tracker.Track(0x3000, memory + 3 * PAGE_SIZE));
+    REQUIRE(tracker.Track(0x4000, memory + 2 * PAGE_SIZE));
+    const std::vector<std::pair<VAddr, u8*>> untracked{{0x1000, memory},
+                                                       {0x3000, memory + 3 * PAGE_SIZE}};
+    REQUIRE(tracker.UntrackRange(0x1000, 0x3000) == untracked);
+    REQUIRE(tracker.UntrackRange(0x1000, 0x3000).empty());
+    REQUIRE(tracker.IsTracked(memory + 2 * PAGE_SIZE, PAGE_SIZE));
+    REQUIRE(!tracker.IsTracked(memory, PAGE_SIZE));
+    memory[0x20] = 6;
+    memory[3 * PAGE_SIZE + 0x20] = 7;
+    REQUIRE(ConsumeRuns(tracker).empty());
+
+    tracker.Clear();
+    memory[0] = 8;
+    REQUIRE(ConsumeRuns(tracker).empty());
+    REQUIRE(memory[0x10] == 1);
+
+    Common::FreeHostMemory(memory, size);
+}
+
+} // namespace Memory
@@ -0,0 +1,74 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/dma_pusher.h"
+
+namespace Tegra {
+
+namespace {
+
+CommandListHeader MakeHeader(u64 raw) {
+    CommandListHeader header{};
+    header.raw = raw;
+    return header;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CommandListPool: Released lists are reused", "[video_core]") {
+    CommandListPool pool;
+    const std::array<CommandListHeader, 3> entries{MakeHeader(1), MakeHeader(2), MakeHeader(3)};
+
+    CommandList list = pool.Acquire(entries.data(), entries.size());
+    REQUIRE(list.size() == entries.size());
+    REQUIRE(list[0].raw == 1);
+    REQUIRE(list[2].raw == 3);
+
+    const CommandListHeader* const storage = list.data();
+    pool.Release(std::move(list));
+
+    // The storage of the released list is handed out again, holding only the new entries.
+    CommandList reused = pool.Acquire(entries.data() + 1, 2);
+    REQUIRE(reused.data() == storage);
+    REQUIRE(reused.size() == 2);
+    REQUIRE(reused[0].raw == 2);
+    REQUIRE(reused[1].raw == 3);
+
+    pool.Release(std::move(reused));
+    const CommandList zeroed = pool.Acquire(2);
+    REQUIRE(zeroed.data() == storage);
+    REQUIRE(zeroed[0].raw == 0);
+    REQUIRE(zeroed[1].raw == 0);
+}
+
+TEST_CASE("CommandListPool: At most MAX_FREE_LISTS lists are kept", "[video_core]") {
+    constexpr std::size_t num_lists = CommandListPool::MAX_FREE_LISTS + 1;
+    CommandListPool pool;
+    const std::array<CommandListHeader, 4> entries{};
+
+    std::vector<CommandList> lists;
+    for (std::size_t i = 0; i < num_lists; ++i) {
+        lists.push_back(pool.Acquire(entries.data(), entries.size()));
+    }
+    for (CommandList& list : lists) {
+        pool.Release(std::move(list));
+    }
+
+    // Fresh lists have no storage, reused ones keep theirs.
+    std::size_t reused = 0;
+    for (std::size_t i = 0; i < num_lists; ++i) {
+        if (pool.Acquire(entries.data(), 0).capacity() != 0) {
+            ++reused;
+        }
+    }
+    REQUIRE(reused == CommandListPool::MAX_FREE_LISTS);
+}
+
+} // namespace Tegra
@@ -12,6 +12,42 @@
 
 namespace Tegra {
 
+CommandListPool::CommandListPool() {
+    free_lists.reserve(MAX_FREE_LISTS);
+}
+
+CommandListPool::~CommandListPool() = default;
+
+CommandList CommandListPool::Acquire(const CommandListHeader* entries, std::size_t count) {
+    CommandList list = TakeFreeList();
+    list.assign(entries, entries + count);
+    return list;
+}
+
+CommandList CommandListPool::Acquire(std::size_t size) {
+    CommandList list = TakeFreeList();
+    list.resize(size);
+    return list;
+}
+
+void CommandListPool::Release(CommandList&& list) {
+    list.clear();
+    std::lock_guard lock{mutex};
+    if (free_lists.size() < MAX_FREE_LISTS) {
+        free_lists.push_back(std::move(list));
+    }
+}
+
+CommandList CommandListPool::TakeFreeList() {
+    std::lock_guard lock{mutex};
+    if (free_lists.empty()) {
+        return {};
+    }
+    CommandList list = std::move(free_lists.back());
+    free_lists.pop_back();
+    return list;
+}
+
 DmaPusher::DmaPusher(GPU& gpu) : gpu(gpu) {}
 
 DmaPusher::~DmaPusher() = default;
@@ -44,8 +80,7 @@ bool DmaPusher::Step() {
     ASSERT_OR_EXECUTE(!command_list.empty(), {
         // Somehow the command_list is empty, in order to avoid a crash
         // We ignore it and assume its size is 0.
-        dma_pushbuffer.pop();
-        dma_pushbuffer_subindex = 0;
+        PopCommandList();
         return true;
     });
     const CommandListHeader command_list_header{command_list[dma_pushbuffer_subindex++]};
@@ -55,8 +90,7 @@ bool DmaPusher::Step() {
 
     if (dma_pushbuffer_subindex >= command_list.size()) {
         // We've gone through the current list, remove it from the queue
-        dma_pushbuffer.pop();
-        dma_pushbuffer_subindex = 0;
+        PopCommandList();
     }
 
     if (command_list_header.size == 0) {
@@ -127,6 +161,12 @@ bool DmaPusher::Step() {
     return true;
 }
 
+void DmaPusher::PopCommandList() {
+    gpu.CommandLists().Release(std::move(dma_pushbuffer.front()));
+    dma_pushbuffer.pop();
+    dma_pushbuffer_subindex = 0;
+}
+
 void DmaPusher::SetState(const CommandHeader& command_header) {
     dma_state.method = command_header.method;
     dma_state.subchannel = command_header.subchannel;
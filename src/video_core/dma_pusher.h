@@ -4,8 +4,9 @@
 
 #pragma once
 
-#include <vector>
+#include <mutex>
 #include <queue>
+#include <vector>
 
 #include "common/bit_field.h"
 #include "common/common_types.h"
@@ -47,6 +48,41 @@ class GPU;
 
 using CommandList = std::vector<Tegra::CommandListHeader>;
 
+/**
+ * Recycles the storage of command lists. Submitters fill lists acquired from the pool and the
+ * DmaPusher releases them once it went through them, so steady submission does not allocate.
+ */
+class CommandListPool {
+public:
+    CommandListPool();
+    ~CommandListPool();
+
+    /// Maximum number of released lists kept for reuse, further ones are freed.
+    static constexpr std::size_t MAX_FREE_LISTS = 64;
+
+    /**
+     * Returns a list holding a copy of the given entries, reusing the storage of a released list
+     * if there is one.
+     */
+    CommandList Acquire(const CommandListHeader* entries, std::size_t count);
+
+    /**
+     * Returns a zero-filled list of the given size, for callers filling it in place. Prefer the
+     * copying overload, which does not have to clear the list first.
+     */
+    CommandList Acquire(std::size_t size);
+
+    /// Hands a list back for reuse.
+    void Release(CommandList&& list);
+
+private:
+    /// Takes the storage of a released list, or returns an empty list if there is none.
+    CommandList TakeFreeList();
+
+    std::mutex mutex;
+    std::vector<CommandList> free_lists;
+};
+
 /**
  * The DmaPusher class implements DMA submission to FIFOs, providing an area of memory that the
  * emulated app fills with commands and tells PFIFO to process. The pushbuffers are then assembled
@@ -68,6 +104,9 @@ public:
 private:
     bool Step();
 
+    /// Removes the front command list of the queue, handing its storage back to the pool.
+    void PopCommandList();
+
     void SetState(const CommandHeader& command_header);
 
     void CallMethod(u32 argument) const;
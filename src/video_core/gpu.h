@@ -173,6 +173,11 @@ public:
     /// Returns a reference to the GPU DMA pusher.
     Tegra::DmaPusher& DmaPusher();
 
+    /// Returns the pool recycling the command lists passed to PushGPUEntries.
+    Tegra::CommandListPool& CommandLists() {
+        return command_list_pool;
+    }
+
     // Waits for the GPU to finish working
     virtual void WaitIdle() const = 0;
 
@@ -291,6 +296,8 @@ protected:
 private:
     std::unique_ptr<Tegra::MemoryManager> memory_manager;
 
+    Tegra::CommandListPool command_list_pool;
+
     /// Mapping of command subchannels to their bound engine ids
     std::array<EngineID, 8> bound_engines = {};
     /// 3D engine
@@ -17,9 +17,6 @@ namespace Tegra {
 
 MemoryManager::MemoryManager(Core::System& system, VideoCore::RasterizerInterface& rasterizer)
     : rasterizer{rasterizer}, system{system} {
-    std::fill(page_table.pointers.begin(), page_table.pointers.end(), nullptr);
-    std::fill(page_table.attributes.begin(), page_table.attributes.end(),
-              Common::PageType::Unmapped);
     page_table.Resize(address_space_width);
 
     // Initialize the map with a single free region covering the entire managed space.
@@ -234,6 +231,9 @@ bool MemoryManager::IsBlockContinuous(const GPUVAddr start, const std::size_t si
 }
 
 void MemoryManager::ReadBlock(GPUVAddr src_addr, void* dest_buffer, const std::size_t size) const {
+    // CPU writes must be visible to the flushes below.
+    rasterizer.InvalidateDirtyPages();
+
     std::size_t remaining_size{size};
     std::size_t page_index{src_addr >> page_bits};
     std::size_t page_offset{src_addr & page_mask};
@@ -336,6 +336,9 @@ void MemoryManager::WriteBlockUnsafe(GPUVAddr dest_addr, const void* src_buffer,
 }
 
 void MemoryManager::CopyBlock(GPUVAddr dest_addr, GPUVAddr src_addr, const std::size_t size) {
+    // CPU writes must be visible to the flushes below.
+    rasterizer.InvalidateDirtyPages();
+
     std::size_t remaining_size{size};
     std::size_t page_index{src_addr >> page_bits};
     std::size_t page_offset{src_addr & page_mask};
@@ -380,6 +383,11 @@ void MemoryManager::MapPages(GPUVAddr base, u64 size, u8* memory, Common::PageTy
     ASSERT_MSG(end <= page_table.pointers.size(), "out of range mapping at {:016X}",
                base + page_table.pointers.size());
 
+    if (type == Common::PageType::Unmapped && backing_addr == 0) {
+        page_table.ClearPages(base, size);
+        return;
+    }
+
     std::fill(page_table.attributes.begin() + base, page_table.attributes.begin() + end, type);
 
     if (memory == nullptr) {
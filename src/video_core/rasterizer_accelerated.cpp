@@ -10,6 +10,7 @@
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "core/memory.h"
+#include "video_core/gpu.h"
 #include "video_core/rasterizer_accelerated.h"
 
 namespace VideoCore {
@@ -62,4 +63,10 @@ void RasterizerAccelerated::UpdatePagesCachedCount(VAddr addr, u64 size, int del
     }
 }
 
+void RasterizerAccelerated::InvalidateDirtyPages() {
+    cpu_memory.ConsumeRasterizerDirtyPages([this](u8* host_ptr, std::size_t size) {
+        InvalidateRegion(ToCacheAddr(host_ptr), size);
+    });
+}
+
 } // namespace VideoCore
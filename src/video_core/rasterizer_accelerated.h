@@ -25,6 +25,8 @@ public:
 
     void UpdatePagesCachedCount(VAddr addr, u64 size, int delta) override;
 
+    void InvalidateDirtyPages() override;
+
 private:
     using CachedPageMap = boost::icl::interval_map<u64, int>;
     CachedPageMap cached_pages;
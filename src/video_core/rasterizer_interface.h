@@ -85,6 +85,10 @@ public:
     /// Increase/decrease the number of object in pages touching the specified region
     virtual void UpdatePagesCachedCount(VAddr addr, u64 size, int delta) {}
 
+    /// Notify rasterizer that cached memory written by the CPU and not yet reported through
+    /// InvalidateRegion should be invalidated. Called before guest memory is read by the GPU.
+    virtual void InvalidateDirtyPages() {}
+
     /// Initialize disk cached resources for the game being emulated
     virtual void LoadDiskResources(const std::atomic_bool& stop_loading = false,
                                    const DiskResourceLoadCallback& callback = {}) {}
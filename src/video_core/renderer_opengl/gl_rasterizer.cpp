@@ -446,6 +446,8 @@ void RasterizerOpenGL::Clear() {
         return;
     }
 
+    InvalidateDirtyPages();
+
     const auto& regs = maxwell3d.regs;
     bool use_color{};
     bool use_depth{};
@@ -548,6 +550,7 @@ void RasterizerOpenGL::Clear() {
 
 void RasterizerOpenGL::Draw(bool is_indexed, bool is_instanced) {
     MICROPROFILE_SCOPE(OpenGL_Drawing);
+    InvalidateDirtyPages();
     auto& gpu = system.GPU().Maxwell3D();
     const auto& regs = gpu.regs;
 
@@ -690,6 +693,8 @@ void RasterizerOpenGL::DispatchCompute(GPUVAddr code_addr) {
         return;
     }
 
+    InvalidateDirtyPages();
+
     buffer_cache.Acquire();
 
     auto kernel = shader_cache.GetComputeKernel(code_addr);
@@ -787,6 +792,7 @@ bool RasterizerOpenGL::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Regs
                                              const Tegra::Engines::Fermi2D::Regs::Surface& dst,
                                              const Tegra::Engines::Fermi2D::Config& copy_config) {
     MICROPROFILE_SCOPE(OpenGL_Blits);
+    InvalidateDirtyPages();
     texture_cache.DoFermiCopy(src, dst, copy_config);
     return true;
 }
@@ -798,6 +804,7 @@ bool RasterizerOpenGL::AccelerateDisplay(const Tegra::FramebufferConfig& config,
     }
 
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
+    InvalidateDirtyPages();
 
     const auto surface{
         texture_cache.TryFindFramebufferSurface(system.Memory().GetPointer(framebuffer_addr))};
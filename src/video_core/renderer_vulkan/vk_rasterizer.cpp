@@ -300,6 +300,7 @@ RasterizerVulkan::~RasterizerVulkan() = default;
 
 void RasterizerVulkan::Draw(bool is_indexed, bool is_instanced) {
     MICROPROFILE_SCOPE(Vulkan_Drawing);
+    InvalidateDirtyPages();
 
     FlushWork();
 
@@ -366,6 +367,8 @@ void RasterizerVulkan::Clear() {
         return;
     }
 
+    InvalidateDirtyPages();
+
     const auto& regs = gpu.regs;
     const bool use_color = regs.clear_buffers.R || regs.clear_buffers.G || regs.clear_buffers.B ||
                            regs.clear_buffers.A;
@@ -424,6 +427,7 @@ void RasterizerVulkan::Clear() {
 
 void RasterizerVulkan::DispatchCompute(GPUVAddr code_addr) {
     MICROPROFILE_SCOPE(Vulkan_Compute);
+    InvalidateDirtyPages();
     update_descriptor_queue.Acquire();
     sampled_views.clear();
     image_views.clear();
@@ -518,6 +522,7 @@ void RasterizerVulkan::TickFrame() {
 bool RasterizerVulkan::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Regs::Surface& src,
                                              const Tegra::Engines::Fermi2D::Regs::Surface& dst,
                                              const Tegra::Engines::Fermi2D::Config& copy_config) {
+    InvalidateDirtyPages();
     texture_cache.DoFermiCopy(src, dst, copy_config);
     return true;
 }
@@ -528,6 +533,8 @@ bool RasterizerVulkan::AccelerateDisplay(const Tegra::FramebufferConfig& config,
         return false;
     }
 
+    InvalidateDirtyPages();
+
     const u8* host_ptr{system.Memory().GetPointer(framebuffer_addr)};
     const auto surface{texture_cache.TryFindFramebufferSurface(host_ptr)};
     if (!surface) {
@@ -448,6 +448,11 @@ void Config::ReadCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     Settings::values.use_multi_core = ReadSetting(QStringLiteral("use_multi_core"), false).toBool();
+    Settings::values.use_async_services =
+        ReadSetting(QStringLiteral("use_async_services"), false).toBool();
+    Settings::values.use_huge_pages = ReadSetting(QStringLiteral("use_huge_pages"), false).toBool();
+    Settings::values.use_host_timing =
+        ReadSetting(QStringLiteral("use_host_timing"), false).toBool();
 
     qt_config->endGroup();
 }
@@ -531,6 +536,10 @@ void Config::ReadDebuggingValues() {
     Settings::values.dump_nso = ReadSetting(QStringLiteral("dump_nso"), false).toBool();
     Settings::values.reporting_services =
         ReadSetting(QStringLiteral("reporting_services"), false).toBool();
+    Settings::values.record_service_stats =
+        ReadSetting(QStringLiteral("record_service_stats"), false).toBool();
+    Settings::values.record_svc_stats =
+        ReadSetting(QStringLiteral("record_svc_stats"), false).toBool();
     Settings::values.quest_flag = ReadSetting(QStringLiteral("quest_flag"), false).toBool();
 
     qt_config->endGroup();
@@ -639,6 +648,8 @@ void Config::ReadRendererValues() {
         ReadSetting(QStringLiteral("use_disk_shader_cache"), true).toBool();
     Settings::values.use_accurate_gpu_emulation =
         ReadSetting(QStringLiteral("use_accurate_gpu_emulation"), false).toBool();
+    Settings::values.use_write_tracking =
+        ReadSetting(QStringLiteral("use_write_tracking"), false).toBool();
     Settings::values.use_asynchronous_gpu_emulation =
         ReadSetting(QStringLiteral("use_asynchronous_gpu_emulation"), false).toBool();
     Settings::values.use_vsync = ReadSetting(QStringLiteral("use_vsync"), true).toBool();
@@ -942,6 +953,9 @@ void Config::SaveCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     WriteSetting(QStringLiteral("use_multi_core"), Settings::values.use_multi_core, false);
+    WriteSetting(QStringLiteral("use_async_services"), Settings::values.use_async_services, false);
+    WriteSetting(QStringLiteral("use_huge_pages"), Settings::values.use_huge_pages, false);
+    WriteSetting(QStringLiteral("use_host_timing"), Settings::values.use_host_timing, false);
 
     qt_config->endGroup();
 }
@@ -996,6 +1010,9 @@ void Config::SaveDebuggingValues() {
                  QString::fromStdString(Settings::values.program_args), QStringLiteral(""));
     WriteSetting(QStringLiteral("dump_exefs"), Settings::values.dump_exefs, false);
     WriteSetting(QStringLiteral("dump_nso"), Settings::values.dump_nso, false);
+    WriteSetting(QStringLiteral("record_service_stats"), Settings::values.record_service_stats,
+                 false);
+    WriteSetting(QStringLiteral("record_svc_stats"), Settings::values.record_svc_stats, false);
     WriteSetting(QStringLiteral("quest_flag"), Settings::values.quest_flag, false);
 
     qt_config->endGroup();
@@ -1075,6 +1092,7 @@ void Config::SaveRendererValues() {
                  true);
     WriteSetting(QStringLiteral("use_accurate_gpu_emulation"),
                  Settings::values.use_accurate_gpu_emulation, false);
+    WriteSetting(QStringLiteral("use_write_tracking"), Settings::values.use_write_tracking, false);
     WriteSetting(QStringLiteral("use_asynchronous_gpu_emulation"),
                  Settings::values.use_asynchronous_gpu_emulation, false);
     WriteSetting(QStringLiteral("use_vsync"), Settings::values.use_vsync, true);
@@ -369,6 +369,10 @@ void Config::ReadValues() {
 
     // Core
     Settings::values.use_multi_core = sdl2_config->GetBoolean("Core", "use_multi_core", false);
+    Settings::values.use_async_services =
+        sdl2_config->GetBoolean("Core", "use_async_services", false);
+    Settings::values.use_huge_pages = sdl2_config->GetBoolean("Core", "use_huge_pages", false);
+    Settings::values.use_host_timing = sdl2_config->GetBoolean("Core", "use_host_timing", false);
 
     // Renderer
     const int renderer_backend = sdl2_config->GetInteger(
@@ -390,6 +394,8 @@ void Config::ReadValues() {
         sdl2_config->GetBoolean("Renderer", "use_disk_shader_cache", false);
     Settings::values.use_accurate_gpu_emulation =
         sdl2_config->GetBoolean("Renderer", "use_accurate_gpu_emulation", false);
+    Settings::values.use_write_tracking =
+        sdl2_config->GetBoolean("Renderer", "use_write_tracking", false);
     Settings::values.use_asynchronous_gpu_emulation =
         sdl2_config->GetBoolean("Renderer", "use_asynchronous_gpu_emulation", false);
     Settings::values.use_vsync =
@@ -424,6 +430,10 @@ void Config::ReadValues() {
     Settings::values.dump_nso = sdl2_config->GetBoolean("Debugging", "dump_nso", false);
     Settings::values.reporting_services =
         sdl2_config->GetBoolean("Debugging", "reporting_services", false);
+    Settings::values.record_service_stats =
+        sdl2_config->GetBoolean("Debugging", "record_service_stats", false);
+    Settings::values.record_svc_stats =
+        sdl2_config->GetBoolean("Debugging", "record_svc_stats", false);
     Settings::values.quest_flag = sdl2_config->GetBoolean("Debugging", "quest_flag", false);
 
     const auto title_list = sdl2_config->Get("AddOns", "title_ids", "");
@@ -94,9 +94,23 @@ udp_pad_index=
 
 [Core]
 # Whether to use multi-core for CPU emulation
+# Runs each emulated core on its own host thread, which makes emulation non-deterministic
 # 0 (default): Disabled, 1: Enabled
 use_multi_core=
 
+# Whether to run slow HLE service requests, such as file reads, on host worker threads
+# Only takes effect along with use_multi_core
+# 0 (default): Disabled, 1: Enabled
+use_async_services=
+
+# Whether to back large guest memory allocations with host huge pages
+# 0 (default): Disabled, 1: Enabled
+use_huge_pages=
+
+# Whether emulated time follows the host clock instead of the count of executed instructions
+# 0 (default): Disabled, 1: Enabled
+use_host_timing=
+
 [Renderer]
 # Which backend API to use.
 # 0 (default): OpenGL, 1: Vulkan
@@ -150,6 +164,11 @@ use_disk_shader_cache =
 # 0 (default): Off (fast), 1 : On (slow)
 use_accurate_gpu_emulation =
 
+# Whether to track CPU writes to GPU cached memory through page protection. Ignored when
+# accurate GPU emulation is enabled.
+# 0 (default): Off, 1 : On
+use_write_tracking =
+
 # Whether to use asynchronous GPU emulation
 # 0 : Off (slow), 1 (default): On (fast)
 use_asynchronous_gpu_emulation =
@@ -277,6 +296,12 @@ gdbstub_port=24689
 dump_exefs=false
 # Determines whether or not yuzu will dump all NSOs it attempts to load while loading them
 dump_nso=false
+# Record call counts and latencies of HLE service commands, logged when emulation stops
+# 0 (default): Disabled, 1: Enabled
+record_service_stats =
+# Record call counts and latencies of SVCs, logged when emulation stops
+# 0 (default): Disabled, 1: Enabled
+record_svc_stats =
 # Determines whether or not yuzu will report to the game that the emulated console is in Kiosk Mode
 # false: Retail/Normal Mode (default), true: Kiosk Mode
 quest_flag =
@@ -24,6 +24,8 @@
 #include "core/crypto/key_manager.h"
 #include "core/file_sys/vfs_real.h"
 #include "core/gdbstub/gdbstub.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/svc_stats.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/loader.h"
 #include "core/settings.h"
@@ -67,7 +69,8 @@ static void PrintHelp(const char* argv0) {
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-h, --help            Display this help and exit\n"
                  "-v, --version         Output version information and exit\n"
-                 "-p, --program         Pass following string as arguments to executable\n";
+                 "-p, --program         Pass following string as arguments to executable\n"
+                 "-s, --svc-stats=FILE  Record SVC statistics and write them to FILE as JSON\n";
 }
 
 static void PrintVersion() {
@@ -113,15 +116,17 @@ int main(int argc, char** argv) {
     std::string filepath;
 
     bool fullscreen = false;
+    std::string svc_stats_path;
 
     static struct option long_options[] = {
         {"gdbport", required_argument, 0, 'g'}, {"fullscreen", no_argument, 0, 'f'},
         {"help", no_argument, 0, 'h'},          {"version", no_argument, 0, 'v'},
-        {"program", optional_argument, 0, 'p'}, {0, 0, 0, 0},
+        {"program", optional_argument, 0, 'p'}, {"svc-stats", required_argument, 0, 's'},
+        {0, 0, 0, 0},
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:fhvp::s:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'g':
@@ -149,6 +154,10 @@ int main(int argc, char** argv) {
                 Settings::values.program_args = argv[optind];
                 ++optind;
                 break;
+            case 's':
+                svc_stats_path = optarg;
+                Settings::values.record_svc_stats = true;
+                break;
             }
         } else {
 #ifdef _WIN32
@@ -248,6 +257,13 @@ int main(int argc, char** argv) {
     }
     render_thread.join();
 
+    if (!svc_stats_path.empty()) {
+        const std::string svc_stats = system.Kernel().SVCStats().ToJson();
+        if (FileUtil::WriteStringToFile(true, svc_stats_path, svc_stats) != svc_stats.size()) {
+            LOG_ERROR(Frontend, "Failed to write SVC statistics to {}", svc_stats_path);
+        }
+    }
+
     system.Shutdown();
 
     detached_tasks.WaitForAllTasks();
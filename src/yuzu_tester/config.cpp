@@ -114,6 +114,10 @@ void Config::ReadValues() {
 
     // Core
     Settings::values.use_multi_core = sdl2_config->GetBoolean("Core", "use_multi_core", false);
+    Settings::values.use_async_services =
+        sdl2_config->GetBoolean("Core", "use_async_services", false);
+    Settings::values.use_huge_pages = sdl2_config->GetBoolean("Core", "use_huge_pages", false);
+    Settings::values.use_host_timing = sdl2_config->GetBoolean("Core", "use_host_timing", false);
 
     // Renderer
     Settings::values.resolution_factor =
@@ -128,6 +132,8 @@ void Config::ReadValues() {
         sdl2_config->GetBoolean("Renderer", "use_disk_shader_cache", false);
     Settings::values.use_accurate_gpu_emulation =
         sdl2_config->GetBoolean("Renderer", "use_accurate_gpu_emulation", false);
+    Settings::values.use_write_tracking =
+        sdl2_config->GetBoolean("Renderer", "use_write_tracking", false);
     Settings::values.use_asynchronous_gpu_emulation =
         sdl2_config->GetBoolean("Renderer", "use_asynchronous_gpu_emulation", false);
 
@@ -9,9 +9,22 @@ namespace DefaultINI {
 const char* sdl2_config_file = R"(
 [Core]
 # Whether to use multi-core for CPU emulation
+# Runs each emulated core on its own host thread, which makes emulation non-deterministic
 # 0 (default): Disabled, 1: Enabled
 use_multi_core=
 
+# Whether to run slow HLE service requests, such as file reads, on host worker threads
+# 0 (default): Disabled, 1: Enabled
+use_async_services=
+
+# Whether to back large guest memory allocations with host huge pages
+# 0 (default): Disabled, 1: Enabled
+use_huge_pages=
+
+# Whether emulated time follows the host clock instead of the count of executed instructions
+# 0 (default): Disabled, 1: Enabled
+use_host_timing=
+
 [Renderer]
 # Whether to use software or hardware rendering.
 # 0: Software, 1 (default): Hardware
@@ -46,6 +59,11 @@ use_disk_shader_cache =
 # 0 (default): Off (fast), 1 : On (slow)
 use_accurate_gpu_emulation =
 
+# Whether to track CPU writes to GPU cached memory through page protection. Ignored when
+# accurate GPU emulation is enabled.
+# 0 (default): Off, 1 : On
+use_write_tracking =
+
 # Whether to use asynchronous GPU emulation
 # 0 : Off (slow), 1 (default): On (fast)
 use_asynchronous_gpu_emulation =